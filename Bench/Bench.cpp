@@ -0,0 +1,93 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+TableGeometry MakeScaledTable(int numBalls, float ballRadius)
+{
+    float area = numBalls * 3.14159f * ballRadius * ballRadius * 8.0f;
+    float width = sqrtf(area / 2.0f);
+    if (width < 2.5f)
+        width = 2.5f;
+    return TableGeometry(width, width * 2.0f, 0.08f, 0.15f);
+}
+
+void ScatterBalls(BallStore& balls, const TableGeometry& table, int numBalls, float ballRadius,
+                  float maxSpeed, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(table.GetMinX() + ballRadius, table.GetMaxX() - ballRadius);
+    std::uniform_real_distribution<float> z(table.GetMinZ() + ballRadius, table.GetMaxZ() - ballRadius);
+    std::uniform_real_distribution<float> v(-maxSpeed, maxSpeed);
+
+    balls.Reserve(balls.Size() + numBalls);
+    for (int i = 0; i < numBalls; i++)
+    {
+        int k = balls.Add(i + 1, Vec3(x(rng), ballRadius, z(rng)), ballRadius);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+    }
+}
+
+void RackShot(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float angle = -0.6f + 0.006f * shot;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 2.0f + 0.03f * shot);
+}
+
+struct BenchEntry
+{
+    const char* Name;
+    int (*Run)();
+    const char* Description;
+};
+
+static const BenchEntry BENCHES[] =
+{
+    { "scaling", RunScalingBench, "Step cost from 16 to 50,000 balls" },
+    { "snapshot", RunSnapshotBench, "World snapshot save and restore cost" },
+    { "sweep", RunSweepBench, "Broadphase loops against Broadphase::Auto's choice" },
+    { "fixed", RunFixedPhysicsBench, "FixedPhysics<16> and <22> against dynamic Physics" },
+    { "precision", RunPrecisionBench, "FixedPhysics float, mixed and double precision cost and error" },
+    { "zones", RunZoneBench, "Pocket zone grid against the six-pocket loops" },
+    { "fused", RunStepModeBench, "StepMode::Fused against MultiPass per-ball passes" },
+    { "fastforward", RunFastForwardBench, "Breaks run to rest with and without fast-forward" },
+    { "stats", RunStatsBench, "Step cost of PhysicsStats collection" },
+};
+
+int main(int argc, char** argv)
+{
+    int numBenches = (int)(sizeof(BENCHES) / sizeof(BENCHES[0]));
+    int failed = 0;
+
+    if (argc < 2)
+    {
+        for (int b = 0; b < numBenches; b++)
+        {
+            printf("== %s: %s\n", BENCHES[b].Name, BENCHES[b].Description);
+            failed += BENCHES[b].Run() != 0;
+            printf("\n");
+        }
+        return failed ? 1 : 0;
+    }
+
+    for (int a = 1; a < argc; a++)
+    {
+        int b = 0;
+        while (b < numBenches && strcmp(argv[a], BENCHES[b].Name) != 0)
+            b++;
+        if (b == numBenches)
+        {
+            printf("Unknown benchmark '%s'; available:\n", argv[a]);
+            for (b = 0; b < numBenches; b++)
+                printf("  %-12s %s\n", BENCHES[b].Name, BENCHES[b].Description);
+            return 2;
+        }
+        printf("== %s: %s\n", BENCHES[b].Name, BENCHES[b].Description);
+        failed += BENCHES[b].Run() != 0;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Benchmarks
+ * ----------
+ * Performance measurements of the physics library, built with
+ * BILLIARD_BUILD_BENCH and run as `BilliardBench [name...]` (every
+ * benchmark when no name is given). Each one prints its own table and
+ * returns nonzero if a result check it makes fails.
+ *
+ * Times are the best of several repetitions, so run on an idle machine
+ * with an optimized build.
+ */
+
+/**
+ * Wall-clock seconds since a start time
+ */
+inline double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Fold a store's state hash into a running hash of several results (FNV-1a)
+ */
+inline uint64_t CombineHash(uint64_t hash, uint64_t value)
+{
+    return (hash ^ value) * 1099511628211ULL;
+}
+
+// Starting value for CombineHash
+const uint64_t HASH_SEED = 1469598103934665603ULL;
+
+/**
+ * Table sized for a ball count at a constant density (about eight ball
+ * areas of cloth per ball, never smaller than a standard table)
+ */
+TableGeometry MakeScaledTable(int numBalls, float ballRadius);
+
+/**
+ * Scatter balls over a table with random velocities (fixed seed)
+ * @param maxSpeed Velocity components are uniform in [-maxSpeed, maxSpeed]
+ */
+void ScatterBalls(BallStore& balls, const TableGeometry& table, int numBalls, float ballRadius,
+                  float maxSpeed, unsigned seed);
+
+/**
+ * Rack the standard 16 balls and break with shot i of a fixed fan of
+ * cue directions and speeds
+ */
+void RackShot(BallStore& balls, int shot);
+
+// Benchmarks (one per file)
+int RunScalingBench();
+int RunSnapshotBench();
+int RunSweepBench();
+int RunFixedPhysicsBench();
+int RunPrecisionBench();
+int RunZoneBench();
+int RunStepModeBench();
+int RunFastForwardBench();
+int RunStatsBench();
+
+#endif // BENCH_H
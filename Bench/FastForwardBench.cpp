@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static const int SHOTS = 200;
+static const int REPETITIONS = 5;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+/**
+ * Run SHOTS breaks to rest, keeping the final stores
+ * @return Milliseconds for all of them (best of REPETITIONS)
+ */
+static double RunBreaks(bool fastForward, std::vector<BallStore>& results, long long& steps, long long& skipped)
+{
+    TableGeometry table;
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        results.assign(SHOTS, BallStore());
+        steps = 0;
+        skipped = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int shot = 0; shot < SHOTS; shot++)
+        {
+            RackShot(results[shot], shot);
+            Physics physics;
+            physics.SetFastForward(fastForward);
+            steps += physics.RunToRest(results[shot], table, STEP_TIME, MAX_STEPS);
+            skipped += physics.GetTotalStats().SkippedSteps;
+        }
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e3;
+}
+
+int RunFastForwardBench()
+{
+    std::vector<BallStore> stepped, skipped;
+    long long steps, fastSteps, unused, skippedSteps;
+    double stepping = RunBreaks(false, stepped, steps, unused);
+    double fastForward = RunBreaks(true, skipped, fastSteps, skippedSteps);
+
+    double worst = 0.0;
+    int potDifferences = 0;
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        for (int i = 0; i < stepped[shot].Size(); i++)
+        {
+            if (stepped[shot].IsActive(i) != skipped[shot].IsActive(i))
+                potDifferences++;
+            else if (stepped[shot].IsActive(i))
+                worst = std::fmax(worst, std::hypot((double)stepped[shot].PosX[i] - skipped[shot].PosX[i],
+                                                    (double)stepped[shot].PosZ[i] - skipped[shot].PosZ[i]));
+        }
+    }
+
+    // SkippedSteps stays 0 in a BILLIARD_PHYSICS_STATS=OFF build
+    printf("%d breaks run to rest at %.0f Hz\n", SHOTS, 1.0f / STEP_TIME);
+    printf("stepping:     %7.2f ms, %lld steps\n", stepping, steps);
+    printf("fast-forward: %7.2f ms, %lld steps (%lld skipped), %.2fx\n", fastForward, fastSteps, skippedSteps,
+           stepping / fastForward);
+    printf("largest end-position difference %.3g m, %d pot differences\n", worst, potDifferences);
+    return steps == fastSteps && potDifferences == 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include "Bench.h"
+#include "FixedPhysics.h"
+#include <cstdio>
+
+static const int SHOTS = 200;
+static const int REPETITIONS = 5;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+/**
+ * A break with N balls: the standard rack, plus resting balls spread
+ * across the open table beyond the first 16
+ */
+static void RackBalls(BallStore& balls, int numBalls, int shot)
+{
+    RackShot(balls, shot);
+    for (int k = 16; k < numBalls; k++)
+        balls.Add(k, Vec3(-0.4f + 0.16f * (k - 16), 0.0f, 0.6f + 0.05f * (k % 2)), 0.057f);
+}
+
+/**
+ * The dynamic step as FixedPhysics specialises it (no swept collisions)
+ */
+struct DynamicPhysics : Physics
+{
+    DynamicPhysics() { SetContinuousCollision(false); }
+};
+
+/**
+ * Nanoseconds per step over SHOTS breaks run to rest (best of REPETITIONS)
+ */
+template <class P>
+static double TimeBreaks(int numBalls, uint64_t& hash, long long& steps)
+{
+    TableGeometry table;
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        hash = HASH_SEED;
+        steps = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int shot = 0; shot < SHOTS; shot++)
+        {
+            BallStore balls;
+            RackBalls(balls, numBalls, shot);
+            P physics;
+            steps += physics.RunToRest(balls, table, STEP_TIME, MAX_STEPS);
+            hash = CombineHash(hash, balls.ComputeHash());
+        }
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e9 / steps;
+}
+
+template <int N>
+static bool CompareRack()
+{
+    uint64_t dynamicHash, fixedHash;
+    long long dynamicSteps, fixedSteps;
+    double dynamic = TimeBreaks<DynamicPhysics>(N, dynamicHash, dynamicSteps);
+    double fixed = TimeBreaks<FixedPhysics<N>>(N, fixedHash, fixedSteps);
+    bool same = dynamicHash == fixedHash && dynamicSteps == fixedSteps;
+
+    printf("%6d %12.1f %12.1f %9.2fx %10lld  %s\n", N, dynamic, fixed, dynamic / fixed, fixedSteps,
+           same ? "identical" : "DIFFERENT");
+    return same;
+}
+
+int RunFixedPhysicsBench()
+{
+    printf("%d breaks run to rest at %.0f Hz, dynamic Physics without swept collisions\n\n", SHOTS, 1.0f / STEP_TIME);
+    printf("%6s %12s %12s %10s %10s  %s\n", "balls", "dynamic ns", "fixed ns", "speedup", "steps", "states");
+
+    bool same = CompareRack<16>();
+    same = CompareRack<22>() && same;
+    return same ? 0 : 1;
+}
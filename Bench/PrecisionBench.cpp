@@ -0,0 +1,170 @@
+#include "Bench.h"
+#include "FixedPhysics.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static const int SHOTS = 200;
+static const int REPETITIONS = 7;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+// End positions further than this from the double-precision run count as diverged
+static const double SAME_SHOT_DISTANCE = 1e-3;
+
+/**
+ * A long, non-chaotic run: one ball on a nearly frictionless carom table,
+ * where rounding error accumulates instead of being hidden by collisions
+ */
+struct GlideRules
+{
+    static constexpr float ROLLING_FRICTION = 0.999f;
+    static constexpr float LINEAR_DECELERATION = 0.0005f;
+    static constexpr float MIN_VELOCITY = 0.001f;
+    static constexpr float BALL_RESTITUTION = 0.95f;
+    static constexpr float CUSHION_RESTITUTION = 0.999f;
+    static constexpr float MAX_VELOCITY = 10.0f;
+    static const int COLLISION_ITERATIONS = 3;
+    static const bool HAS_POCKETS = false;
+};
+
+static const double GLIDE_SECONDS[] = { 10.0, 60.0, 300.0 };
+
+/**
+ * Run SHOTS breaks to rest, keeping the final stores
+ * @return Nanoseconds per step (best of REPETITIONS)
+ */
+template <class P>
+static double RunBreaks(std::vector<BallStore>& results, long long& steps)
+{
+    TableGeometry table;
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        results.assign(SHOTS, BallStore());
+        steps = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int shot = 0; shot < SHOTS; shot++)
+        {
+            RackShot(results[shot], shot);
+            P physics;
+            steps += physics.RunToRest(results[shot], table, STEP_TIME, MAX_STEPS);
+        }
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e9 / steps;
+}
+
+/**
+ * Print how far a policy's end positions are from the reference
+ */
+static void PrintError(const char* name, double ns, long long steps,
+                       const std::vector<BallStore>& results, const std::vector<BallStore>& reference)
+{
+    double sum = 0.0;
+    double worst = 0.0;
+    int compared = 0;
+    int potDifferences = 0;
+    int sameShots = 0;
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        const BallStore& balls = results[shot];
+        const BallStore& expected = reference[shot];
+        bool same = true;
+        for (int b = 0; b < balls.Size(); b++)
+        {
+            if (balls.IsActive(b) != expected.IsActive(b))
+            {
+                potDifferences++;
+                same = false;
+                continue;
+            }
+            if (!balls.IsActive(b))
+                continue;
+
+            double distance = std::hypot((double)balls.PosX[b] - expected.PosX[b], (double)balls.PosZ[b] - expected.PosZ[b]);
+            sum += distance;
+            compared++;
+            if (distance > worst)
+                worst = distance;
+            if (distance > SAME_SHOT_DISTANCE)
+                same = false;
+        }
+        sameShots += same;
+    }
+
+    printf("%-8s %8.1f %9lld %12.2e %12.2e %12d %9d/%d\n", name, ns, steps, sum / compared, worst,
+           potDifferences, sameShots, SHOTS);
+}
+
+/**
+ * Glide the ball for a while
+ * @return Nanoseconds per step
+ */
+template <class P>
+static double Glide(double seconds, double& x, double& z)
+{
+    TableGeometry table;
+    BallStore balls;
+    balls.Add(0, Vec3(0.1f, 0.0f, 0.3f), 0.057f);
+    balls.Add(1, Vec3(0.0f, 0.0f, 0.0f), 0.057f);
+    balls.SetActive(1, false);
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(0.6f, 0.0f, 0.8f), 3.0f);
+
+    P physics;
+    int steps = (int)(seconds / STEP_TIME);
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; s++)
+        physics.Update(balls, table, STEP_TIME);
+    double elapsed = SecondsSince(start);
+
+    x = balls.PosX[0];
+    z = balls.PosZ[0];
+    return elapsed * 1e9 / steps;
+}
+
+int RunPrecisionBench()
+{
+    std::vector<BallStore> floats, doubles, mixed;
+    long long floatSteps, doubleSteps, mixedSteps;
+    double floatNs = RunBreaks<FixedPhysics<16, PoolRules, FloatPrecision>>(floats, floatSteps);
+    double doubleNs = RunBreaks<FixedPhysics<16, PoolRules, DoublePrecision>>(doubles, doubleSteps);
+    double mixedNs = RunBreaks<FixedPhysics<16, PoolRules, MixedPrecision>>(mixed, mixedSteps);
+
+    // FloatPrecision must stay bit-identical to the dynamic step
+    std::vector<BallStore> dynamic(SHOTS);
+    TableGeometry table;
+    int identical = 0;
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        RackShot(dynamic[shot], shot);
+        Physics physics;
+        physics.SetContinuousCollision(false);
+        physics.RunToRest(dynamic[shot], table, STEP_TIME, MAX_STEPS);
+        identical += dynamic[shot].ComputeHash() == floats[shot].ComputeHash();
+    }
+
+    printf("%d breaks run to rest; error against DoublePrecision; FloatPrecision %s Physics (%d/%d)\n\n", SHOTS,
+           identical == SHOTS ? "identical to" : "DIFFERS from", identical, SHOTS);
+    printf("%-8s %8s %9s %12s %12s %12s %12s\n", "policy", "ns/step", "steps", "mean err m", "max err m",
+           "pot diffs", "within 1 mm");
+    PrintError("float", floatNs, floatSteps, floats, doubles);
+    PrintError("mixed", mixedNs, mixedSteps, mixed, doubles);
+    PrintError("double", doubleNs, doubleSteps, doubles, doubles);
+
+    printf("\nOne ball gliding on a near-frictionless table: distance from DoublePrecision\n");
+    printf("%8s %12s %10s %12s %10s %10s\n", "seconds", "float m", "float ns", "mixed m", "mixed ns", "double ns");
+    for (double seconds : GLIDE_SECONDS)
+    {
+        double floatX, floatZ, mixedX, mixedZ, doubleX, doubleZ;
+        double floatGlide = Glide<FixedPhysics<2, GlideRules, FloatPrecision>>(seconds, floatX, floatZ);
+        double mixedGlide = Glide<FixedPhysics<2, GlideRules, MixedPrecision>>(seconds, mixedX, mixedZ);
+        double doubleGlide = Glide<FixedPhysics<2, GlideRules, DoublePrecision>>(seconds, doubleX, doubleZ);
+        printf("%8.0f %12.2e %10.1f %12.2e %10.1f %10.1f\n", seconds, std::hypot(floatX - doubleX, floatZ - doubleZ),
+               floatGlide, std::hypot(mixedX - doubleX, mixedZ - doubleZ), mixedGlide, doubleGlide);
+    }
+    return identical == SHOTS ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cstdio>
+
+// Ball counts from one table's worth to a crowd; the table grows with the
+// count, so close to linear cost means the broadphase is doing its job
+static const int BALL_COUNTS[] = { 16, 150, 1500, 15000, 50000 };
+
+// Above this the quadratic all-pairs reference takes too long to time
+static const int ALL_PAIRS_MAX_BALLS = 1500;
+
+static const float BALL_RADIUS = 0.057f;
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int REPETITIONS = 3;
+
+/**
+ * Microseconds per step of a scattered, fully moving table (best of REPETITIONS)
+ */
+static double TimeSteps(int numBalls, Broadphase broadphase)
+{
+    TableGeometry table = MakeScaledTable(numBalls, BALL_RADIUS);
+    int steps = numBalls <= 1500 ? 200 : 20;
+
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        BallStore balls;
+        ScatterBalls(balls, table, numBalls, BALL_RADIUS, 3.0f, 1);
+        Physics physics;
+        physics.SetBroadphase(broadphase);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int s = 0; s < steps; s++)
+            physics.Update(balls, table, STEP_TIME);
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e6 / steps;
+}
+
+int RunScalingBench()
+{
+    printf("%8s %14s %14s %14s %12s\n", "balls", "all pairs us", "grid us", "auto us", "auto ns/ball");
+    for (int numBalls : BALL_COUNTS)
+    {
+        double grid = TimeSteps(numBalls, Broadphase::Grid);
+        double automatic = TimeSteps(numBalls, Broadphase::Auto);
+        if (numBalls <= ALL_PAIRS_MAX_BALLS)
+        {
+            double allPairs = TimeSteps(numBalls, Broadphase::AllPairs);
+            printf("%8d %14.1f %14.1f %14.1f %12.1f\n", numBalls, allPairs, grid, automatic, automatic * 1000.0 / numBalls);
+        }
+        else
+        {
+            printf("%8d %14s %14.1f %14.1f %12.1f\n", numBalls, "-", grid, automatic, automatic * 1000.0 / numBalls);
+        }
+    }
+    return 0;
+}
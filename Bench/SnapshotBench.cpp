@@ -0,0 +1,94 @@
+#include "Bench.h"
+#include "Physics.h"
+#include "WorldSnapshot.h"
+#include <cstdio>
+#include <vector>
+
+static const int ITERATIONS = 1000000;
+
+// Snapshots cycled through, so the timings include fetching a cold-ish copy
+static const int POOL_SIZE = 1024;
+
+static const float STEP_TIME = 1.0f / 240.0f;
+
+/**
+ * Nanoseconds per call of f(i) over `count` calls
+ */
+template <class F>
+static double TimeLoop(int count, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+        f(i);
+    return SecondsSince(start) * 1e9 / count;
+}
+
+int RunSnapshotBench()
+{
+    // A break in progress, in a store of the snapshot's capacity
+    TableGeometry table;
+    BallStore balls;
+    balls.Reserve(WorldSnapshot::MAX_BALLS);
+    AddStandardRack(balls, 0.057f);
+    Physics physics;
+    SimulationClock clock;
+    physics.ApplyImpulse(balls, 0, Vec3(0.02f, 0.0f, -1.0f), 8.0f);
+    for (int s = 0; s < 180; s++)
+        physics.Update(balls, table, STEP_TIME);
+
+    // Resuming from a snapshot must replay the same shot
+    WorldSnapshot snapshot;
+    snapshot.Save(balls, clock);
+    BallStore original = balls;
+    physics.RunToRest(original, table, STEP_TIME, 100000);
+    BallStore restored;
+    snapshot.Restore(restored);
+    Physics resumed;
+    resumed.RunToRest(restored, table, STEP_TIME, 100000);
+    bool identical = original.ComputeHash() == restored.ComputeHash();
+
+    printf("snapshot %d bytes, %d balls (%d awake), resumed run %s\n", (int)sizeof(WorldSnapshot),
+           balls.Size(), balls.GetAwakeCount(), identical ? "identical" : "DIFFERENT");
+
+    std::vector<WorldSnapshot> pool(POOL_SIZE);
+    BallStore work = balls;
+    volatile int sink = 0;
+
+    double save = TimeLoop(ITERATIONS, [&](int i)
+    {
+        pool[i % POOL_SIZE].Save(work, clock);
+        sink += pool[i % POOL_SIZE].Count;
+    });
+    double restore = TimeLoop(ITERATIONS, [&](int i)
+    {
+        pool[i % POOL_SIZE].Restore(work, clock);
+        sink += work.Size();
+    });
+    double assign = TimeLoop(ITERATIONS, [&](int)
+    {
+        work = balls;
+        sink += work.Size();
+    });
+    double construct = TimeLoop(ITERATIONS / 10, [&](int)
+    {
+        BallStore copy(balls);
+        sink += copy.Size();
+    });
+
+    // Capacity 16 store: saved field by field instead of one memcpy
+    BallStore rack;
+    AddStandardRack(rack, 0.057f);
+    WorldSnapshot fieldwise;
+    double saveFields = TimeLoop(ITERATIONS, [&](int)
+    {
+        fieldwise.Save(rack);
+        sink += fieldwise.Count;
+    });
+
+    printf("%-44s %8.1f ns\n", "WorldSnapshot::Save", save);
+    printf("%-44s %8.1f ns\n", "WorldSnapshot::Restore", restore);
+    printf("%-44s %8.1f ns\n", "BallStore assignment", assign);
+    printf("%-44s %8.1f ns\n", "BallStore copy construction (allocates)", construct);
+    printf("%-44s %8.1f ns\n", "WorldSnapshot::Save, capacity 16 (per field)", saveFields);
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cstdio>
+
+static const int SHOTS = 200;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+// Runs alternate between the two settings, so drift on a noisy machine hits both
+static const int REPETITIONS = 15;
+
+// The overhead PhysicsStats is allowed when enabled
+static const double MAX_OVERHEAD = 0.02;
+
+/**
+ * Seconds for SHOTS breaks run to rest, with the totals of every shot
+ */
+static double RunBreaks(bool phaseTiming, PhysicsStats& totals, long long& steps)
+{
+    TableGeometry table;
+    totals.Reset();
+    steps = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        BallStore balls;
+        RackShot(balls, shot);
+        Physics physics;
+        physics.SetPhaseTiming(phaseTiming);
+        steps += physics.RunToRest(balls, table, STEP_TIME, MAX_STEPS);
+        totals.Add(physics.GetTotalStats());
+    }
+    return SecondsSince(start);
+}
+
+/**
+ * Cost of stats collection. In one binary it compares the full collection
+ * against the same run with phase timing off (counters only). The counters
+ * themselves are measured against a second build configured with
+ * -DBILLIARD_PHYSICS_STATS=OFF: run `BilliardBench stats` in both and
+ * compare the "timing off" rows.
+ */
+int RunStatsBench()
+{
+    PhysicsStats timed, untimed;
+    long long steps = 0;
+    double bestTimed = 1e30;
+    double bestUntimed = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        double seconds = RunBreaks(true, timed, steps);
+        if (seconds < bestTimed)
+            bestTimed = seconds;
+        seconds = RunBreaks(false, untimed, steps);
+        if (seconds < bestUntimed)
+            bestUntimed = seconds;
+    }
+
+    // Counters stay zero when BILLIARD_NO_PHYSICS_STATS compiled them out
+    bool compiledIn = timed.Steps != 0;
+    double timedNs = bestTimed * 1e9 / steps;
+    double untimedNs = bestUntimed * 1e9 / steps;
+    double overhead = timedNs / untimedNs - 1.0;
+
+    printf("%d breaks run to rest, %lld steps; stats %s\n", SHOTS, steps,
+           compiledIn ? "compiled in" : "compiled out (BILLIARD_PHYSICS_STATS=OFF)");
+    printf("timing on:  %7.1f ns/step (%lld steps timed)\n", timedNs, timed.TimedSteps);
+    printf("timing off: %7.1f ns/step\n", untimedNs);
+    if (!compiledIn)
+        return 0;
+
+    printf("phase timing overhead %+.2f%% (limit %.0f%%)%s\n", overhead * 100.0, MAX_OVERHEAD * 100.0,
+           overhead > MAX_OVERHEAD ? "  OVER" : "");
+
+    printf("\nper step: %.1f pairs tested, %.2f overlaps, %.2f impulses, %.2f iterations\n",
+           (double)timed.PairsTested / timed.Steps, (double)timed.Overlaps / timed.Steps,
+           (double)timed.Impulses / timed.Steps, (double)timed.Iterations / timed.Steps);
+    printf("phase ns per timed step:");
+    for (int p = 0; p < PhysicsStats::PHASE_COUNT; p++)
+    {
+        PhysicsPhase phase = (PhysicsPhase)p;
+        printf(" %s %.0f", PhysicsStats::GetPhaseName(phase), timed.GetPhaseAverage(phase) * 1e9);
+    }
+    printf("\n");
+    return 0;
+}
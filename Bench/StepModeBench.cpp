@@ -0,0 +1,136 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cstdio>
+#include <random>
+
+// In L1, in L2, and far past the last-level cache
+static const int BALL_COUNTS[] = { 16, 4096, 262144, 2097152 };
+
+// Ball passes timed per configuration
+static const long long BALL_PASSES = 50000000;
+static const int REPETITIONS = 3;
+
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int MAX_STEPS = 100000;
+static const int SHOTS = 200;
+
+// Bytes per ball of the per-ball passes (floats and awake words read + written)
+static const int MULTI_PASS_BYTES = (14 + 8) * 4;
+static const int FUSED_BYTES = (5 + 4) * 4;
+
+/**
+ * Loose balls with random velocities, one in ten potted
+ */
+static void FillStore(BallStore& balls, int count)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> x(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> z(-2.4f, 2.4f);
+    std::uniform_real_distribution<float> v(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    balls.Reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        int k = balls.Add(i, Vec3(x(rng), 0.057f, z(rng)), 0.057f);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+        if (unit(rng) < 0.1f)
+            balls.SetActive(k, false);
+    }
+}
+
+/**
+ * Nanoseconds per ball of f() run over `count` balls (best of REPETITIONS)
+ */
+template <class F>
+static double TimePasses(int count, F f)
+{
+    long long passes = BALL_PASSES / count + 1;
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (long long p = 0; p < passes; p++)
+            f();
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e9 / ((double)passes * count);
+}
+
+/**
+ * Nanoseconds per full step over SHOTS breaks run to rest
+ */
+static double TimeBreaks(StepMode mode, PhysicsKernels::InstructionSet set)
+{
+    TableGeometry table;
+    double best = 1e30;
+    long long steps = 0;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        steps = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int shot = 0; shot < SHOTS; shot++)
+        {
+            BallStore balls;
+            RackShot(balls, shot);
+            Physics physics;
+            physics.SetInstructionSet(set);
+            physics.SetStepMode(mode);
+            steps += physics.RunToRest(balls, table, STEP_TIME, MAX_STEPS);
+        }
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e9 / steps;
+}
+
+int RunStepModeBench()
+{
+    using namespace PhysicsKernels;
+
+    float frictionFactor = powf(PhysicsConstants::ROLLING_FRICTION, STEP_TIME);
+    float reduction = PhysicsConstants::LINEAR_DECELERATION * STEP_TIME;
+    InstructionSet widest = DetectInstructionSet();
+    InstructionSet sets[] = { InstructionSet::Scalar, widest };
+    int numSets = widest == InstructionSet::Scalar ? 1 : 2;
+
+    printf("Per-ball passes (friction, integrate, clamp, stop): %d bytes per ball multi-pass, %d fused\n\n",
+           MULTI_PASS_BYTES, FUSED_BYTES);
+    printf("%-7s %9s %14s %14s %9s\n", "kernels", "balls", "multi ns/ball", "fused ns/ball", "speedup");
+    for (int s = 0; s < numSets; s++)
+    {
+        InstructionSet set = sets[s];
+        for (int count : BALL_COUNTS)
+        {
+            BallStore balls;
+            FillStore(balls, count);
+            double multi = TimePasses(count, [&]()
+            {
+                ApplyFriction(set, balls.VelX, balls.VelZ, balls.Awake, count, frictionFactor, reduction);
+                IntegratePositions(set, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ, balls.Awake, count, STEP_TIME);
+                ClampVelocities(set, balls.VelX, balls.VelZ, balls.Awake, count, PhysicsConstants::MAX_VELOCITY);
+                StopSlowBalls(set, balls.VelX, balls.VelZ, balls.Awake, count, PhysicsConstants::MIN_VELOCITY);
+            });
+            double fused = TimePasses(count, [&]()
+            {
+                FusedStep(set, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ, balls.Awake, count,
+                          PhysicsConstants::MAX_VELOCITY, PhysicsConstants::MIN_VELOCITY, frictionFactor, reduction,
+                          STEP_TIME);
+            });
+            printf("%-7s %9d %14.2f %14.2f %8.2fx\n", GetInstructionSetName(set), count, multi, fused, multi / fused);
+        }
+    }
+
+    printf("\n%d breaks run to rest, full step\n", SHOTS);
+    printf("%-7s %14s %14s\n", "kernels", "multi ns/step", "fused ns/step");
+    for (int s = 0; s < numSets; s++)
+    {
+        double multi = TimeBreaks(StepMode::MultiPass, sets[s]);
+        double fused = TimeBreaks(StepMode::Fused, sets[s]);
+        printf("%-7s %14.1f %14.1f\n", GetInstructionSetName(sets[s]), multi, fused);
+    }
+    return 0;
+}
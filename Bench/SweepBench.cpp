@@ -0,0 +1,184 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cstdio>
+
+// The ball counts Broadphase::Auto was tuned on
+static const int BALL_COUNTS[] = { 16, 150, 1500, 15000 };
+
+// Above this the all-pairs loop is not timed on a fully moving table
+static const int ALL_PAIRS_MAX_BALLS = 1500;
+
+static const float BALL_RADIUS = 0.057f;
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int REPETITIONS = 3;
+
+// One second of play per run, while the moving balls still move; small
+// tables repeat the run until about this many ball steps are timed
+static const int STEPS_PER_RUN = 120;
+static const int BALL_STEPS_PER_REPETITION = 240000;
+
+/**
+ * How many balls move: every one (a break on a crowded table), a few
+ * among sleeping ones, or one (the cue ball on a resting table)
+ */
+struct Scenario
+{
+    const char* Name;
+    int Awake;   // -1 = every ball
+};
+
+static const Scenario SCENARIOS[] =
+{
+    { "all awake", -1 },
+    { "8 awake", 8 },
+    { "1 awake", 1 },
+};
+
+/**
+ * A timed broadphase, with the scalar kernels or the widest SIMD set
+ */
+struct Column
+{
+    Broadphase Method;
+    bool Simd;
+    const char* Heading;
+};
+
+static const Column COLUMNS[] =
+{
+    { Broadphase::AllPairs, false, "all us" },
+    { Broadphase::AllPairs, true, "all simd us" },
+    { Broadphase::Grid, false, "grid us" },
+    { Broadphase::SweepAndPrune, false, "sweep us" },
+    { Broadphase::Auto, false, "auto us" },
+};
+
+static const int NUM_COLUMNS = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+static void SetUp(BallStore& balls, const TableGeometry& table, int numBalls, int numAwake)
+{
+    if (numAwake < 0)
+    {
+        ScatterBalls(balls, table, numBalls, BALL_RADIUS, 3.0f, 1);
+        return;
+    }
+
+    // Everything at rest, then a few balls sent off
+    ScatterBalls(balls, table, numBalls, BALL_RADIUS, 0.0f, 1);
+    balls.SleepSlowBalls(1.0f);
+    for (int i = 0; i < numAwake; i++)
+        balls.SetVelocity(i, Vec3(1.5f + 0.25f * i, 0.0f, 2.0f - 0.5f * i));
+}
+
+/**
+ * Microseconds per step (best of REPETITIONS), with the final state hash
+ * and the mean awake count of a run
+ */
+static double TimeSteps(int numBalls, int numAwake, Broadphase broadphase, PhysicsKernels::InstructionSet set,
+                        uint64_t& hash, double& meanAwake)
+{
+    TableGeometry table = MakeScaledTable(numBalls, BALL_RADIUS);
+    int runs = BALL_STEPS_PER_REPETITION / (numBalls * STEPS_PER_RUN);
+    if (runs < 1)
+        runs = 1;
+
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        double elapsed = 0.0;
+        for (int run = 0; run < runs; run++)
+        {
+            BallStore balls;
+            SetUp(balls, table, numBalls, numAwake);
+            Physics physics;
+            physics.SetBroadphase(broadphase);
+            physics.SetInstructionSet(set);
+
+            long long awakeSum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int s = 0; s < STEPS_PER_RUN; s++)
+            {
+                awakeSum += balls.GetAwakeCount();
+                physics.Update(balls, table, STEP_TIME);
+            }
+            elapsed += SecondsSince(start);
+
+            hash = balls.ComputeHash();
+            meanAwake = (double)awakeSum / STEPS_PER_RUN;
+        }
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e6 / ((double)runs * STEPS_PER_RUN);
+}
+
+int RunSweepBench()
+{
+    // Scalar kernels except in the "all simd" column: Auto's constants pick
+    // between the loops as written; with SIMD kernels it also takes all
+    // pairs on tables of up to PhysicsKernels::MAX_OVERLAP_BALLS balls, and
+    // the all-pairs branch tests them with PhysicsKernels::FindOverlaps
+    PhysicsKernels::InstructionSet widest = PhysicsKernels::DetectInstructionSet();
+    printf("Auto: grid when active > %d and awake^2 > %d x active, else all pairs when\n"
+           "awake x active <= %d, else sweep and prune\n"
+           "all simd: all pairs with %s kernels, tables of up to %d balls\n\n",
+           PhysicsConstants::GRID_BROADPHASE_THRESHOLD, PhysicsConstants::GRID_AWAKE_FACTOR,
+           PhysicsConstants::ALL_PAIRS_MAX_TESTS, PhysicsKernels::GetInstructionSetName(widest),
+           PhysicsKernels::MAX_OVERLAP_BALLS);
+    printf("%-10s %7s %8s %14s %14s", "scenario", "balls", "awake", "awake x balls", "awake^2/balls");
+    for (const Column& column : COLUMNS)
+        printf(" %11s", column.Heading);
+    printf("\n");
+
+    int mismatches = 0;
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        for (int numBalls : BALL_COUNTS)
+        {
+            double times[NUM_COLUMNS];
+            uint64_t hashes[NUM_COLUMNS];
+            double meanAwake = 0.0;
+            for (int c = 0; c < NUM_COLUMNS; c++)
+            {
+                const Column& column = COLUMNS[c];
+                times[c] = -1.0;
+                hashes[c] = 0;
+                if (column.Method == Broadphase::AllPairs && scenario.Awake < 0 && numBalls > ALL_PAIRS_MAX_BALLS)
+                    continue;
+
+                // Past the kernel's table size (or without SIMD) it is the scalar loop again
+                if (column.Simd && (numBalls > PhysicsKernels::MAX_OVERLAP_BALLS ||
+                                    widest == PhysicsKernels::InstructionSet::Scalar))
+                    continue;
+                PhysicsKernels::InstructionSet set = column.Simd ? widest : PhysicsKernels::InstructionSet::Scalar;
+                times[c] = TimeSteps(numBalls, scenario.Awake, column.Method, set, hashes[c], meanAwake);
+            }
+
+            // Every broadphase resolves the same contacts in the same order
+            bool same = true;
+            int reference = -1;
+            for (int c = 0; c < NUM_COLUMNS; c++)
+            {
+                if (times[c] < 0.0)
+                    continue;
+                if (reference < 0)
+                    reference = c;
+                else if (hashes[c] != hashes[reference])
+                    same = false;
+            }
+            mismatches += !same;
+
+            printf("%-10s %7d %8.1f %14.0f %14.1f", scenario.Name, numBalls, meanAwake,
+                   meanAwake * numBalls, meanAwake * meanAwake / numBalls);
+            for (int c = 0; c < NUM_COLUMNS; c++)
+            {
+                if (times[c] < 0.0)
+                    printf(" %11s", "-");
+                else
+                    printf(" %11.1f", times[c]);
+            }
+            printf("%s\n", same ? "" : "  RESULTS DIFFER");
+        }
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+#include "Bench.h"
+#include "Physics.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static const int NUM_POINTS = 4096;
+static const int PASSES = 2000;
+static const int REPETITIONS = 5;
+
+static const int SHOTS = 200;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+/**
+ * The pocket queries as Physics made them before the zone grid: every pocket, every time
+ */
+static bool LoopInPocketGap(const TableGeometry& table, float x, float z)
+{
+    float gapThreshold = table.GetPocketGapRadius();
+    for (int i = 0; i < TableGeometry::NUM_POCKETS; i++)
+    {
+        float dx = x - table.PocketPositions[i].x;
+        float dz = z - table.PocketPositions[i].z;
+        if (dx * dx + dz * dz < gapThreshold * gapThreshold)
+            return true;
+    }
+    return false;
+}
+
+static int LoopFindPocket(const TableGeometry& table, float x, float z)
+{
+    float prSq = table.PocketRadius * table.PocketRadius;
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        float dx = x - table.PocketPositions[p].x;
+        float dz = z - table.PocketPositions[p].z;
+        if (dx * dx + dz * dz < prSq)
+            return p;
+    }
+    return -1;
+}
+
+/**
+ * Nanoseconds per point of the gap and pocket queries (best of REPETITIONS)
+ */
+template <class Query>
+static double TimeQueries(const std::vector<float>& x, const std::vector<float>& z, Query query, int& answers)
+{
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        int sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; pass++)
+        {
+            for (int i = 0; i < NUM_POINTS; i++)
+                sum += query(x[i], z[i]);
+        }
+        double elapsed = SecondsSince(start);
+        answers = sum;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best * 1e9 / ((double)PASSES * NUM_POINTS);
+}
+
+int RunZoneBench()
+{
+    // Ball centers anywhere on the cloth
+    TableGeometry table;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> px(-table.Width / 2.0f, table.Width / 2.0f);
+    std::uniform_real_distribution<float> pz(-table.Length / 2.0f, table.Length / 2.0f);
+    std::vector<float> x(NUM_POINTS), z(NUM_POINTS);
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        x[i] = px(rng);
+        z[i] = pz(rng);
+    }
+
+    int loopAnswers, gridAnswers;
+    double loops = TimeQueries(x, z, [&](float qx, float qz)
+    {
+        return (int)LoopInPocketGap(table, qx, qz) + LoopFindPocket(table, qx, qz);
+    }, loopAnswers);
+    double grid = TimeQueries(x, z, [&](float qx, float qz)
+    {
+        return (int)table.IsInPocketGap(qx, qz) + table.FindPocket(qx, qz);
+    }, gridAnswers);
+
+    // Rack shots with the grid in the step
+    long long steps = 0;
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; rep++)
+    {
+        steps = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int shot = 0; shot < SHOTS; shot++)
+        {
+            BallStore balls;
+            RackShot(balls, shot);
+            Physics physics;
+            steps += physics.RunToRest(balls, table, STEP_TIME, MAX_STEPS);
+        }
+        double elapsed = SecondsSince(start);
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    bool same = loopAnswers == gridAnswers;
+    printf("gap + pocket query: six-pocket loops %.2f ns, zone grid %.2f ns per point (%s answers)\n", loops, grid,
+           same ? "same" : "DIFFERENT");
+    printf("%d rack shots run to rest: %.1f ns/step over %lld steps\n", SHOTS, best * 1e9 / steps, steps);
+    return same ? 0 : 1;
+}
@@ -2,29 +2,25 @@
 #define BALL_H
 
 #include "Util.h"
+#include "BallStore.h"
 #include "Shader.h"
 #include "Model.h"
 #include <GL/glew.h>
 
+/**
+ * Ball Class
+ * ----------
+ * Render-side view of one ball in a BallStore.
+ * Physics state (position, velocity, radius, active flag) lives in the store;
+ * the view only adds what is needed to draw the ball.
+ */
 class Ball
 {
 public:
-    // Physics properties
-    Vec3 Position;
-    Vec3 Velocity;
-    float Radius;
-
     // Visual properties
     Vec3 Color;
 
-    // State
-    bool IsActive;
-
-    // Ball number (for identification)
-    int Number;
-
-    Ball(int number, const Vec3& position, float radius, const Vec3& color);
-    ~Ball();
+    Ball(const BallStore* store, int index, const Vec3& color);
 
     /**
      * Load the shared sphere model from file (call once at startup)
@@ -37,20 +33,31 @@ public:
      */
     static void CleanupModel();
 
-    void Render(Shader& shader, const Mat4& viewProjection);
-    void Update(float deltaTime);
+    void Render(Shader& shader, const Mat4& viewProjection) const;
     Mat4 GetModelMatrix() const;
-    bool IsMoving() const;
-    void Stop();
+
+    // Accessors into the store
+    int GetIndex() const { return Index; }
+    int GetNumber() const { return Store->Number[Index]; }
+    Vec3 GetPosition() const { return Store->GetPosition(Index); }
+    float GetRadius() const { return Store->Radius[Index]; }
+    bool IsActive() const { return Store->IsActive(Index); }
 
 private:
     // Shared 3D model for all balls
     static Model* s_SphereModel;
 
-    // Velocity threshold for considering ball "stopped"
-    static constexpr float VELOCITY_THRESHOLD = 0.001f;
+    // Store holding this ball's physics state
+    const BallStore* Store;
+    int Index;
 };
 
-std::vector<Ball*> CreateStandardBallSet(float ballRadius);
+/**
+ * Fill a store with the standard rack and create a render view for every ball
+ * @param store      Store to fill (see AddStandardRack)
+ * @param ballRadius Radius of every ball
+ * @return One view per ball, in store order
+ */
+std::vector<Ball> CreateStandardBallSet(BallStore& store, float ballRadius);
 
 #endif // BALL_H
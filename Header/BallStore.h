@@ -0,0 +1,164 @@
+#ifndef BALL_STORE_H
+#define BALL_STORE_H
+
+#include "MathUtil.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Ball Store
+ * ----------
+ * Structure-of-arrays storage for the physics state of every ball.
+ *
+ * All fields live in one contiguous, 32-byte aligned block, one array per
+ * field, so physics passes stream through exactly the data they touch
+ * instead of chasing pointers to heap-allocated Ball objects. Capacity is
+ * kept a multiple of 8 so each array can be processed in full SIMD lanes.
+ *
+ * Balls always rest on the table surface, so only X/Z are stored;
+ * Y of a ball center is its radius.
+ *
+ * Balls at rest are put to sleep: they are removed from the awake list
+ * and physics passes skip them until an awake ball touches them or a
+ * velocity is set. Newly added balls start asleep.
+ *
+ * The awake list is stored in the block too, so the block plus the two
+ * counts is the entire state (see WorldSnapshot).
+ *
+ * Render-only state (color, mesh) lives in Ball, which is a view into this store.
+ */
+class BallStore
+{
+public:
+    // Active mask values (all bits set so the mask can be used directly as a SIMD lane mask)
+    static const uint32_t ACTIVE = 0xFFFFFFFFu;
+    static const uint32_t INACTIVE = 0u;
+
+    // Awake mask values (same layout as the active mask)
+    static const uint32_t AWAKE = 0xFFFFFFFFu;
+    static const uint32_t ASLEEP = 0u;
+
+    // Field arrays, indexed by ball (valid for [0, Size()))
+    float* PosX;
+    float* PosZ;
+    float* VelX;
+    float* VelZ;
+    float* Radius;
+    uint32_t* Active;  // ACTIVE while on the table, INACTIVE once potted
+    int* Number;       // Ball number (0 = cue ball)
+    uint32_t* Awake;   // AWAKE while simulated, ASLEEP while resting (change with Wake/Sleep)
+
+    // Number of field arrays in the block (the 8 above plus the awake list)
+    static const int NUM_FIELDS = 9;
+
+    BallStore();
+    BallStore(const BallStore& other);
+    BallStore& operator=(const BallStore& other);
+
+    /**
+     * Add a ball at rest
+     * @param number   Ball number (0 = cue ball)
+     * @param position Center position (Y is ignored)
+     * @param radius   Ball radius
+     * @return Index of the new ball
+     */
+    int Add(int number, const Vec3& position, float radius);
+
+    /**
+     * Remove all balls (keeps the allocated block)
+     */
+    void Clear();
+
+    /**
+     * Grow the block to hold at least the given number of balls
+     */
+    void Reserve(int capacity);
+
+    int Size() const { return Count; }
+    int GetCapacity() const { return Capacity; }
+
+    bool IsActive(int i) const { return Active[i] != INACTIVE; }
+    void SetActive(int i, bool active) { Active[i] = active ? ACTIVE : INACTIVE; }
+
+    Vec3 GetPosition(int i) const { return Vec3(PosX[i], Radius[i], PosZ[i]); }
+    void SetPosition(int i, const Vec3& position) { PosX[i] = position.x; PosZ[i] = position.z; }
+
+    Vec3 GetVelocity(int i) const { return Vec3(VelX[i], 0.0f, VelZ[i]); }
+
+    /**
+     * Set a ball's velocity and wake it
+     */
+    void SetVelocity(int i, const Vec3& velocity);
+
+    void Stop(int i) { VelX[i] = 0.0f; VelZ[i] = 0.0f; }
+
+    /**
+     * Check if a ball is moving faster than the "stopped" threshold
+     */
+    bool IsMoving(int i) const;
+
+    bool IsAwake(int i) const { return Awake[i] != ASLEEP; }
+
+    /**
+     * Add a ball to the awake list (no-op if it is already awake)
+     */
+    void Wake(int i);
+
+    /**
+     * Remove a ball from the awake list (no-op if it is already asleep)
+     */
+    void Sleep(int i);
+
+    /**
+     * Put every awake ball slower than minVelocity (or no longer active) to sleep
+     * Sleeping balls have their velocity zeroed
+     */
+    void SleepSlowBalls(float minVelocity);
+
+    /**
+     * Indices of the awake balls, in the order they were woken
+     * (GetAwakeCount entries; balls woken later are appended without moving the array)
+     */
+    const int* GetAwakeBalls() const { return AwakeList; }
+    int GetAwakeCount() const { return AwakeCount; }
+
+    /**
+     * Find a ball by its number
+     * @return Index of the ball, or -1 if there is none
+     */
+    int FindBall(int number) const;
+
+    /**
+     * Hash of the simulated state (positions, velocities, active flags, numbers)
+     * Equal states give equal hashes bit for bit; used to check that replays
+     * and lockstep peers have not diverged
+     */
+    uint64_t ComputeHash() const;
+
+private:
+    // Velocity threshold for considering a ball "stopped"
+    static constexpr float VELOCITY_THRESHOLD = 0.001f;
+
+    std::vector<unsigned char> Block;
+    int* AwakeList;    // Awake ball indices, the 9th array of the block
+    int AwakeCount;
+    int Count;
+    int Capacity;
+
+    friend struct WorldSnapshot;
+
+    /**
+     * Point the field arrays into the (already sized) block
+     */
+    void BindFields();
+};
+
+/**
+ * Add the cue ball and a standard 15-ball triangle rack to a store
+ * Cue ball is added first (index 0), then the rack in row order
+ * @param store      Store to fill
+ * @param ballRadius Radius of every ball
+ */
+void AddStandardRack(BallStore& store, float ballRadius);
+
+#endif // BALL_STORE_H
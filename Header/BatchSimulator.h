@@ -0,0 +1,108 @@
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include "Physics.h"
+#include "PhysicsEvent.h"
+#include <vector>
+
+/**
+ * One shot to simulate: a cue impulse applied to a ball of a table state
+ */
+struct BatchShot
+{
+    int Ball;           // Index of the struck ball (usually the cue ball)
+    Vec3 Direction;     // Direction of the impulse (normalized by ApplyImpulse)
+    float Power;        // Impulse strength, as passed to Physics::ApplyImpulse
+};
+
+/**
+ * Outcome of one simulated shot
+ */
+struct BatchResult
+{
+    BallStore Balls;                    // State once all balls stopped (or the step limit hit)
+    std::vector<PhysicsEvent> Events;   // Contacts, cushion hits, pots and scratches in order
+    int Steps;                          // Physics steps taken
+    bool Stopped;                       // false if the step limit was reached first
+};
+
+/**
+ * Batch Simulator
+ * ---------------
+ * Runs many independent shots to rest on a pool of worker threads.
+ *
+ * Each job is one (table state, shot) pair. Workers pull job indices from
+ * an atomic counter, copy the table state into their result, and step their
+ * own Physics instance (copied from a shared, read-only prototype) until the
+ * balls stop. The only shared data is the read-only table geometry and the
+ * inputs, so the workers never lock or write to each other's memory.
+ *
+ * Nothing here depends on OpenGL, so a batch can run without a GL context.
+ */
+class BatchSimulator
+{
+public:
+    /**
+     * Constructor
+     * @param threadCount Worker threads (0 = one per hardware thread)
+     */
+    BatchSimulator(int threadCount = 0);
+
+    /**
+     * Simulate every shot against its table state and wait for all to finish
+     * @param table Table geometry shared by all jobs (read only)
+     * @param states Starting ball states, one per shot
+     * @param shots Shots to play, one per state
+     * @return One result per shot, in the same order
+     */
+    std::vector<BatchResult> Run(const TableGeometry& table,
+                                 const std::vector<BallStore>& states,
+                                 const std::vector<BatchShot>& shots);
+
+    /**
+     * Physics settings every worker starts from (step mode, collision iterations,
+     * continuous collision)
+     */
+    Physics& GetPhysics();
+
+    /**
+     * Fixed time step used for every shot, in seconds
+     */
+    void SetTimeStep(float deltaTime);
+    float GetTimeStep() const;
+
+    /**
+     * Safety limit on the steps of a single shot
+     */
+    void SetMaxSteps(int maxSteps);
+    int GetMaxSteps() const;
+
+    void SetThreadCount(int threadCount);
+    int GetThreadCount() const;
+
+    /**
+     * Throughput of the last Run
+     */
+    double GetShotsPerSecond() const;
+    double GetShotsPerSecondPerCore() const;
+
+private:
+    /**
+     * Simulate one job into its result slot
+     */
+    void RunShot(Physics& physics, const TableGeometry& table, const BallStore& state,
+                 const BatchShot& shot, BatchResult& result) const;
+
+    Physics Prototype;
+    float TimeStep;
+    int MaxSteps;
+    int ThreadCount;
+
+    // Measurements of the last Run
+    int LastThreadsUsed;
+    double LastShotsPerSecond;
+};
+
+#endif // BATCH_SIMULATOR_H
@@ -0,0 +1,68 @@
+#ifndef CUSHION_BVH_H
+#define CUSHION_BVH_H
+
+#include <vector>
+
+/**
+ * One straight piece of cushion (or pocket jaw) on the XZ plane
+ * Segments are two-sided: a ball bounces off whichever side it touches
+ */
+struct CushionSegment
+{
+    float AX, AZ;   // Start point
+    float BX, BZ;   // End point
+    int Rail;       // Reported as Other in CushionHit events (-1 for pocket liners)
+};
+
+/**
+ * Cushion BVH
+ * -----------
+ * Bounding volume hierarchy over cushion segments.
+ *
+ * Nodes are axis-aligned boxes on the XZ plane stored in one flat array
+ * (children of a node are adjacent), built top-down by splitting the
+ * segments at the median of their centers along the longer axis. A
+ * query visits only the nodes whose boxes overlap the query box, so the
+ * cost per ball depends on the cushions near it, not on how many
+ * segments the whole table has.
+ */
+class CushionBVH
+{
+public:
+    /**
+     * Build the hierarchy (segments are copied and reordered)
+     */
+    void Build(const std::vector<CushionSegment>& segments);
+
+    /**
+     * Collect every segment whose bounds overlap a box
+     * @param out Indices into GetSegments (cleared first)
+     */
+    void Query(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const;
+
+    const CushionSegment* GetSegments() const { return Segments.data(); }
+    int GetSegmentCount() const { return (int)Segments.size(); }
+    int GetNodeCount() const { return (int)Nodes.size(); }
+
+private:
+    // Most segments kept in one leaf
+    static const int MAX_LEAF_SEGMENTS = 2;
+
+    struct Node
+    {
+        float MinX, MinZ;
+        float MaxX, MaxZ;
+        int First;   // Leaf: first segment; inner node: index of the left child (right follows it)
+        int Count;   // Segments in a leaf, 0 for inner nodes
+    };
+
+    std::vector<CushionSegment> Segments;
+    std::vector<Node> Nodes;
+
+    /**
+     * Build the subtree of Segments[first, first + count) into Nodes[node]
+     */
+    void BuildNode(int node, int first, int count);
+};
+
+#endif // CUSHION_BVH_H
@@ -0,0 +1,48 @@
+#ifndef DETERMINISTIC_MATH_H
+#define DETERMINISTIC_MATH_H
+
+/**
+ * Deterministic Math
+ * ------------------
+ * Portable replacements for the libm functions the physics uses.
+ *
+ * The C library's exp/log/pow are not required to be correctly rounded,
+ * and different compilers, runtimes and CPUs return different last bits.
+ * These versions use only IEEE addition, subtraction, multiplication,
+ * division and exact power-of-two scaling (frexp/ldexp/floor), in a fixed
+ * order, so every conforming platform produces the same bits.
+ *
+ * They are used for the whole step, and for the cushion geometry the step
+ * reads, when BILLIARD_DETERMINISTIC is defined (see Physics.h); accuracy
+ * is within a few ulp of double precision.
+ */
+namespace DeterministicMath
+{
+    /**
+     * e^x
+     */
+    double Exp(double x);
+
+    /**
+     * Natural logarithm (x must be positive)
+     */
+    double Log(double x);
+
+    /**
+     * base^exponent for a positive base
+     */
+    float Pow(float base, float exponent);
+
+    /**
+     * Sine and cosine of an angle in radians (|x| up to about 1e6)
+     */
+    double Sin(double x);
+    double Cos(double x);
+
+    /**
+     * Angle of the point (x, y) in radians, in [-pi, pi] (same conventions as atan2)
+     */
+    double Atan2(double y, double x);
+}
+
+#endif // DETERMINISTIC_MATH_H
@@ -0,0 +1,134 @@
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+
+#include "CushionBVH.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Distance Field
+ * --------------
+ * Signed distance to the table boundary, baked on a regular XZ grid.
+ *
+ * Distances are positive inside the playable region (the area enclosed by
+ * the cushion segments, including pocket mouths) and negative outside it.
+ * Each node also stores the unit gradient of the distance, which points
+ * away from the nearest boundary point, into the table. Sampling is
+ * bilinear, so a ball-cushion test is one lookup of four adjacent nodes
+ * however many segments the boundary has.
+ *
+ * The field is one-sided: a ball that ends a step beyond the boundary
+ * reads a negative distance and is pushed back inside along the gradient.
+ *
+ * Baking computes every node from the segments, split by rows across
+ * threads. Because it is slow for detailed tables, fields can be saved to
+ * and loaded from a cache file keyed on a hash of the inputs.
+ */
+class DistanceField
+{
+public:
+    DistanceField();
+
+    /**
+     * Bake the field of a set of closed cushion loops
+     * @param cushions    Boundary segments (must form closed loops for the sign to be meaningful)
+     * @param minX, minZ  Corner of the area covered
+     * @param maxX, maxZ  Opposite corner
+     * @param cellSize    Node spacing
+     * @param threadCount Bake threads (0 = one per hardware thread)
+     */
+    void Bake(const CushionBVH& cushions, float minX, float minZ, float maxX, float maxZ,
+              float cellSize, int threadCount = 0);
+
+    /**
+     * Hash identifying the inputs of a bake (segments, area and node spacing)
+     */
+    static uint64_t ComputeKey(const CushionBVH& cushions, float minX, float minZ, float maxX, float maxZ,
+                               float cellSize);
+
+    /**
+     * Load a field saved with the given key
+     * @return false if the file is missing, corrupt or was baked from other inputs
+     */
+    bool Load(const char* path, uint64_t key);
+
+    /**
+     * Save the field with the key of its inputs
+     * @return false if the file cannot be written
+     */
+    bool Save(const char* path, uint64_t key) const;
+
+    /**
+     * Drop the baked data
+     */
+    void Clear();
+
+    bool IsBaked() const { return !Nodes.empty(); }
+
+    /**
+     * Signed distance at a point, with the (unnormalized) gradient there
+     * Points off the grid are clamped to its border
+     */
+    float Sample(float x, float z, float& gradX, float& gradZ) const
+    {
+        float fx = (x - OriginX) * InvCellSize;
+        float fz = (z - OriginZ) * InvCellSize;
+        fx = fx < 0.0f ? 0.0f : (fx > MaxCoordX ? MaxCoordX : fx);
+        fz = fz < 0.0f ? 0.0f : (fz > MaxCoordZ ? MaxCoordZ : fz);
+
+        int cx = (int)fx;
+        int cz = (int)fz;
+        float tx = fx - cx;
+        float tz = fz - cz;
+
+        const Node* row0 = &Nodes[(size_t)cz * Columns + cx];
+        const Node* row1 = row0 + Columns;
+        float w00 = (1.0f - tx) * (1.0f - tz);
+        float w10 = tx * (1.0f - tz);
+        float w01 = (1.0f - tx) * tz;
+        float w11 = tx * tz;
+
+        gradX = (w00 * row0[0].GradX + w10 * row0[1].GradX + w01 * row1[0].GradX + w11 * row1[1].GradX) * GRADIENT_SCALE;
+        gradZ = (w00 * row0[0].GradZ + w10 * row0[1].GradZ + w01 * row1[0].GradZ + w11 * row1[1].GradZ) * GRADIENT_SCALE;
+        return w00 * row0[0].Distance + w10 * row0[1].Distance + w01 * row1[0].Distance + w11 * row1[1].Distance;
+    }
+
+    int GetColumns() const { return Columns; }
+    int GetRows() const { return Rows; }
+    float GetCellSize() const { return 1.0f / InvCellSize; }
+
+    /**
+     * Bytes of node data
+     */
+    size_t GetMemoryBytes() const { return Nodes.size() * sizeof(Node); }
+
+private:
+    // Gradient components are stored as 16-bit fractions of 1
+    static constexpr float GRADIENT_SCALE = 1.0f / 32767.0f;
+
+    struct Node
+    {
+        float Distance;
+        int16_t GradX;
+        int16_t GradZ;
+    };
+
+    std::vector<Node> Nodes;
+    float OriginX;
+    float OriginZ;
+    float InvCellSize;
+    int Columns;
+    int Rows;
+
+    // Largest sample coordinates (just inside the last cell, so the +1 neighbours exist)
+    float MaxCoordX;
+    float MaxCoordZ;
+
+    /**
+     * Set the grid layout (allocates the nodes)
+     */
+    void SetLayout(float originX, float originZ, float cellSize, int columns, int rows);
+};
+
+#endif // DISTANCE_FIELD_H
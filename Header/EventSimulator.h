@@ -0,0 +1,182 @@
+#ifndef EVENT_SIMULATOR_H
+#define EVENT_SIMULATOR_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include <queue>
+#include <vector>
+
+/**
+ * Event Simulator
+ * ---------------
+ * Event-driven alternative to stepping Physics::Update at a fixed deltaTime.
+ *
+ * Between events every ball rolls along a straight line under the same
+ * friction model as Physics, solved in closed form (see RollingMotion).
+ * The simulator computes the time of each ball's next event:
+ * - ball-ball contact
+ * - cushion contact (or leaving a pocket gap beyond a rail)
+ * - falling into a pocket
+ * - coming to rest
+ * keeps them in a priority queue and jumps straight from one to the next.
+ * A shot that takes thousands of fixed steps is simulated in tens of events.
+ *
+ * Events are invalidated lazily: each ball has a counter that is bumped
+ * whenever its motion changes, and queued events that recorded an older
+ * counter are discarded when they reach the top of the queue.
+ *
+ * Collision responses match Physics (equal-mass impulse with
+ * BALL_RESTITUTION, cushion reflection with CUSHION_RESTITUTION,
+ * MAX_VELOCITY clamp, MIN_VELOCITY rest threshold).
+ *
+ * Cushions are always the four rails of CushionBackend::Rails; tables
+ * using segment cushions need Physics.
+ */
+class EventSimulator
+{
+public:
+    /**
+     * Constructor
+     */
+    EventSimulator();
+
+    /**
+     * Start a simulation from the current contents of a store (time 0)
+     * @param balls Ball state store (velocities from e.g. Physics::ApplyImpulse)
+     * @param table Table whose cushions and pockets are used until the next Reset
+     */
+    void Reset(const BallStore& balls, const TableGeometry& table);
+
+    /**
+     * Process every event up to a time and write the state at that time
+     * @param balls Store passed to Reset; receives positions, velocities and potted balls
+     * @param duration Seconds to advance
+     */
+    void Advance(BallStore& balls, float duration);
+
+    /**
+     * Process events until every ball is at rest
+     * @param balls Store passed to Reset; receives the resting state
+     * @param maxEvents Safety limit on the number of events processed
+     * @return Number of events processed
+     */
+    int RunToRest(BallStore& balls, int maxEvents = 100000);
+
+    /**
+     * Check if all balls have stopped moving (same result as Physics::AllBallsStopped)
+     */
+    bool AllBallsStopped(const BallStore& balls) const;
+
+    /**
+     * Simulated time since Reset, in seconds
+     */
+    double GetTime() const;
+
+    /**
+     * Number of events processed since Reset (stale queue entries are not counted)
+     */
+    int GetEventCount() const;
+
+private:
+    enum class EventType
+    {
+        BallContact,   // Two balls touch
+        PairRecheck,   // Contact search gave up; search again from this time
+        Cushion,       // Ball reaches a rail (or leaves a pocket gap beyond one)
+        Pocket,        // Ball center enters a pocket
+        Rest           // Ball speed falls to MIN_VELOCITY
+    };
+
+    struct Event
+    {
+        double Time;
+        EventType Type;
+        int A;
+        int B;
+        int StampA;
+        int StampB;
+
+        // Ordered so that std::priority_queue pops the earliest event
+        bool operator<(const Event& other) const { return Time > other.Time; }
+    };
+
+    /**
+     * Motion of one ball since its last event
+     */
+    struct Motion
+    {
+        double StartTime;
+        double StartX, StartZ;
+        double DirX, DirZ;   // Unit direction of travel
+        double Speed;        // Speed at StartTime (0 when resting)
+        double StopTime;     // Time the ball comes to rest
+        double Radius;
+        bool Active;
+        int Number;
+        int Stamp;           // Bumped whenever the motion changes
+    };
+
+    /**
+     * Position and velocity of a ball at a time at or after its StartTime
+     */
+    void PositionAt(int i, double t, double& x, double& z) const;
+    void VelocityAt(int i, double t, double& vx, double& vz) const;
+
+    /**
+     * Restart a ball's motion at the current time from a position and velocity
+     * Applies the MAX_VELOCITY clamp and MIN_VELOCITY rest threshold
+     */
+    void SetMotion(int i, double x, double z, double vx, double vz);
+
+    /**
+     * Queue the next cushion, pocket and rest events of a ball
+     */
+    void ScheduleBallEvents(int i);
+
+    /**
+     * Queue all next events of a ball, including contacts with every other ball
+     * @param skip Ball whose contact with i is already queued (-1 for none)
+     */
+    void ScheduleBall(int i, int skip);
+
+    /**
+     * Queue the next contact between two balls, if any
+     */
+    void SchedulePair(int a, int b, double fromTime);
+
+    /**
+     * Earliest time at or after fromTime at which two balls touch while approaching
+     * @param contact Set to true for a contact, false if the search gave up at the returned time
+     * @return Time found, or a negative value if the balls never touch
+     */
+    double FindContactTime(int a, int b, double fromTime, bool& contact) const;
+
+    void HandleBallContact(int a, int b);
+    void HandleCushion(int i);
+    void HandlePocket(int i);
+
+    /**
+     * Check if a position is inside the cushion gap of any pocket
+     * @param pocket Set to the pocket index when it is
+     */
+    bool IsInPocketGap(double x, double z, int& pocket) const;
+
+    /**
+     * Pop and process the next valid event, if it happens no later than endTime
+     * @return true if an event was processed
+     */
+    bool ProcessNextEvent(double endTime);
+
+    /**
+     * Write positions and velocities at the current time into a store
+     */
+    void WriteState(BallStore& balls) const;
+
+    const TableGeometry* TablePtr;
+    std::vector<Motion> Balls;
+    std::priority_queue<Event> Queue;
+    double Now;
+    int EventCount;
+};
+
+#endif // EVENT_SIMULATOR_H
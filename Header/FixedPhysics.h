@@ -0,0 +1,624 @@
+#ifndef FIXED_PHYSICS_H
+#define FIXED_PHYSICS_H
+
+#include "BallStore.h"
+#include "DeterministicMath.h"
+#include "Physics.h"
+#include "TableGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Pool: the constants of the dynamic Physics
+ */
+struct PoolRules
+{
+    static constexpr float ROLLING_FRICTION = PhysicsConstants::ROLLING_FRICTION;
+    static constexpr float LINEAR_DECELERATION = PhysicsConstants::LINEAR_DECELERATION;
+    static constexpr float MIN_VELOCITY = PhysicsConstants::MIN_VELOCITY;
+    static constexpr float BALL_RESTITUTION = PhysicsConstants::BALL_RESTITUTION;
+    static constexpr float CUSHION_RESTITUTION = PhysicsConstants::CUSHION_RESTITUTION;
+    static constexpr float MAX_VELOCITY = PhysicsConstants::MAX_VELOCITY;
+    static const int COLLISION_ITERATIONS = PhysicsConstants::COLLISION_ITERATIONS;
+    static const bool HAS_POCKETS = true;
+};
+
+/**
+ * Snooker: finer, faster cloth and slightly livelier balls and cushions
+ */
+struct SnookerRules
+{
+    static constexpr float ROLLING_FRICTION = 0.45f;
+    static constexpr float LINEAR_DECELERATION = 0.4f;
+    static constexpr float MIN_VELOCITY = 0.01f;
+    static constexpr float BALL_RESTITUTION = 0.94f;
+    static constexpr float CUSHION_RESTITUTION = 0.75f;
+    static constexpr float MAX_VELOCITY = 10.0f;
+    static const int COLLISION_ITERATIONS = 3;
+    static const bool HAS_POCKETS = true;
+};
+
+/**
+ * Carom: heavier cloth, lively cushions and no pockets
+ * (balls bounce off the rails everywhere, pocket gaps included)
+ */
+struct CaromRules
+{
+    static constexpr float ROLLING_FRICTION = 0.3f;
+    static constexpr float LINEAR_DECELERATION = 0.6f;
+    static constexpr float MIN_VELOCITY = 0.01f;
+    static constexpr float BALL_RESTITUTION = 0.93f;
+    static constexpr float CUSHION_RESTITUTION = 0.85f;
+    static constexpr float MAX_VELOCITY = 10.0f;
+    static const int COLLISION_ITERATIONS = 3;
+    static const bool HAS_POCKETS = false;
+};
+
+/**
+ * Float: the store's floats are stepped in place with float arithmetic
+ * (the same operations as the dynamic Physics)
+ */
+struct FloatPrecision
+{
+    typedef float Storage;
+    typedef float Accum;
+};
+
+/**
+ * Double: positions and velocities are kept and stepped in double, and
+ * rounded into the store after every step
+ */
+struct DoublePrecision
+{
+    typedef double Storage;
+    typedef double Accum;
+};
+
+/**
+ * Mixed: the store's floats are stepped in place, with each step's
+ * arithmetic done in double
+ */
+struct MixedPrecision
+{
+    typedef float Storage;
+    typedef double Accum;
+};
+
+/**
+ * Fixed Physics
+ * -------------
+ * Physics step specialised at compile time for a ball count N and a rule
+ * set (PoolRules, SnookerRules, CaromRules or any struct with the same
+ * members).
+ *
+ * The rule constants fold into the code, and each awake ball is tested
+ * against exactly N balls in a loop the compiler unrolls (and vectorizes
+ * when the caller's build targets SSE4/AVX). Active and awake balls are
+ * bit masks, and overlapping pairs are recorded as one bit row per ball,
+ * which yields them in (A, B) order without sorting. Per-ball passes walk
+ * the store's awake list like Physics.
+ *
+ * The step is the dynamic Physics reference path (StepMode::MultiPass,
+ * adaptive iterations, all-pairs contacts) with the same operations: with
+ * PoolRules and FloatPrecision it gives bit-identical states to Physics
+ * with continuous collision disabled on a CushionBackend::Rails table.
+ * Fast balls are not swept, cushions are always the four rails, and no
+ * events or stats are recorded; Physics remains the general path for
+ * everything else.
+ *
+ * The Precision policy (FloatPrecision, DoublePrecision or MixedPrecision)
+ * picks the type positions and velocities are kept in between steps and
+ * the type each step computes in. With double storage the state lives in
+ * this object and the store receives a rounded copy; store entries changed
+ * outside the step (a new shot, a respawn) are picked up on the next step.
+ *
+ * The store must hold exactly N balls: Update and RunToRest leave any
+ * other store unchanged and report it through their return values.
+ */
+template <int N, class Rules = PoolRules, class Precision = FloatPrecision>
+class FixedPhysics
+{
+    static_assert(N >= 2 && N <= 32, "FixedPhysics keeps one bit per ball in 32-bit masks");
+
+public:
+    static const int BALL_COUNT = N;
+
+    typedef typename Precision::Storage Storage;
+    typedef typename Precision::Accum Accum;
+
+    /**
+     * Constructor
+     */
+    FixedPhysics();
+
+    /**
+     * Update physics for all balls
+     * @param balls Ball state store holding N balls
+     * @param table Reference to the table
+     * @param deltaTime Time step in seconds
+     * @return false (and nothing is stepped) if the store does not hold N balls
+     */
+    bool Update(BallStore& balls, const TableGeometry& table, float deltaTime);
+
+    /**
+     * Step with a fixed time step until all balls have stopped
+     * @return Number of steps taken (-1 if the store does not hold N balls)
+     */
+    int RunToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps);
+
+    /**
+     * Check if all balls have stopped moving
+     */
+    bool AllBallsStopped(const BallStore& balls) const;
+
+private:
+    /**
+     * Positions and velocities stepped by Update
+     * (the store's arrays, or the double state of this object)
+     */
+    struct State
+    {
+        Storage* PosX;
+        Storage* PosZ;
+        Storage* VelX;
+        Storage* VelZ;
+    };
+
+    /**
+     * Detect and resolve ball-ball collisions
+     * @param active Bit i set for each active ball (no ball is potted during the passes)
+     * @return Deepest overlap resolved (0 if no balls overlapped)
+     */
+    static Accum ResolveBallCollisions(BallStore& balls, const State& state, uint32_t active);
+
+    /**
+     * Resolve one ball-ball contact (equal-mass impulse with BALL_RESTITUTION)
+     */
+    static void ResolveBallCollision(const BallStore& balls, const State& state, int a, int b);
+
+    /**
+     * Detect and resolve ball-rail collisions
+     * @return Deepest penetration resolved
+     */
+    static Accum ResolveCushionCollisions(const BallStore& balls, const State& state, const TableGeometry& table);
+
+    /**
+     * Pot balls whose center entered a pocket (the cue ball is respawned)
+     */
+    static void CheckPockets(BallStore& balls, const State& state, const TableGeometry& table);
+
+    /**
+     * Field of the state to step: float storage steps the store's array,
+     * double storage reloads the entries whose rounding no longer matches
+     * the store (they were changed outside the step)
+     */
+    static float* Load(float* store, float* state);
+    static double* Load(const float* store, double* state);
+
+    /**
+     * Write a stepped field back to the store (rounding double storage)
+     */
+    static void Save(float* store, const float* state);
+    static void Save(float* store, const double* state);
+
+    static float Power(float base, float exponent);
+    static double Power(double base, double exponent);
+
+    // Double storage state (unused with float storage)
+    Storage StatePosX[N];
+    Storage StatePosZ[N];
+    Storage StateVelX[N];
+    Storage StateVelZ[N];
+};
+
+// Preset configurations: a pool rack with the cue ball, a full snooker set, three carom balls
+typedef FixedPhysics<16, PoolRules> PoolPhysics;
+typedef FixedPhysics<22, SnookerRules> SnookerPhysics;
+typedef FixedPhysics<3, CaromRules> CaromPhysics;
+
+template <int N, class Rules, class Precision>
+FixedPhysics<N, Rules, Precision>::FixedPhysics()
+{
+    // Never equal to a store value, so the first step loads everything
+    const Storage unset = std::numeric_limits<Storage>::quiet_NaN();
+    for (int i = 0; i < N; i++)
+    {
+        StatePosX[i] = unset;
+        StatePosZ[i] = unset;
+        StateVelX[i] = unset;
+        StateVelZ[i] = unset;
+    }
+}
+
+template <int N, class Rules, class Precision>
+bool FixedPhysics<N, Rules, Precision>::Update(BallStore& balls, const TableGeometry& table, float deltaTime)
+{
+    if (balls.Size() != N)
+        return false;
+
+    State state;
+    state.PosX = Load(balls.PosX, StatePosX);
+    state.PosZ = Load(balls.PosZ, StatePosZ);
+    state.VelX = Load(balls.VelX, StateVelX);
+    state.VelZ = Load(balls.VelZ, StateVelZ);
+
+    Storage* posX = state.PosX;
+    Storage* posZ = state.PosZ;
+    Storage* velX = state.VelX;
+    Storage* velZ = state.VelZ;
+
+    Accum dt = deltaTime;
+    Accum frictionFactor = Power((Accum)Rules::ROLLING_FRICTION, dt);
+    Accum reduction = (Accum)Rules::LINEAR_DECELERATION * dt;
+
+    // Sleeping balls are not moving: the per-ball passes walk the awake list
+    const int* awake = balls.GetAwakeBalls();
+
+    // Friction, then integration
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
+    {
+        int i = awake[k];
+        Accum vx = velX[i] * frictionFactor;
+        Accum vz = velZ[i] * frictionFactor;
+        Accum speed = std::sqrt(vx * vx + vz * vz);
+        if (speed > 0.0001f)
+        {
+            Accum newSpeed = speed - reduction;
+            if (newSpeed < 0.0f) newSpeed = 0.0f;
+            Accum scale = newSpeed / speed;
+            vx = vx * scale;
+            vz = vz * scale;
+        }
+        velX[i] = (Storage)vx;
+        velZ[i] = (Storage)vz;
+        posX[i] = (Storage)(posX[i] + vx * dt);
+        posZ[i] = (Storage)(posZ[i] + vz * dt);
+    }
+
+    uint32_t active = 0;
+    for (int i = 0; i < N; i++)
+        active |= (balls.Active[i] & 1u) << i;
+
+    // Collision passes until one finds nothing to resolve
+    for (int iteration = 0; iteration < Rules::COLLISION_ITERATIONS; iteration++)
+    {
+        Accum ballDepth = ResolveBallCollisions(balls, state, active);
+        Accum cushionDepth = ResolveCushionCollisions(balls, state, table);
+        if (ballDepth == 0.0f && cushionDepth == 0.0f)
+            break;
+    }
+
+    if (Rules::HAS_POCKETS)
+        CheckPockets(balls, state, table);
+
+    // Clamp velocities and stop slow balls
+    const Accum maxVelocity = Rules::MAX_VELOCITY;
+    const Accum minSq = (Accum)Rules::MIN_VELOCITY * (Accum)Rules::MIN_VELOCITY;
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
+    {
+        int i = awake[k];
+        Accum vx = velX[i];
+        Accum vz = velZ[i];
+        Accum speed = std::sqrt(vx * vx + vz * vz);
+        if (speed > maxVelocity)
+        {
+            vx = vx / speed * maxVelocity;
+            vz = vz / speed * maxVelocity;
+        }
+        if (vx * vx + vz * vz < minSq)
+        {
+            vx = 0.0f;
+            vz = 0.0f;
+        }
+        velX[i] = (Storage)vx;
+        velZ[i] = (Storage)vz;
+    }
+
+    Save(balls.PosX, posX);
+    Save(balls.PosZ, posZ);
+    Save(balls.VelX, velX);
+    Save(balls.VelZ, velZ);
+
+    balls.SleepSlowBalls(Rules::MIN_VELOCITY);
+    return true;
+}
+
+template <int N, class Rules, class Precision>
+int FixedPhysics<N, Rules, Precision>::RunToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps)
+{
+    if (balls.Size() != N)
+        return -1;
+
+    int steps = 0;
+    while (steps < maxSteps && !AllBallsStopped(balls))
+    {
+        Update(balls, table, deltaTime);
+        steps++;
+    }
+    return steps;
+}
+
+template <int N, class Rules, class Precision>
+bool FixedPhysics<N, Rules, Precision>::AllBallsStopped(const BallStore& balls) const
+{
+    const int* awake = balls.GetAwakeBalls();
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
+    {
+        int i = awake[k];
+        if (balls.IsActive(i) && balls.IsMoving(i))
+            return false;
+    }
+    return true;
+}
+
+template <int N, class Rules, class Precision>
+typename Precision::Accum FixedPhysics<N, Rules, Precision>::ResolveBallCollisions(BallStore& balls, const State& state, uint32_t active)
+{
+    const Storage* posX = state.PosX;
+    const Storage* posZ = state.PosZ;
+    const float* radius = balls.Radius;
+
+    // Pairs of active balls with at least one awake, as in Physics
+    const int* awakeBalls = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    uint32_t awake = 0;
+    for (int k = 0; k < numAwake; k++)
+        awake |= 1u << awakeBalls[k];
+    awake &= active;
+    if (awake == 0)
+        return 0.0f;
+
+    // Gather the touching pairs first: each awake ball against all N balls,
+    // recorded as bit b of rows[a] for pair (a, b), a < b
+    uint32_t rows[N] = {};
+    bool any = false;
+    // (walks the awake mask rather than the list: rows are the same in any order)
+    for (uint32_t remaining = awake; remaining != 0; remaining &= remaining - 1)
+    {
+        int i = 0;
+        while (!((remaining >> i) & 1u))
+            i++;
+
+        uint32_t hits = 0;
+        for (int j = 0; j < N; j++)
+        {
+            Accum dx = (Accum)posX[j] - posX[i];
+            Accum dz = (Accum)posZ[j] - posZ[i];
+            Accum minDist = (Accum)radius[i] + radius[j];
+            hits |= (uint32_t)(dx * dx + dz * dz < minDist * minDist) << j;
+        }
+
+        // Not itself, and awake-awake pairs only from the lower index
+        hits &= active & ~(1u << i) & ~(awake & ((1u << i) - 1u));
+        if (hits == 0)
+            continue;
+
+        any = true;
+        for (int j = 0; j < N; j++)
+        {
+            if ((hits >> j) & 1u)
+            {
+                if (j > i)
+                    rows[i] |= 1u << j;
+                else
+                    rows[j] |= 1u << i;
+            }
+        }
+    }
+    if (!any)
+        return 0.0f;
+
+    // Resolve in (A, B) order; earlier resolutions may have separated a pair
+    Accum deepest = 0.0f;
+    for (int a = 0; a < N; a++)
+    {
+        for (uint32_t row = rows[a]; row != 0; row &= row - 1)
+        {
+            int b = 0;
+            while (!((row >> b) & 1u))
+                b++;
+
+            Accum dx = (Accum)posX[b] - posX[a];
+            Accum dz = (Accum)posZ[b] - posZ[a];
+            Accum minDist = (Accum)radius[a] + radius[b];
+            if (!(dx * dx + dz * dz < minDist * minDist))
+                continue;
+
+            Accum overlap = minDist - std::sqrt(dx * dx + dz * dz);
+            if (overlap > deepest)
+                deepest = overlap;
+
+            balls.Wake(a);
+            balls.Wake(b);
+            ResolveBallCollision(balls, state, a, b);
+        }
+    }
+    return deepest;
+}
+
+template <int N, class Rules, class Precision>
+void FixedPhysics<N, Rules, Precision>::ResolveBallCollision(const BallStore& balls, const State& state, int a, int b)
+{
+    Storage* posX = state.PosX;
+    Storage* posZ = state.PosZ;
+    Storage* velX = state.VelX;
+    Storage* velZ = state.VelZ;
+
+    Accum dx = (Accum)posX[b] - posX[a];
+    Accum dz = (Accum)posZ[b] - posZ[a];
+    Accum dist = std::sqrt(dx * dx + dz * dz);
+
+    if (dist < 0.0001f)
+    {
+        // Balls are at same position, push apart
+        dx = 1.0f;
+        dz = 0.0f;
+        dist = 0.0001f;
+    }
+
+    // Separate the balls along the normal from a to b
+    Accum nx = dx / dist;
+    Accum nz = dz / dist;
+    Accum push = (((Accum)balls.Radius[a] + balls.Radius[b]) - dist) / 2.0f;
+    posX[a] = (Storage)(posX[a] - nx * push);
+    posZ[a] = (Storage)(posZ[a] - nz * push);
+    posX[b] = (Storage)(posX[b] + nx * push);
+    posZ[b] = (Storage)(posZ[b] + nz * push);
+
+    // Equal-mass impulse, only while approaching
+    Accum velAlongNormal = ((Accum)velX[a] - velX[b]) * nx + ((Accum)velZ[a] - velZ[b]) * nz;
+    if (velAlongNormal < 0)
+        return;
+
+    Accum j = -((Accum)1.0f + Rules::BALL_RESTITUTION) * velAlongNormal / 2.0f;
+    velX[a] = (Storage)(velX[a] + nx * j);
+    velZ[a] = (Storage)(velZ[a] + nz * j);
+    velX[b] = (Storage)(velX[b] - nx * j);
+    velZ[b] = (Storage)(velZ[b] - nz * j);
+}
+
+template <int N, class Rules, class Precision>
+typename Precision::Accum FixedPhysics<N, Rules, Precision>::ResolveCushionCollisions(const BallStore& balls, const State& state, const TableGeometry& table)
+{
+    Accum minX = table.GetMinX();
+    Accum maxX = table.GetMaxX();
+    Accum minZ = table.GetMinZ();
+    Accum maxZ = table.GetMaxZ();
+    float railBand = table.GetRailBandWidth();
+    const Accum e = Rules::CUSHION_RESTITUTION;
+
+    Storage* posX = state.PosX;
+    Storage* posZ = state.PosZ;
+    Storage* velX = state.VelX;
+    Storage* velZ = state.VelZ;
+
+    const int* awake = balls.GetAwakeBalls();
+    Accum deepest = 0.0f;
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
+    {
+        int i = awake[k];
+        if (!balls.IsActive(i))
+            continue;
+
+        // Balls in open table cannot reach a rail this step
+        Accum r = balls.Radius[i];
+        uint8_t zone = table.GetZone((float)posX[i], (float)posZ[i]);
+        if (!(zone & TableGeometry::ZONE_RAIL) && balls.Radius[i] < railBand)
+            continue;
+
+        // Balls over a pocket gap roll on into the pocket
+        if (Rules::HAS_POCKETS && table.IsInPocketGap((float)posX[i], (float)posZ[i], zone))
+            continue;
+
+        if (posX[i] - r < minX)
+        {
+            deepest = std::max(deepest, minX - (posX[i] - r));
+            posX[i] = (Storage)(minX + r);
+            if (velX[i] < 0)
+                velX[i] = (Storage)(-velX[i] * e);
+        }
+        if (posX[i] + r > maxX)
+        {
+            deepest = std::max(deepest, posX[i] + r - maxX);
+            posX[i] = (Storage)(maxX - r);
+            if (velX[i] > 0)
+                velX[i] = (Storage)(-velX[i] * e);
+        }
+        if (posZ[i] - r < minZ)
+        {
+            deepest = std::max(deepest, minZ - (posZ[i] - r));
+            posZ[i] = (Storage)(minZ + r);
+            if (velZ[i] < 0)
+                velZ[i] = (Storage)(-velZ[i] * e);
+        }
+        if (posZ[i] + r > maxZ)
+        {
+            deepest = std::max(deepest, posZ[i] + r - maxZ);
+            posZ[i] = (Storage)(maxZ - r);
+            if (velZ[i] > 0)
+                velZ[i] = (Storage)(-velZ[i] * e);
+        }
+    }
+    return deepest;
+}
+
+template <int N, class Rules, class Precision>
+void FixedPhysics<N, Rules, Precision>::CheckPockets(BallStore& balls, const State& state, const TableGeometry& table)
+{
+    const int* awake = balls.GetAwakeBalls();
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
+    {
+        int i = awake[k];
+        if (!balls.IsActive(i))
+            continue;
+
+        if (table.FindPocket((float)state.PosX[i], (float)state.PosZ[i]) < 0)
+            continue;
+
+        if (balls.Number[i] == 0)
+        {
+            // Cue ball: respawn at original position
+            state.PosX[i] = 0.0f;
+            state.PosZ[i] = 2.0f;
+        }
+        else
+        {
+            balls.SetActive(i, false);
+        }
+        state.VelX[i] = 0.0f;
+        state.VelZ[i] = 0.0f;
+    }
+}
+
+template <int N, class Rules, class Precision>
+float* FixedPhysics<N, Rules, Precision>::Load(float* store, float*)
+{
+    return store;
+}
+
+template <int N, class Rules, class Precision>
+double* FixedPhysics<N, Rules, Precision>::Load(const float* store, double* state)
+{
+    for (int i = 0; i < N; i++)
+    {
+        if (!((float)state[i] == store[i]))
+            state[i] = store[i];
+    }
+    return state;
+}
+
+template <int N, class Rules, class Precision>
+void FixedPhysics<N, Rules, Precision>::Save(float*, const float*)
+{
+}
+
+template <int N, class Rules, class Precision>
+void FixedPhysics<N, Rules, Precision>::Save(float* store, const double* state)
+{
+    for (int i = 0; i < N; i++)
+        store[i] = (float)state[i];
+}
+
+template <int N, class Rules, class Precision>
+float FixedPhysics<N, Rules, Precision>::Power(float base, float exponent)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return DeterministicMath::Pow(base, exponent);
+#else
+    return powf(base, exponent);
+#endif
+}
+
+template <int N, class Rules, class Precision>
+double FixedPhysics<N, Rules, Precision>::Power(double base, double exponent)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return DeterministicMath::Exp(exponent * DeterministicMath::Log(base));
+#else
+    return std::pow(base, exponent);
+#endif
+}
+
+#endif // FIXED_PHYSICS_H
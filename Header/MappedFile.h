@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+/**
+ * Mapped File
+ * -----------
+ * Read-only memory mapping of a whole file (mmap on POSIX,
+ * CreateFileMapping on Windows). Pages are loaded by the OS on first
+ * touch, so opening a large file costs nothing until it is read.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file (closes any file already mapped)
+     * @return false if the file cannot be opened or mapped
+     */
+    bool Open(const char* path);
+
+    /**
+     * Unmap the file
+     */
+    void Close();
+
+    bool IsOpen() const { return Data != nullptr; }
+    const unsigned char* GetData() const { return Data; }
+    size_t GetSize() const { return Size; }
+
+private:
+    const unsigned char* Data;
+    size_t Size;
+
+    // Platform handles (file descriptor on POSIX; file and mapping handles on Windows)
+    void* FileHandle;
+    void* MappingHandle;
+    int Descriptor;
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,157 @@
+#ifndef MATH_UTIL_H
+#define MATH_UTIL_H
+
+#include <cmath>
+
+// ============================================================================
+// MATH TYPES - Simple GLM-style vector and matrix types
+// ============================================================================
+
+/**
+ * 3D Vector
+ * Templated on the scalar type: Vec3 (float) is what the game and the
+ * BallStore use, Vec3d (double) serves the double precision policies
+ */
+template <class T>
+struct TVec3
+{
+    T x, y, z;
+
+    TVec3() : x(0), y(0), z(0) {}
+    TVec3(T x, T y, T z) : x(x), y(y), z(z) {}
+
+    // Conversion between precisions (rounds when narrowing)
+    template <class U>
+    explicit TVec3(const TVec3<U>& v) : x((T)v.x), y((T)v.y), z((T)v.z) {}
+
+    // Pointer to data (for OpenGL uniforms)
+    const T* Ptr() const { return &x; }
+
+    // Basic operations
+    TVec3 operator+(const TVec3& v) const { return TVec3(x + v.x, y + v.y, z + v.z); }
+    TVec3 operator-(const TVec3& v) const { return TVec3(x - v.x, y - v.y, z - v.z); }
+    TVec3 operator*(T s) const { return TVec3(x * s, y * s, z * s); }
+    TVec3 operator/(T s) const { return TVec3(x / s, y / s, z / s); }
+
+    TVec3& operator+=(const TVec3& v) { x += v.x; y += v.y; z += v.z; return *this; }
+    TVec3& operator-=(const TVec3& v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
+    TVec3& operator*=(T s) { x *= s; y *= s; z *= s; return *this; }
+
+    T Length() const { return std::sqrt(x * x + y * y + z * z); }
+    T LengthSquared() const { return x * x + y * y + z * z; }
+
+    TVec3 Normalized() const
+    {
+        T len = Length();
+        if (len > (T)0.0001f)
+            return *this / len;
+        return TVec3(0, 0, 0);
+    }
+
+    void Normalize()
+    {
+        T len = Length();
+        if (len > (T)0.0001f)
+        {
+            x /= len;
+            y /= len;
+            z /= len;
+        }
+    }
+};
+
+typedef TVec3<float> Vec3;
+typedef TVec3<double> Vec3d;
+
+// Vector operations
+template <class T>
+inline T Dot(const TVec3<T>& a, const TVec3<T>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <class T>
+inline TVec3<T> Cross(const TVec3<T>& a, const TVec3<T>& b)
+{
+    return TVec3<T>(
+        a.y * b.z - a.z * b.y,
+        a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x
+    );
+}
+
+template <class T>
+inline TVec3<T> operator*(T s, const TVec3<T>& v)
+{
+    return TVec3<T>(s * v.x, s * v.y, s * v.z);
+}
+
+/**
+ * 4x4 Matrix (column-major order for OpenGL)
+ * Mat4 (float) and Mat4d (double); the members are instantiated for both
+ * in MathUtil.cpp
+ */
+template <class T>
+struct TMat4
+{
+    T m[16];
+
+    TMat4()
+    {
+        // Initialize to identity
+        for (int i = 0; i < 16; i++) m[i] = 0;
+        m[0] = m[5] = m[10] = m[15] = 1;
+    }
+
+    // Pointer to data (for OpenGL uniforms)
+    const T* Ptr() const { return m; }
+
+    // Access element at [row][col]
+    T& At(int row, int col) { return m[col * 4 + row]; }
+    T At(int row, int col) const { return m[col * 4 + row]; }
+
+    // Matrix multiplication
+    TMat4 operator*(const TMat4& other) const;
+
+    // Static constructors
+    static TMat4 Identity();
+    static TMat4 Translate(T x, T y, T z);
+    static TMat4 Translate(const TVec3<T>& v);
+    static TMat4 Scale(T x, T y, T z);
+    static TMat4 Scale(T s);
+    static TMat4 RotateX(T radians);
+    static TMat4 RotateY(T radians);
+    static TMat4 RotateZ(T radians);
+    static TMat4 Perspective(T fovY, T aspect, T nearPlane, T farPlane);
+    static TMat4 Ortho(T left, T right, T bottom, T top, T nearPlane, T farPlane);
+    static TMat4 LookAt(const TVec3<T>& eye, const TVec3<T>& target, const TVec3<T>& up);
+
+    TMat4 Inverse() const;
+};
+
+typedef TMat4<float> Mat4;
+typedef TMat4<double> Mat4d;
+
+extern template struct TMat4<float>;
+extern template struct TMat4<double>;
+
+// ============================================================================
+// UTILITY CONSTANTS
+// ============================================================================
+
+const float PI = 3.14159265358979323846f;
+const float DEG_TO_RAD = PI / 180.0f;
+const float RAD_TO_DEG = 180.0f / PI;
+
+inline float Radians(float degrees) { return degrees * DEG_TO_RAD; }
+inline float Degrees(float radians) { return radians * RAD_TO_DEG; }
+
+// Clamp value between min and max
+inline float Clamp(float value, float minVal, float maxVal)
+{
+    if (value < minVal) return minVal;
+    if (value > maxVal) return maxVal;
+    return value;
+}
+
+#endif // MATH_UTIL_H
@@ -1,43 +1,151 @@
 #ifndef PHYSICS_H
 #define PHYSICS_H
 
-#include "Ball.h"
-#include "Table.h"
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include "SpatialGrid.h"
+#include "SweepAndPrune.h"
+#include "PhysicsKernels.h"
+#include "PhysicsEvent.h"
+#include "PhysicsStats.h"
 #include <vector>
 
 /**
  * Physics Constants
+ * (constexpr, so rule policies such as PoolRules can copy them at compile time)
  */
 namespace PhysicsConstants
 {
     // Friction coefficient for rolling on felt
     // Value represents fraction of velocity retained per second (lower = more friction)
-    const float ROLLING_FRICTION = 0.35f;
+    constexpr float ROLLING_FRICTION = 0.35f;
 
     // Linear deceleration (units/sec^2) to help balls stop cleanly at low speed
-    const float LINEAR_DECELERATION = 0.5f;
+    constexpr float LINEAR_DECELERATION = 0.5f;
 
     // Minimum velocity before ball stops completely
-    const float MIN_VELOCITY = 0.01f;
+    constexpr float MIN_VELOCITY = 0.01f;
 
     // Coefficient of restitution (bounciness) for ball-ball collisions
-    const float BALL_RESTITUTION = 0.92f;
+    constexpr float BALL_RESTITUTION = 0.92f;
 
     // Coefficient of restitution for ball-cushion collisions
-    const float CUSHION_RESTITUTION = 0.7f;
+    constexpr float CUSHION_RESTITUTION = 0.7f;
 
     // Maximum velocity (speed limit)
-    const float MAX_VELOCITY = 10.0f;
+    constexpr float MAX_VELOCITY = 10.0f;
+
+    // Fraction of its radius a ball may move in one step before it is swept
+    // (slower balls cannot skip past anything the overlap tests would catch)
+    constexpr float SWEEP_THRESHOLD = 1.0f;
+
+    // Active ball count above which Broadphase::Auto may use the grid
+    // (below it sweep and prune is cheaper than building the grid)
+    const int GRID_BROADPHASE_THRESHOLD = 48;
+
+    // Broadphase::Auto uses the grid only when awake^2 > GRID_AWAKE_FACTOR x active:
+    // sweep and prune scans about sqrt(active) neighbours along Z per awake ball,
+    // while the grid rebuilds every cell, so few awake balls favour the sweep
+    const int GRID_AWAKE_FACTOR = 16;
+
+    // Awake x active pair count up to which Broadphase::Auto tests all pairs
+    // with scalar code (with SIMD kernels it does so on any table of up to
+    // PhysicsKernels::MAX_OVERLAP_BALLS balls)
+    const int ALL_PAIRS_MAX_TESTS = 64;
+
+    // Collision passes per step in IterationMode::Fixed, and the default
+    // cap in IterationMode::Adaptive
+    const int COLLISION_ITERATIONS = 3;
+
+    // Steps between two fast-forward attempts in RunToRest (each attempt
+    // tests every moving ball's path against every ball)
+    const int FAST_FORWARD_INTERVAL = 16;
+
+    // Fraction of the contact distance a fast-forward path must stay beyond
+    // other balls (covers float round-off in the steps it replaces)
+    constexpr float FAST_FORWARD_MARGIN = 0.01f;
 }
 
+/**
+ * How the per-ball passes of a step are scheduled
+ */
+enum class StepMode
+{
+    // Separate sweeps: friction, integrate, collisions, pockets, clamp, stop
+    MultiPass,
+
+    // One fused sweep (clamp, rest test, friction, integrate), then collisions and pockets.
+    // Clamp/stop of a step's collision output happen at the start of the next step,
+    // so trajectories are identical to MultiPass
+    Fused
+};
+
+/**
+ * How ball pairs are found for the ball-ball contact tests
+ */
+enum class Broadphase
+{
+    // All pairs when only a few tests are needed (e.g. the cue ball alone
+    // on a racked table) or the table fits the SIMD overlap kernel, grid for
+    // many active and awake balls, sweep and prune otherwise
+    Auto,
+
+    // Every awake ball against every active ball (the reference); with SIMD
+    // kernels, tables of up to PhysicsKernels::MAX_OVERLAP_BALLS balls test
+    // a block of balls per instruction (PhysicsKernels::FindOverlaps), with
+    // Scalar every pair goes through CheckBallCollision
+    AllPairs,
+
+    // Uniform grid rebuilt every collision pass (SpatialGrid)
+    Grid,
+
+    // Sorted along Z; one query serves all collision passes of a step (SweepAndPrune)
+    SweepAndPrune
+};
+
+/**
+ * How many ball + cushion collision passes a step runs
+ */
+enum class IterationMode
+{
+    // Always COLLISION_ITERATIONS passes (the reference behavior)
+    Fixed,
+
+    // Stop after the first pass that finds no overlap, or at the iteration cap.
+    // A pass that finds nothing changes nothing, so with the default cap the
+    // results are identical to Fixed while quiet steps run a single pass;
+    // raising the cap lets heavy contact (a tight break) settle further
+    Adaptive
+};
+
 /**
  * Physics Engine
  * --------------
  * Handles all physics simulation:
  * - Ball movement integration
- * - Ball-ball collision detection and response
- * - Ball-cushion collision detection and response
- * - Rolling friction
+ * - Ball-ball collision detection and response (sweep-and-prune broadphase,
+ *   uniform grid for large ball counts)
+ * - Ball-cushion collision detection and response (axis-aligned rails,
+ *   cushion segments in a BVH, or a baked signed distance field)
+ * - Continuous (swept) collision detection for fast balls
+ * - Sleeping: balls at rest leave the store's awake list and cost nothing
+ *   until an awake ball hits them
+ * - Rolling friction, with an optional closed-form fast-forward to rest
+ *   once no further contact is possible
+ * - Optional event log (contacts, cushion hits, pots, scratches)
+ * - Step counters and phase timings (PhysicsStats)
+ *
+ * Works directly on the structure-of-arrays BallStore; every pass
+ * streams through the field arrays instead of dereferencing Ball objects.
+ * Friction, integration, clamping and stopping run as SIMD kernels
+ * (see PhysicsKernels) picked for the CPU at construction.
+ *
+ * Determinism: a build with BILLIARD_DETERMINISTIC defined (CMake option
+ * of the same name, which also disables FMA contraction) replaces the libm
+ * calls in the step with DeterministicMath, so the same inputs give
+ * bit-identical states on every compiler, optimization level and platform.
+ * sqrt and the basic arithmetic are correctly rounded by IEEE 754 and stay
+ * as they are. Compare states with BallStore::ComputeHash.
  *
  * No spin or angular momentum (simplified model)
  */
@@ -51,77 +159,290 @@ public:
 
     /**
      * Update physics for all balls
-     * @param balls Vector of ball pointers
+     * @param balls Ball state store
+     * @param table Reference to the table
+     * @param deltaTime Time step in seconds
+     */
+    void Update(BallStore& balls, const TableGeometry& table, float deltaTime);
+
+    /**
+     * Step with a fixed time step until all balls have stopped
+     * @param balls Ball state store
      * @param table Reference to the table
      * @param deltaTime Time step in seconds
+     * @param maxSteps Safety limit on the number of steps
+     * @return Number of steps taken (including steps skipped by the fast-forward)
+     */
+    int RunToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps);
+
+    /**
+     * Move every awake ball straight to where stepping would bring it to rest,
+     * if none of them can touch another ball, a cushion or a pocket on the way
+     * Each ball's stopping point is the closed-form sum of its friction steps
+     * (RollingMotion::SteppedDistance). Paths are tested as swept circles
+     * against each other and the resting balls, and against the table's zone
+     * grid, whatever the timing; any possible contact leaves the state alone.
+     * Resting positions match stepping up to float round-off in the steps
+     * @param balls Ball state store
+     * @param table Reference to the table
+     * @param deltaTime Time step the skipped steps would have used
+     * @param maxSteps Most steps that may be skipped
+     * @return Number of steps skipped (0 if the balls were left moving)
+     */
+    int FastForwardToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps);
+
+    /**
+     * Let RunToRest fast-forward once no contact is possible (off by default;
+     * the skipped steps record no events and are not in GetTotalStats().Steps)
      */
-    void Update(std::vector<Ball*>& balls, const Table& table, float deltaTime);
+    void SetFastForward(bool enabled);
+    bool GetFastForward() const;
 
     /**
      * Apply an impulse to a ball (e.g., cue strike)
-     * @param ball Ball to hit
+     * @param balls Ball state store
+     * @param ball Index of the ball to hit
      * @param direction Direction of impulse (will be normalized)
      * @param power Strength of impulse
      */
-    void ApplyImpulse(Ball* ball, const Vec3& direction, float power);
+    void ApplyImpulse(BallStore& balls, int ball, const Vec3& direction, float power);
 
     /**
      * Check if all balls have stopped moving
      */
-    bool AllBallsStopped(const std::vector<Ball*>& balls) const;
+    bool AllBallsStopped(const BallStore& balls) const;
+
+    /**
+     * Override the instruction set used by the per-ball kernels
+     * (e.g. force Scalar to compare against the reference path)
+     */
+    void SetInstructionSet(PhysicsKernels::InstructionSet set);
+    PhysicsKernels::InstructionSet GetInstructionSet() const;
+
+    /**
+     * Select multi-pass or fused scheduling of the per-ball passes
+     */
+    void SetStepMode(StepMode mode);
+    StepMode GetStepMode() const;
+
+    /**
+     * Select the ball-ball broadphase (Auto by default)
+     */
+    void SetBroadphase(Broadphase method);
+    Broadphase GetBroadphase() const;
+
+    /**
+     * Select fixed or adaptive collision iterations (adaptive by default)
+     */
+    void SetIterationMode(IterationMode mode);
+    IterationMode GetIterationMode() const;
+
+    /**
+     * Most collision passes per step in IterationMode::Adaptive
+     * (at least 1, COLLISION_ITERATIONS by default)
+     */
+    void SetMaxIterations(int maxIterations);
+    int GetMaxIterations() const;
+
+    /**
+     * Collision passes run by the last Update
+     */
+    int GetLastIterationCount() const;
+
+    /**
+     * Deepest overlap (ball-ball or ball-cushion) that the last collision
+     * pass of the last Update found and resolved; 0 when the passes converged.
+     * Resolving it can leave a smaller overlap elsewhere for the next step
+     */
+    float GetResidualPenetration() const;
+
+    /**
+     * Enable or disable continuous collision detection (enabled by default)
+     * When disabled, fast balls are still swept but only counted, which
+     * measures how many collisions the discrete tests miss
+     */
+    void SetContinuousCollision(bool enabled);
+    bool GetContinuousCollision() const;
+
+    /**
+     * Number of swept contacts (ball, cushion or pocket) since the last reset
+     * that the end-of-step overlap tests would not have caught
+     */
+    int GetMissedCollisionCount() const;
+    void ResetMissedCollisionCount();
+
+    /**
+     * Record events into a log (nullptr stops recording)
+     * Events are appended; their times count from this call
+     */
+    void SetEventLog(std::vector<PhysicsEvent>* log);
+
+    /**
+     * Counters of the last Update
+     */
+    const PhysicsStats& GetStepStats() const;
+
+    /**
+     * Counters summed over every Update since construction or ResetStats
+     */
+    const PhysicsStats& GetTotalStats() const;
+    void ResetStats();
+
+    /**
+     * Time the phases of one step in PhysicsStats::TIMING_INTERVAL (on by
+     * default); off keeps the counters but never reads the clock
+     */
+    void SetPhaseTiming(bool enabled);
+    bool GetPhaseTiming() const;
 
 private:
     /**
      * Apply friction to slow down balls
      */
-    void ApplyFriction(std::vector<Ball*>& balls, float deltaTime);
+    void ApplyFriction(BallStore& balls, float deltaTime);
 
     /**
      * Integrate ball positions based on velocities
      */
-    void IntegratePositions(std::vector<Ball*>& balls, float deltaTime);
+    void IntegratePositions(BallStore& balls, float deltaTime);
 
     /**
      * Detect and resolve ball-ball collisions
+     * Finds candidate pairs with the selected broadphase
+     * @return Deepest overlap resolved (0 if no balls overlapped)
      */
-    void ResolveBallCollisions(std::vector<Ball*>& balls);
+    float ResolveBallCollisions(BallStore& balls, const TableGeometry& table);
 
     /**
      * Detect and resolve ball-cushion collisions
+     * Uses the table's cushion backend (rails, or segments through the BVH)
+     * @return Deepest penetration resolved (0 if no ball was inside a cushion)
+     */
+    float ResolveCushionCollisions(BallStore& balls, const TableGeometry& table);
+
+    /**
+     * Ball-cushion collisions against the table's cushion segments
+     * Each ball is tested only against the BVH leaves its bounds overlap
+     * @return Deepest penetration resolved
      */
-    void ResolveCushionCollisions(std::vector<Ball*>& balls, const Table& table);
+    float ResolveSegmentCollisions(BallStore& balls, const TableGeometry& table);
+
+    /**
+     * Ball-cushion collisions against the table's distance field
+     * (one bilinear sample per ball)
+     * @return Deepest penetration resolved
+     */
+    float ResolveFieldCollisions(BallStore& balls, const TableGeometry& table);
 
     /**
      * Check collision between two balls
      * @return true if balls are overlapping
      */
-    bool CheckBallCollision(const Ball* a, const Ball* b) const;
+    bool CheckBallCollision(const BallStore& balls, int a, int b) const;
 
     /**
      * Resolve collision between two balls
      * Updates velocities based on elastic collision
+     * @return true if an impulse was applied (the balls were approaching)
+     */
+    bool ResolveBallCollision(BallStore& balls, int a, int b);
+
+    /**
+     * Sweep balls that moved further than SWEEP_THRESHOLD radii this step
+     * and resolve the first ball, cushion or pocket contact along the path
+     * at its time of impact (runs after integration; paths start at the
+     * positions in StepStartX/StepStartZ). Balls whose step a swept hit
+     * already finished stay where they are for the rest of the sweep
+     */
+    void ResolveSweptCollisions(BallStore& balls, const TableGeometry& table, float deltaTime);
+
+    /**
+     * Fused clamp + rest test + friction + integration (StepMode::Fused)
      */
-    void ResolveBallCollision(Ball* a, Ball* b);
+    void FusedIntegrate(BallStore& balls, float deltaTime);
 
     /**
      * Clamp ball velocities to maximum
      */
-    void ClampVelocities(std::vector<Ball*>& balls);
+    void ClampVelocities(BallStore& balls);
 
     /**
      * Stop balls that are moving very slowly
      */
-    void StopSlowBalls(std::vector<Ball*>& balls);
+    void StopSlowBalls(BallStore& balls);
 
     /**
      * Check if balls have fallen into pockets and deactivate them
      */
-    void CheckPockets(std::vector<Ball*>& balls, const Table& table);
+    void CheckPockets(BallStore& balls, const TableGeometry& table);
+
+    /**
+     * Pot a ball (regular balls are deactivated, the cue ball is respawned)
+     */
+    void PotBall(BallStore& balls, int ball, int pocket);
+
+    /**
+     * Append an event to the log, if one is attached
+     */
+    void LogEvent(PhysicsEventType type, int ball, int other, double time);
+
+    // Instruction set for the per-ball kernels
+    PhysicsKernels::InstructionSet Kernels;
+
+    // Scheduling of the per-ball passes
+    StepMode Mode;
+
+    // Collision passes: mode, adaptive cap and what the last step used
+    IterationMode Iterations;
+    int MaxIterations;
+    int LastIterations;
+    float ResidualPenetration;
+
+    // RunToRest fast-forwards when no contact is possible
+    bool FastForward;
+
+    // Continuous collision detection for fast balls
+    bool ContinuousCollision;
+    int MissedCollisions;
+
+    // Awake ball positions before this step's integration, and the balls a swept
+    // hit has already finished this step
+    std::vector<float> StepStartX;
+    std::vector<float> StepStartZ;
+    std::vector<uint8_t> SweptDone;
+
+    // Event log (not owned) and the time since it was attached
+    std::vector<PhysicsEvent>* EventLog;
+    double LogTime;
+
+    // Counters of the current/last step and their running totals
+    PhysicsStats StepStats;
+    PhysicsStats TotalStats;
+    bool PhaseTiming;
+
+    // Broadphase state (reused between steps to avoid reallocating)
+    Broadphase Method;
+    SpatialGrid Grid;
+    SweepAndPrune Sweep;
+    std::vector<BallPair> CandidatePairs;
+
+    // Sweep and prune: CandidatePairs holds this step's pairs for the first
+    // PairListAwake awake balls
+    bool PairListValid;
+    int PairListAwake;
+    std::vector<BallPair> Contacts;
+    std::vector<int> CushionCandidates;
 
     /**
-     * Check if a ball position is near a pocket gap (should skip cushion bounce)
+     * Straight path of an awake ball to where it comes to rest
      */
-    bool IsInPocketGap(const Vec3& pos, const Table& table) const;
+    struct RestPath
+    {
+        int Ball;
+        float EndX;
+        float EndZ;
+    };
+    std::vector<RestPath> RestPaths;
 };
 
 #endif // PHYSICS_H
@@ -0,0 +1,27 @@
+#ifndef PHYSICS_EVENT_H
+#define PHYSICS_EVENT_H
+
+/**
+ * Kinds of event recorded by Physics while simulating a shot
+ */
+enum class PhysicsEventType
+{
+    BallContact,  // Two balls collided (Other = second ball)
+    CushionHit,   // Ball bounced off a rail (Other = rail: 0 left, 1 right, 2 back, 3 front;
+                  // segment cushions report CushionSegment::Rail, distance fields -1)
+    Pot,          // Object ball fell into a pocket (Other = pocket index)
+    Scratch       // Cue ball fell into a pocket and was respawned (Other = pocket index)
+};
+
+/**
+ * One recorded physics event
+ */
+struct PhysicsEvent
+{
+    PhysicsEventType Type;
+    float Time;   // Seconds since the event log was attached
+    int Ball;     // Index of the ball in the BallStore
+    int Other;    // Meaning depends on Type (see PhysicsEventType)
+};
+
+#endif // PHYSICS_EVENT_H
@@ -0,0 +1,103 @@
+#ifndef PHYSICS_KERNELS_H
+#define PHYSICS_KERNELS_H
+
+#include <cstdint>
+
+/**
+ * Physics Kernels
+ * ---------------
+ * Per-ball passes of the physics step over BallStore arrays, plus the
+ * all-pairs overlap test for small tables, with scalar, SSE2 (4 balls per
+ * instruction) and AVX2 (8 balls per instruction) implementations
+ * selected at runtime.
+ *
+ * Inactive balls are handled with the store's all-ones/zero active mask
+ * rather than branches. The SIMD kernels run over whole lanes, so every
+ * array must be padded to a multiple of 8 elements (BallStore guarantees
+ * this); lanes past the ball count may be overwritten.
+ *
+ * Accuracy: the SIMD kernels perform the same IEEE operations in the same
+ * order as the scalar ones (mul, add, sqrt and div are all correctly
+ * rounded), so results are bit-identical. The only exception is a build
+ * that lets the compiler contract mul+add into FMA (e.g. -march=native
+ * with -ffp-contract=fast); results then stay within 1 ulp per step.
+ */
+namespace PhysicsKernels
+{
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * Detect the widest instruction set supported by the CPU and OS
+     */
+    InstructionSet DetectInstructionSet();
+
+    /**
+     * Human-readable name of an instruction set
+     */
+    const char* GetInstructionSetName(InstructionSet set);
+
+    /**
+     * Exponential friction followed by linear deceleration
+     * v *= frictionFactor; then speed is reduced by `reduction` (not below zero)
+     */
+    void ApplyFriction(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                       int count, float frictionFactor, float reduction);
+
+    /**
+     * Euler integration: pos += vel * deltaTime
+     */
+    void IntegratePositions(InstructionSet set, float* posX, float* posZ,
+                            const float* velX, const float* velZ, const uint32_t* active,
+                            int count, float deltaTime);
+
+    /**
+     * Scale velocities faster than maxVelocity back to maxVelocity
+     */
+    void ClampVelocities(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                         int count, float maxVelocity);
+
+    /**
+     * Zero velocities slower than minVelocity
+     */
+    void StopSlowBalls(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                       int count, float minVelocity);
+
+    /**
+     * Fused per-ball pass: clamp, rest test, friction and integration in one sweep
+     * Clamp and rest test apply to the velocities left by the previous step's
+     * collision phase, so running this at the start of every step performs the
+     * same operations in the same order as the separate kernels
+     * (friction, integrate, ..., clamp, stop) and gives bit-identical trajectories.
+     *
+     * Memory traffic per ball: 5 array reads + 4 writes (36 bytes) instead of
+     * 14 reads + 8 writes (88 bytes) for the four separate passes.
+     */
+    void FusedStep(InstructionSet set, float* posX, float* posZ, float* velX, float* velZ,
+                   const uint32_t* active, int count, float maxVelocity, float minVelocity,
+                   float frictionFactor, float reduction, float deltaTime);
+
+    // Most balls FindOverlaps handles (one bit per ball in a 32-bit row)
+    const int MAX_OVERLAP_BALLS = 32;
+
+    /**
+     * Overlap test of every awake ball against every ball, for small tables
+     * Each awake ball is tested against a whole block of 4 or 8 balls per
+     * instruction with the same operations as Physics::CheckBallCollision
+     * (bit-identical results). Bit j of overlaps[k] is set if awake ball
+     * awakeBalls[k] overlaps active ball j; an awake-awake pair is only
+     * reported in the row of its lower index.
+     * @param count Number of balls, at most MAX_OVERLAP_BALLS
+     * @param overlaps Receives one row per awake ball (numAwake entries)
+     * @return Number of pairs tested
+     */
+    int FindOverlaps(InstructionSet set, const float* posX, const float* posZ, const float* radius,
+                     const uint32_t* active, const uint32_t* awake, int count,
+                     const int* awakeBalls, int numAwake, uint32_t* overlaps);
+}
+
+#endif // PHYSICS_KERNELS_H
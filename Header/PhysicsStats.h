@@ -0,0 +1,126 @@
+#ifndef PHYSICS_STATS_H
+#define PHYSICS_STATS_H
+
+#include <iosfwd>
+
+/**
+ * Timed phases of a physics step
+ */
+enum class PhysicsPhase
+{
+    Integrate,       // Friction and integration (one fused sweep in StepMode::Fused)
+    Swept,           // Continuous collision detection for fast balls
+    BallCollisions,  // Ball-ball broadphase, narrowphase and response (all iterations)
+    Cushions,        // Ball-cushion collisions (all iterations)
+    Pockets,         // Pot checks
+    Finish,          // Velocity clamp, rest test and sleeping
+
+    Count
+};
+
+/**
+ * Physics Stats
+ * -------------
+ * Counters describing what physics steps cost, kept by Physics for the
+ * last step and as totals (see Physics::GetStepStats / GetTotalStats).
+ *
+ * Counting is a handful of additions per step. Wall time per phase needs a
+ * clock read at every phase boundary, which costs as much as a small step,
+ * so phases are timed on one step in TIMING_INTERVAL only: PhaseSeconds
+ * sums the timed steps and TimedSteps counts them (GetPhaseAverage divides).
+ *
+ * Building with BILLIARD_NO_PHYSICS_STATS defined (CMake option
+ * BILLIARD_PHYSICS_STATS=OFF) compiles all collection out; the counters
+ * then stay zero.
+ */
+struct PhysicsStats
+{
+    // Steps between two steps whose phases are timed
+    static const int TIMING_INTERVAL = 1024;
+
+    static const int PHASE_COUNT = (int)PhysicsPhase::Count;
+
+    long long Steps;
+    long long PairsTested;    // Ball pairs checked for overlap (after the broadphase)
+    long long Overlaps;       // Pairs found overlapping
+    long long Impulses;       // Ball-ball impulses applied
+    long long CushionHits;    // Bounces off cushions
+    long long PocketEvents;   // Pots and scratches
+    long long Iterations;     // Collision iterations run
+    long long CappedSteps;    // Steps whose last iteration still found overlaps
+    long long SkippedSteps;   // Steps jumped over by Physics::FastForwardToRest (not counted in Steps)
+    long long TimedSteps;     // Steps whose phases were timed
+    double MaxPenetration;    // Deepest overlap left to a step's last iteration (max, not sum)
+    double PhaseSeconds[PHASE_COUNT];
+
+    PhysicsStats() { Reset(); }
+
+    /**
+     * Zero every counter
+     */
+    void Reset();
+
+    /**
+     * Add another set of counters to this one
+     */
+    void Add(const PhysicsStats& other);
+
+    /**
+     * Average wall time of a phase per timed step, in seconds
+     */
+    double GetPhaseAverage(PhysicsPhase phase) const;
+
+    /**
+     * Name of a phase (used as CSV column and JSON key)
+     */
+    static const char* GetPhaseName(PhysicsPhase phase);
+
+    /**
+     * Write the CSV header line, then one line per set of counters
+     */
+    static void WriteCsvHeader(std::ostream& out);
+    void WriteCsvRow(std::ostream& out) const;
+
+    /**
+     * Write the counters as one JSON object
+     */
+    void WriteJson(std::ostream& out) const;
+};
+
+// Called on every physics step; inline so they cost a few stores and adds
+inline void PhysicsStats::Reset()
+{
+    Steps = 0;
+    PairsTested = 0;
+    Overlaps = 0;
+    Impulses = 0;
+    CushionHits = 0;
+    PocketEvents = 0;
+    Iterations = 0;
+    CappedSteps = 0;
+    SkippedSteps = 0;
+    TimedSteps = 0;
+    MaxPenetration = 0.0;
+    for (int p = 0; p < PHASE_COUNT; p++)
+        PhaseSeconds[p] = 0.0;
+}
+
+inline void PhysicsStats::Add(const PhysicsStats& other)
+{
+    Steps += other.Steps;
+    PairsTested += other.PairsTested;
+    Overlaps += other.Overlaps;
+    Impulses += other.Impulses;
+    CushionHits += other.CushionHits;
+    PocketEvents += other.PocketEvents;
+    Iterations += other.Iterations;
+    CappedSteps += other.CappedSteps;
+    SkippedSteps += other.SkippedSteps;
+    TimedSteps += other.TimedSteps;
+    if (other.MaxPenetration > MaxPenetration)
+        MaxPenetration = other.MaxPenetration;
+    for (int p = 0; p < PHASE_COUNT; p++)
+        PhaseSeconds[p] += other.PhaseSeconds[p];
+}
+
+#endif // PHYSICS_STATS_H
@@ -0,0 +1,180 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "BallStore.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/**
+ * Replay File Format
+ * ------------------
+ * One file per recording, little-endian:
+ *
+ *   header      magic "BRPL", version, ball count, keyframe interval,
+ *               step time, position scale, frame count, keyframe count,
+ *               byte offset of the keyframe index
+ *   ball table  number and radius of each ball
+ *   frames      one per physics step, variable length
+ *   index       byte offset of every keyframe (uint64 each)
+ *
+ * Positions are quantized to 1 / position scale units (a power of two, so
+ * a sub-millimetre grid) and stored as integers. Every KeyframeInterval-th
+ * frame is a keyframe holding every ball's absolute position as a zigzag
+ * varint plus a bitmask of active balls. Other frames hold a bitmask of
+ * the balls whose quantized position or active flag changed since the
+ * previous frame, then for each of those the X and Z deltas as zigzag
+ * varints (the lowest bit of the X value toggles the active flag).
+ * Resting balls cost nothing and rolling balls a few bytes per step.
+ *
+ * Frames are variable length, so the index maps keyframe k (frame
+ * k * KeyframeInterval) to its byte offset: seeking decodes at most
+ * KeyframeInterval - 1 delta frames regardless of the replay length.
+ */
+namespace ReplayFormat
+{
+    static const uint32_t VERSION = 1;
+    static const int HEADER_BYTES = 40;
+    static const int BALL_ENTRY_BYTES = 8;
+
+    // Quantization of positions (1/8192 unit steps)
+    static const float POSITION_SCALE = 8192.0f;
+
+    // Default keyframe spacing in frames (one second at the default tick rate)
+    static const int DEFAULT_KEYFRAME_INTERVAL = 240;
+}
+
+/**
+ * Replay Recorder
+ * ---------------
+ * Streams ball positions to a replay file, one frame per physics step.
+ * The set of balls (and their order) must stay the same while recording.
+ */
+class ReplayRecorder
+{
+public:
+    ReplayRecorder();
+    ~ReplayRecorder();
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    /**
+     * Create a replay file (closes any recording in progress)
+     * @param path             File to write
+     * @param balls            Balls to record (fixes the ball count and table)
+     * @param stepTime         Seconds per recorded frame
+     * @param keyframeInterval Frames between full keyframes
+     * @return false if the file cannot be created
+     */
+    bool Open(const char* path, const BallStore& balls, float stepTime,
+              int keyframeInterval = ReplayFormat::DEFAULT_KEYFRAME_INTERVAL);
+
+    /**
+     * Append the current state of the balls as the next frame
+     */
+    void RecordFrame(const BallStore& balls);
+
+    /**
+     * Write the keyframe index and finish the file
+     * @return false if writing failed
+     */
+    bool Close();
+
+    bool IsRecording() const { return File.is_open(); }
+    int GetFrameCount() const { return FrameCount; }
+
+    /**
+     * Bytes written so far (frames and header; the index is added on Close)
+     */
+    uint64_t GetBytesWritten() const { return Offset; }
+
+private:
+    std::ofstream File;
+    int BallCount;
+    int KeyframeInterval;
+    float StepTime;
+    int FrameCount;
+    uint64_t Offset;
+
+    // Quantized state of the previous frame
+    std::vector<int32_t> LastX;
+    std::vector<int32_t> LastZ;
+    std::vector<uint8_t> LastActive;
+
+    std::vector<uint64_t> KeyframeOffsets;
+    std::vector<unsigned char> FrameBytes;
+
+    void WriteHeader();
+};
+
+/**
+ * Replay Reader
+ * -------------
+ * Plays back a replay file through a read-only memory mapping. Opening
+ * reads only the header, ball table and keyframe index; frames are decoded
+ * on demand. Reading frames in order decodes one frame each, and any other
+ * frame is reached from the nearest keyframe before it.
+ */
+class ReplayReader
+{
+public:
+    ReplayReader();
+
+    /**
+     * Map a replay file and read its header and index
+     * @return false if the file is missing, truncated or not a replay
+     */
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const { return File.IsOpen(); }
+
+    int GetFrameCount() const { return FrameCount; }
+    int GetBallCount() const { return BallCount; }
+    float GetStepTime() const { return StepTime; }
+
+    /**
+     * Length of the replay in seconds
+     */
+    double GetDuration() const { return FrameCount * (double)StepTime; }
+
+    /**
+     * Frame shown at a time (clamped to the replay)
+     */
+    int FrameAtTime(double time) const;
+
+    /**
+     * Decode a frame into a ball store
+     * A store that does not hold the recorded balls is refilled from the ball table.
+     * Positions are set, potted balls deactivated and every ball stopped.
+     * @return false if the frame is out of range or the data is corrupt
+     */
+    bool ReadFrame(int frame, BallStore& balls);
+
+private:
+    MappedFile File;
+    int BallCount;
+    int KeyframeInterval;
+    float StepTime;
+    float PositionScale;
+    int FrameCount;
+    int KeyframeCount;
+    const unsigned char* BallTable;
+    const unsigned char* Index;
+
+    // Decoder state: the last decoded frame and the offset of the one after it
+    int CurrentFrame;
+    uint64_t Cursor;
+    std::vector<int32_t> X;
+    std::vector<int32_t> Z;
+    std::vector<uint8_t> ActiveFlags;
+
+    /**
+     * Decode the frame at Cursor into the decoder state
+     */
+    bool DecodeFrame(bool keyframe);
+};
+
+#endif // REPLAY_H
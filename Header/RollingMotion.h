@@ -0,0 +1,162 @@
+#ifndef ROLLING_MOTION_H
+#define ROLLING_MOTION_H
+
+#include "Physics.h"
+#include "DeterministicMath.h"
+#include <cmath>
+
+/**
+ * Rolling Motion
+ * --------------
+ * Closed-form solution of the friction model used by Physics, for
+ * engines that jump through time instead of stepping it.
+ *
+ * Physics::ApplyFriction keeps ROLLING_FRICTION^dt of the velocity and
+ * then removes LINEAR_DECELERATION * dt of speed. As dt -> 0 this is
+ *
+ *     ds/dt = -k * s - a,   k = -ln(ROLLING_FRICTION),  a = LINEAR_DECELERATION
+ *
+ * with the solution
+ *
+ *     s(t) = (s0 + a/k) * e^(-k t) - a/k
+ *     d(t) = ((s0 + a/k) * (1 - e^(-k t)) - a t) / k      (distance rolled)
+ *
+ * A ball keeps its direction while rolling, so its path between events is
+ * a straight segment. Everything is in double precision: event times are
+ * found by root finding and float round-off would move contacts around.
+ *
+ * Physics itself moves in fixed steps, where the speed after n steps is a
+ * geometric series rather than the limit above:
+ *
+ *     s(n) = (s0 + c) * f^n - c,   f = ROLLING_FRICTION^dt,  c = a*dt / (1 - f)
+ *
+ * The Stepped functions sum it, so a fast-forward lands where stepping
+ * would (up to float round-off in the steps).
+ */
+namespace RollingMotion
+{
+    // libm in normal builds, the portable versions in deterministic ones
+    inline double Exp(double x)
+    {
+#ifdef BILLIARD_DETERMINISTIC
+        return DeterministicMath::Exp(x);
+#else
+        return std::exp(x);
+#endif
+    }
+
+    inline double Log(double x)
+    {
+#ifdef BILLIARD_DETERMINISTIC
+        return DeterministicMath::Log(x);
+#else
+        return std::log(x);
+#endif
+    }
+
+    inline double DecayRate()
+    {
+        return -Log((double)PhysicsConstants::ROLLING_FRICTION);
+    }
+
+    inline double Deceleration()
+    {
+        return (double)PhysicsConstants::LINEAR_DECELERATION;
+    }
+
+    /**
+     * Speed after rolling for time t (never negative)
+     */
+    inline double SpeedAt(double s0, double t)
+    {
+        double k = DecayRate();
+        double c = Deceleration() / k;
+        double s = (s0 + c) * Exp(-k * t) - c;
+        return s > 0.0 ? s : 0.0;
+    }
+
+    /**
+     * Time for the speed to fall from s0 to sEnd (0 if already at or below sEnd)
+     */
+    inline double TimeToSpeed(double s0, double sEnd)
+    {
+        if (s0 <= sEnd)
+            return 0.0;
+        double k = DecayRate();
+        double c = Deceleration() / k;
+        return Log((s0 + c) / (sEnd + c)) / k;
+    }
+
+    /**
+     * Distance rolled after time t, starting at speed s0
+     * t must not exceed the time the ball takes to stop
+     */
+    inline double DistanceAt(double s0, double t)
+    {
+        double k = DecayRate();
+        double c = Deceleration() / k;
+        return ((s0 + c) * (1.0 - Exp(-k * t)) - Deceleration() * t) / k;
+    }
+
+    /**
+     * Time needed to roll a given distance, starting at speed s0
+     * @param maxTime Time at which the ball stops rolling
+     * @return Time in [0, maxTime], or a negative value if the ball stops first
+     */
+    inline double TimeAtDistance(double s0, double distance, double maxTime)
+    {
+        if (distance <= 0.0)
+            return 0.0;
+        if (distance > DistanceAt(s0, maxTime))
+            return -1.0;
+
+        // d(t) is increasing and concave, so Newton from t = 0 approaches
+        // the root from below without overshooting
+        double t = 0.0;
+        for (int i = 0; i < 32; i++)
+        {
+            double s = SpeedAt(s0, t);
+            if (s <= 0.0)
+                break;
+            double step = (distance - DistanceAt(s0, t)) / s;
+            t += step;
+            if (step < 1e-12)
+                break;
+        }
+        return t < maxTime ? t : maxTime;
+    }
+
+    /**
+     * Steps a ball starting at speed s0 still moves before Physics stops it
+     * The step whose speed falls below sEnd still moves; the rest test after it stops the ball
+     * @param factor Velocity kept by friction over one step (ROLLING_FRICTION^dt)
+     * @param reduction Speed removed by LINEAR_DECELERATION over one step
+     */
+    inline int SteppedStepsToRest(double s0, double factor, double reduction, double sEnd)
+    {
+        if (s0 < sEnd)
+            return 0;
+        double c = reduction / (1.0 - factor);
+        double n = Log((sEnd + c) / (s0 + c)) / Log(factor);
+        return (int)n + 1;
+    }
+
+    /**
+     * Distance covered over the next steps, starting at speed s0
+     * (speeds below 0 count as 0, as the deceleration stops at rest)
+     */
+    inline double SteppedDistance(double s0, double factor, double reduction, double dt, int steps)
+    {
+        if (steps <= 0)
+            return 0.0;
+        double c = reduction / (1.0 - factor);
+        double fn = Exp(Log(factor) * (steps - 1));
+
+        // Sum of s(1) .. s(steps - 1), plus the last step clamped at rest
+        double sum = (s0 + c) * factor * (1.0 - fn) / (1.0 - factor) - (steps - 1) * c;
+        double last = (s0 + c) * fn * factor - c;
+        return dt * (sum + (last > 0.0 ? last : 0.0));
+    }
+}
+
+#endif // ROLLING_MOTION_H
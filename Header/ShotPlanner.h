@@ -0,0 +1,118 @@
+#ifndef SHOT_PLANNER_H
+#define SHOT_PLANNER_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include "Physics.h"
+#include "PhysicsEvent.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Shot chosen by the planner
+ */
+struct PlannedShot
+{
+    Vec3 Direction;   // Shot direction (XZ plane, normalized)
+    float Power;      // Shot power, as passed to Physics::ApplyImpulse
+    float Score;      // Score of the outcome (see ShotPlanner::ScoreOutcome)
+    int Potted;       // Object balls potted by the shot
+    bool Scratch;     // Cue ball potted
+};
+
+/**
+ * Shot Planner
+ * ------------
+ * Monte Carlo search for a good shot around a candidate aim.
+ *
+ * Each rollout samples a direction and power around the candidate,
+ * simulates the shot to rest with Physics and scores the outcome
+ * (object balls potted, scratches, whether the cue ball hit anything,
+ * and how close it leaves the cue ball to the next object ball). The
+ * best-scoring sample is returned.
+ *
+ * Rollouts run on every core. Each worker owns a copy of the world, a
+ * Physics instance and a random stream seeded from (seed, worker index),
+ * so a run with the same seed, thread count and rollout limit samples
+ * exactly the same shots. Workers stop at the time budget; the first
+ * rollout of worker 0 is always the candidate itself.
+ */
+class ShotPlanner
+{
+public:
+    /**
+     * Constructor
+     * @param threadCount Worker threads (0 = one per hardware thread)
+     */
+    ShotPlanner(int threadCount = 0);
+
+    /**
+     * Search for the best shot around a candidate
+     * @param table Table geometry
+     * @param balls Current ball state (not modified)
+     * @param cueBall Index of the ball to strike
+     * @param direction Candidate shot direction
+     * @param power Candidate shot power
+     * @param budgetSeconds Wall-clock time to search for
+     * @return Best shot found
+     */
+    PlannedShot Plan(const TableGeometry& table, const BallStore& balls, int cueBall,
+                     const Vec3& direction, float power, float budgetSeconds = 0.05f);
+
+    /**
+     * Score the outcome of a shot (higher is better)
+     * @param balls State once the balls have stopped
+     * @param events Events recorded during the shot
+     * @param cueBall Index of the struck ball
+     */
+    static float ScoreOutcome(const BallStore& balls, const std::vector<PhysicsEvent>& events, int cueBall);
+
+    /**
+     * Seed of the random streams (worker i uses the stream for (seed, i))
+     */
+    void SetSeed(uint32_t seed);
+    uint32_t GetSeed() const;
+
+    /**
+     * Sampling range around the candidate
+     * @param angle Largest direction change, in radians
+     * @param power Largest power change, as a fraction of the candidate power
+     */
+    void SetSpread(float angle, float power);
+
+    /**
+     * Cap on the rollouts of one Plan call (0 = limited by the time budget only)
+     * With a cap that is reached within the budget, a run is reproducible
+     * regardless of machine speed
+     */
+    void SetRolloutLimit(int rollouts);
+
+    /**
+     * Fixed time step used for every rollout, in seconds
+     */
+    void SetTimeStep(float deltaTime);
+
+    void SetThreadCount(int threadCount);
+    int GetThreadCount() const;
+
+    /**
+     * Measurements of the last Plan call
+     */
+    int GetRolloutCount() const;
+    double GetRolloutsPerSecond() const;
+    double GetRolloutsPerSecondPerCore() const;
+
+private:
+    uint32_t Seed;
+    float AngleSpread;
+    float PowerSpread;
+    int RolloutLimit;
+    float TimeStep;
+    int ThreadCount;
+
+    int LastRollouts;
+    int LastThreadsUsed;
+    double LastRolloutsPerSecond;
+};
+
+#endif // SHOT_PLANNER_H
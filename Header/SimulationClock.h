@@ -0,0 +1,101 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+/**
+ * Simulation Clock
+ * ----------------
+ * Fixed-timestep clock that decouples physics from the frame rate.
+ *
+ * Each frame's real elapsed time is added to an accumulator, and the clock
+ * hands out as many whole fixed steps as the accumulator holds, so the
+ * physics always advances in identical steps of 1 / tick rate regardless
+ * of VSync, the manual FPS limiter or frame spikes. The remainder carries
+ * over to the next frame.
+ *
+ * If the simulation cannot keep up (each step takes longer to compute than
+ * it simulates), the accumulator would grow without bound and every frame
+ * would run more steps than the last (the "spiral of death"). The clock
+ * caps the steps per frame, drops the excess time and reports it, so the
+ * game slows down instead of freezing.
+ */
+class SimulationClock
+{
+public:
+    /**
+     * Constructor
+     * @param tickRate Physics steps per second (clamped to 1 .. 1,000,000)
+     * @param maxStepsPerFrame Most steps handed out for one frame (at least 1)
+     */
+    SimulationClock(float tickRate = 240.0f, int maxStepsPerFrame = 16);
+
+    /**
+     * Set the physics rate (clears any partly accumulated step)
+     * Rates outside 1 .. 1,000,000 steps per second are clamped
+     */
+    void SetTickRate(float tickRate);
+    float GetTickRate() const;
+
+    /**
+     * Fixed step length in seconds (1 / tick rate)
+     */
+    float GetStepTime() const;
+
+    /**
+     * Set the most steps handed out for one frame (values below 1 become 1)
+     */
+    void SetMaxStepsPerFrame(int maxSteps);
+    int GetMaxStepsPerFrame() const;
+
+    /**
+     * Add a frame's elapsed real time and take the steps it pays for
+     * @param frameTime Seconds since the previous frame
+     * @return Number of fixed steps to simulate this frame
+     */
+    int Advance(float frameTime);
+
+    /**
+     * Fraction of a step left in the accumulator after Advance, in [0, 1)
+     * (for interpolating rendered positions between the last two steps)
+     */
+    float GetInterpolationAlpha() const;
+
+    /**
+     * Check if the last Advance hit the step cap and dropped time
+     */
+    bool IsFallingBehind() const;
+
+    /**
+     * Total simulated time dropped by the step cap, in seconds
+     */
+    double GetDroppedTime() const;
+
+    /**
+     * Number of frames that hit the step cap
+     */
+    int GetOverrunFrameCount() const;
+
+    /**
+     * Total number of steps handed out
+     */
+    long long GetStepCount() const;
+
+    /**
+     * Clear the accumulator and all counters
+     */
+    void Reset();
+
+private:
+    float TickRate;
+    float StepTime;
+    int MaxStepsPerFrame;
+
+    // Real time not yet simulated
+    double Accumulator;
+
+    bool FallingBehind;
+    double DroppedTime;
+    int OverrunFrames;
+    long long StepCount;
+};
+
+#endif // SIMULATION_CLOCK_H
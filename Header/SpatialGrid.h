@@ -0,0 +1,84 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include <vector>
+
+/**
+ * Candidate pair of ball indices produced by a broadphase
+ */
+struct BallPair
+{
+    int A;
+    int B;
+};
+
+/**
+ * Spatial Grid
+ * ------------
+ * Uniform-grid broadphase on the XZ plane of the table.
+ *
+ * Cells are one ball diameter wide, so two touching balls always land
+ * in the same or adjacent cells. Balls are bucketed with a counting sort
+ * (no per-cell allocations); after the first build the grid reuses its
+ * storage and does not allocate unless the table or ball count grows.
+ *
+ * Balls outside the play area (e.g. rolling into a pocket mouth) are
+ * clamped into the border cells, which keeps neighbour queries correct.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    /**
+     * Bucket all active balls into cells
+     * Grid size is derived from the table extents and the largest ball radius
+     * @param balls Ball state store
+     * @param table Reference to the table
+     */
+    void Build(const BallStore& balls, const TableGeometry& table);
+
+    /**
+     * Collect the pairs in the same or neighbouring cells that involve at least
+     * one awake ball; sleeping pairs are skipped, so the cost is
+     * O(awake x neighbours) instead of O(all balls x neighbours)
+     * Each pair is reported once with A < B, grouped by awake ball (use SortPairs for index order)
+     * @param balls Ball state store the grid was built from
+     * @param pairs Output list (cleared first)
+     */
+    void FindAwakePairs(const BallStore& balls, std::vector<BallPair>& pairs) const;
+
+    /**
+     * Sort pairs by (A, B), the order the all-pairs loop visits them in
+     */
+    static void SortPairs(std::vector<BallPair>& pairs);
+
+    int GetColumns() const { return Columns; }
+    int GetRows() const { return Rows; }
+
+private:
+    // Grid layout
+    float OriginX;
+    float OriginZ;
+    float InvCellSize;
+    int Columns;  // cells along X
+    int Rows;     // cells along Z
+
+    // Cell of every ball (-1 for inactive balls)
+    std::vector<int> BallCell;
+
+    // Counting-sort buckets: balls of cell c are CellBalls[CellStart[c] .. CellStart[c + 1])
+    std::vector<int> CellStart;
+    std::vector<int> CellBalls;
+    std::vector<int> CellCursor;
+
+    /**
+     * Map a world coordinate to a clamped cell coordinate
+     */
+    int CellX(float x) const;
+    int CellZ(float z) const;
+};
+
+#endif // SPATIAL_GRID_H
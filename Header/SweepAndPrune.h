@@ -0,0 +1,107 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+#include "BallStore.h"
+#include "SpatialGrid.h"
+#include <vector>
+
+/**
+ * Sweep And Prune
+ * ---------------
+ * Sort-and-sweep broadphase along the table's long Z axis.
+ *
+ * Active balls are kept sorted by the near Z edge of their bounds. The
+ * order survives between updates and is repaired with an insertion sort,
+ * which is close to linear because balls move a small fraction of a
+ * diameter per step. Pairs are found by scanning outward from each awake
+ * ball's place in the order while the Z bounds can still overlap.
+ *
+ * Each update takes a snapshot of the ball positions, and queries use the
+ * snapshot with bounds grown by a margin. The pairs found stay a superset
+ * of the touching pairs until a ball moves further than the margin from
+ * its snapshot (see HasMoved), so one query can serve several collision
+ * passes of a step.
+ */
+class SweepAndPrune
+{
+public:
+    SweepAndPrune();
+
+    /**
+     * Snapshot the active balls and restore the sort order
+     * The order is rebuilt from scratch when the set of active balls changed
+     * @param balls Ball state store
+     */
+    void Update(const BallStore& balls);
+
+    /**
+     * Check if an awake ball is further than the margin from its snapshot
+     * (pairs found since the last Update may then miss a contact)
+     * @param balls Ball state store passed to Update
+     */
+    bool HasMoved(const BallStore& balls) const;
+
+    /**
+     * Collect the pairs whose grown bounds overlap and that involve at least
+     * one awake ball
+     * Each pair is reported once with A < B, grouped by awake ball (use SpatialGrid::SortPairs for index order)
+     * @param balls Ball state store passed to Update
+     * @param pairs Output list (cleared first)
+     */
+    void FindAwakePairs(const BallStore& balls, std::vector<BallPair>& pairs) const;
+
+    /**
+     * Append the pairs of one ball with every active ball whose grown bounds overlap it
+     * (for balls woken after FindAwakePairs; pairs with other awake balls may repeat)
+     * @param ball Active ball present at the last Update
+     * @param pairs Output list (appended to)
+     */
+    void FindBallPairs(int ball, std::vector<BallPair>& pairs) const;
+
+    /**
+     * Distance the bounds are grown by on every side (a fraction of the largest radius)
+     */
+    float GetMargin() const;
+
+    /**
+     * Neighbour swaps the insertion sort needed in the last Update
+     * (-1 if the order was rebuilt)
+     */
+    int GetSwapCount() const;
+
+private:
+    /**
+     * Snapshot of one active ball, stored in sort order
+     */
+    struct Entry
+    {
+        float MinZ;    // Near Z edge of the ball's bounds (center - radius), the sort key
+        float X;
+        float Z;
+        float Radius;
+        int Ball;
+    };
+
+    /**
+     * Append the pairs of the ball in one slot of the order
+     * @param balls If set, other awake balls with a lower index are skipped (they report the pair)
+     */
+    void ScanFrom(int slot, const BallStore* balls, std::vector<BallPair>& pairs) const;
+
+    /**
+     * Sort every active ball from scratch
+     */
+    void Rebuild(const BallStore& balls);
+
+    // Active balls sorted by MinZ
+    std::vector<Entry> Entries;
+
+    // Slot of every ball in Entries (-1 for balls that were inactive)
+    std::vector<int> Slot;
+
+    float MaxRadius;
+    float Margin;
+    int Swaps;
+};
+
+#endif // SWEEP_AND_PRUNE_H
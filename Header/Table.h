@@ -1,6 +1,7 @@
 #ifndef TABLE_H
 #define TABLE_H
 
+#include "TableGeometry.h"
 #include "Util.h"
 #include "Shader.h"
 #include <GL/glew.h>
@@ -8,29 +9,14 @@
 /**
  * Table Class
  * -----------
- * Represents the billiard table:
+ * Renders the billiard table on top of its TableGeometry:
  * - Playing surface (flat rectangle at Y = 0)
  * - Four cushions (raised edges around the perimeter)
- *
- * Coordinate System:
- * - Table surface is at Y = 0
- * - Table is centered at origin
- * - Length along Z axis, Width along X axis
+ * - Frame, pockets and pocket rims
  */
-class Table
+class Table : public TableGeometry
 {
 public:
-    // Table dimensions
-    float Width;         // X dimension (shorter side)
-    float Length;        // Z dimension (longer side)
-    float CushionHeight; // Height of cushions above surface
-    float CushionWidth;  // Thickness of cushions
-
-    // Pocket configuration
-    static const int NUM_POCKETS = 6;
-    float PocketRadius;
-    Vec3 PocketPositions[NUM_POCKETS];
-
     // Visual properties
     Vec3 SurfaceColor;   // Green felt
     Vec3 CushionColor;   // Cushion wood/rubber color
@@ -64,44 +50,6 @@ public:
      */
     void Render(Shader& shader, const Mat4& viewProjection);
 
-    // ==================== Table Bounds (for collision detection) ====================
-
-    /**
-     * Get the inner playing area bounds
-     * @return Vec3 containing half-width, 0, half-length
-     */
-    Vec3 GetPlayAreaHalfExtents() const;
-
-    /**
-     * Get minimum X bound (left cushion inner edge)
-     */
-    float GetMinX() const;
-
-    /**
-     * Get maximum X bound (right cushion inner edge)
-     */
-    float GetMaxX() const;
-
-    /**
-     * Get minimum Z bound (far cushion inner edge)
-     */
-    float GetMinZ() const;
-
-    /**
-     * Get maximum Z bound (near cushion inner edge)
-     */
-    float GetMaxZ() const;
-
-    /**
-     * Get pocket positions array
-     */
-    const Vec3* GetPocketPositions() const;
-
-    /**
-     * Get pocket radius
-     */
-    float GetPocketRadius() const;
-
 private:
     // OpenGL objects for surface
     GLuint SurfaceVAO;
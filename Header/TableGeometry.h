@@ -0,0 +1,267 @@
+#ifndef TABLE_GEOMETRY_H
+#define TABLE_GEOMETRY_H
+
+#include "MathUtil.h"
+#include "CushionBVH.h"
+#include "DistanceField.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * How Physics finds ball-cushion contacts
+ */
+enum class CushionBackend
+{
+    // Four axis-aligned rails at the play-area bounds, open wherever a ball
+    // center is inside a pocket gap (the original model)
+    Rails,
+
+    // Cushion segments in a BVH: rails with real pocket mouths, angled jaws
+    // and pocket liners, or any outline set with SetCushionOutline
+    Segments,
+
+    // Signed distance field baked from the cushion segments: one bilinear
+    // sample per ball, whatever the shape of the table
+    DistanceField
+};
+
+/**
+ * Table Geometry
+ * --------------
+ * Dimensions, bounds and pockets of the billiard table: everything the
+ * physics needs to know about it, with no rendering state, so the
+ * simulation can run without an OpenGL context.
+ *
+ * Table extends this with the meshes and colors used to draw it.
+ *
+ * Pocket zones: the XZ area around the table is baked into a coarse grid
+ * whose cells record whether they are open table, near a rail, inside or
+ * on the edge of a pocket gap, or inside or on the edge of a pocket. Pocket
+ * and pocket-gap queries then take one lookup per ball instead of a loop
+ * over every pocket; only cells on a circle edge fall back to the exact
+ * distance test (against the one pocket the cell touches), so the answers
+ * are identical to the loops they replace.
+ *
+ * Cushions: every table also carries its cushions as segments in a
+ * CushionBVH. By default they follow the four rails, with a mouth cut
+ * wherever a pocket gap crosses a rail, a jaw from each mouth corner to
+ * the pocket and a liner around the back of the pocket. Custom shapes
+ * (snooker, carom, L-shaped...) replace them with SetCushionOutline or
+ * SetCushionSegments. The backend selects which model Physics uses.
+ * BakeDistanceField turns the segments into a DistanceField for the
+ * field backend, using a cache file so that later runs skip the bake.
+ *
+ * Coordinate System:
+ * - Table surface is at Y = 0
+ * - Table is centered at origin
+ * - Length along Z axis, Width along X axis
+ */
+class TableGeometry
+{
+public:
+    // Table dimensions
+    float Width;         // X dimension (shorter side)
+    float Length;        // Z dimension (longer side)
+    float CushionHeight; // Height of cushions above surface
+    float CushionWidth;  // Thickness of cushions
+
+    // Pocket configuration
+    static const int NUM_POCKETS = 6;
+    float PocketRadius;
+    Vec3 PocketPositions[NUM_POCKETS];
+
+    // Zone flags of a grid cell (see GetZone); a cell without flags is open table
+    static const uint8_t ZONE_RAIL = 1;         // Within GetRailBandWidth of a rail, or outside the play area
+    static const uint8_t ZONE_GAP = 2;          // Entirely inside a pocket gap
+    static const uint8_t ZONE_GAP_EDGE = 4;     // Crossed by the edge of a pocket gap
+    static const uint8_t ZONE_POCKET = 8;       // Entirely inside a pocket
+    static const uint8_t ZONE_POCKET_EDGE = 16; // Crossed by the edge of a pocket
+
+    // The top 3 bits of a zone hold the pocket its gap/pocket flags refer to,
+    // or ZONE_ANY_POCKET if more than one pocket reaches the cell
+    static const int ZONE_POCKET_SHIFT = 5;
+    static const int ZONE_ANY_POCKET = 7;
+
+    /**
+     * Constructor with standard pool table dimensions
+     */
+    TableGeometry();
+
+    /**
+     * Constructor with custom dimensions
+     */
+    TableGeometry(float width, float length, float cushionHeight, float cushionWidth);
+
+    // ==================== Table Bounds (for collision detection) ====================
+
+    /**
+     * Get the inner playing area bounds
+     * @return Vec3 containing half-width, 0, half-length
+     */
+    Vec3 GetPlayAreaHalfExtents() const;
+
+    /**
+     * Get minimum X bound (left cushion inner edge)
+     */
+    float GetMinX() const;
+
+    /**
+     * Get maximum X bound (right cushion inner edge)
+     */
+    float GetMaxX() const;
+
+    /**
+     * Get minimum Z bound (far cushion inner edge)
+     */
+    float GetMinZ() const;
+
+    /**
+     * Get maximum Z bound (near cushion inner edge)
+     */
+    float GetMaxZ() const;
+
+    /**
+     * Get pocket positions array
+     */
+    const Vec3* GetPocketPositions() const;
+
+    /**
+     * Get pocket radius
+     */
+    float GetPocketRadius() const;
+
+    /**
+     * Get radius of the cushion gap around each pocket
+     * Ball centers inside it skip cushion bounces so they can roll into the pocket
+     */
+    float GetPocketGapRadius() const;
+
+    // ==================== Pocket Zones ====================
+
+    /**
+     * Rebuild the zone grid (done by the constructors; call again after
+     * changing the dimensions or pockets)
+     */
+    void BakeZones();
+
+    /**
+     * Zone of the grid cell containing a point
+     * Points outside the grid report every edge flag with ZONE_ANY_POCKET,
+     * which sends queries down the exact path
+     */
+    uint8_t GetZone(float x, float z) const
+    {
+        float fx = (x - ZoneOriginX) * ZoneInvCellSize;
+        float fz = (z - ZoneOriginZ) * ZoneInvCellSize;
+        if (!(fx >= 0.0f && fz >= 0.0f && fx < (float)ZoneColumns && fz < (float)ZoneRows))
+            return ZONE_OUTSIDE;
+        return Zones[(int)fz * ZoneColumns + (int)fx];
+    }
+
+    /**
+     * Width of the band along the rails flagged ZONE_RAIL
+     * Balls narrower than this cannot touch a rail from a cell outside the band
+     */
+    float GetRailBandWidth() const;
+
+    /**
+     * Check if every cell a point crosses moving from (x0, z0) to (x1, z1) is
+     * open table (no flags), i.e. a ball narrower than GetRailBandWidth whose
+     * center follows the segment touches no cushion and reaches no pocket gap
+     */
+    bool IsOpenPath(float x0, float z0, float x1, float z1) const;
+
+    /**
+     * Check if a point is inside the cushion gap of any pocket
+     * @param zone GetZone of the point, if the caller already has it
+     */
+    bool IsInPocketGap(float x, float z) const;
+    bool IsInPocketGap(float x, float z, uint8_t zone) const;
+
+    /**
+     * Find the pocket whose circle contains a point
+     * @return Lowest index of such a pocket, or -1 if there is none
+     */
+    int FindPocket(float x, float z) const;
+
+    // ==================== Cushions ====================
+
+    /**
+     * Select the cushion model used by Physics (rebakes the zone grid)
+     * Selecting DistanceField bakes the field if there is none yet
+     */
+    void SetCushionBackend(CushionBackend backend);
+    CushionBackend GetCushionBackend() const;
+
+    /**
+     * Replace the cushions with a closed outline of the play area
+     * Mouths, jaws and liners are added wherever a pocket gap crosses an edge.
+     * Edge i (from point i to point i + 1) reports rail i in events.
+     * Selects CushionBackend::Segments
+     * @param outline Corners of the outline in order (Y is ignored)
+     */
+    void SetCushionOutline(const std::vector<Vec3>& outline);
+
+    /**
+     * Replace the cushions with explicit segments (no mouths are cut)
+     * Selects CushionBackend::Segments
+     */
+    void SetCushionSegments(const std::vector<CushionSegment>& segments);
+
+    const CushionBVH& GetCushions() const;
+
+    /**
+     * Bake the signed distance field of the cushions
+     * If the cache file holds a field baked from the same cushions it is loaded
+     * instead, otherwise the new field is written to it
+     * @param cachePath   Cache file (nullptr: always bake, write nothing)
+     * @param threadCount Bake threads (0 = one per hardware thread)
+     * @return true if the field was loaded from the cache
+     */
+    bool BakeDistanceField(const char* cachePath = nullptr, int threadCount = 0);
+
+    /**
+     * Baked field (empty until BakeDistanceField, or after the cushions change)
+     */
+    const DistanceField& GetDistanceField() const;
+
+private:
+    // Zone reported for points outside the grid
+    static const uint8_t ZONE_OUTSIDE = ZONE_RAIL | ZONE_GAP_EDGE | ZONE_POCKET_EDGE | (ZONE_ANY_POCKET << ZONE_POCKET_SHIFT);
+
+    // Zone grid (one byte per cell, row-major along X)
+    std::vector<uint8_t> Zones;
+    float ZoneOriginX;
+    float ZoneOriginZ;
+    float ZoneInvCellSize;
+    int ZoneColumns;
+    int ZoneRows;
+
+
+    /**
+     * Place the pockets at the corners and side rails
+     */
+    void PlacePockets();
+
+    /**
+     * Build the default cushions along the four rails
+     */
+    void PlaceCushions();
+
+    /**
+     * Build cushion segments from a closed outline, cutting pocket mouths
+     * @param edgeRails Rail reported for each edge (nullptr: the edge index)
+     */
+    void BuildCushions(const std::vector<Vec3>& outline, const int* edgeRails);
+
+    /**
+     * Distance beyond the play-area bounds covered by the zone grid and the distance field
+     */
+    float GetOuterMargin() const;
+
+    CushionBackend Backend;
+    CushionBVH Cushions;
+    DistanceField Field;
+};
+
+#endif // TABLE_GEOMETRY_H
@@ -0,0 +1,142 @@
+#ifndef TRAJECTORY_PREVIEW_H
+#define TRAJECTORY_PREVIEW_H
+
+#include "BallStore.h"
+#include "TableGeometry.h"
+#include "Physics.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Predicted outcome of an aimed shot
+ */
+struct PreviewResult
+{
+    unsigned int RequestId;         // Id returned by the Request that produced it
+    std::vector<Vec3> CuePath;      // Cue ball centers along its path (Y = 0)
+
+    // First contact of the cue ball with an object ball
+    bool HasContact;
+    int ContactBall;                // Index of the object ball hit
+    Vec3 ContactPosition;           // Cue ball center at the contact
+    Vec3 CueDeflection;             // Cue ball direction just after the contact
+    Vec3 ObjectDeflection;          // Object ball direction just after the contact
+    std::vector<Vec3> ObjectPath;   // Object ball centers from the contact on
+};
+
+/**
+ * Trajectory Preview
+ * ------------------
+ * Predicts the cue ball path, its first object-ball contact and the
+ * resulting deflections on a background thread while the player aims.
+ *
+ * The render thread posts aim requests (a snapshot of the balls plus the
+ * shot) as often as the input changes. Only the newest request is kept:
+ * posting a new one, or calling Cancel, aborts a prediction in progress
+ * within a physics step. The render thread polls GetLatest for the most
+ * recent completed prediction, so it never waits on the solver.
+ *
+ * The prediction steps its own Physics instance with the same fixed step
+ * as the game, so the preview matches the shot that is actually played.
+ */
+class TrajectoryPreview
+{
+public:
+    /**
+     * Constructor - starts the worker thread
+     * @param table Table geometry (copied)
+     * @param deltaTime Physics step used for predictions
+     */
+    TrajectoryPreview(const TableGeometry& table, float deltaTime);
+
+    /**
+     * Destructor - cancels any prediction and joins the worker thread
+     */
+    ~TrajectoryPreview();
+
+    TrajectoryPreview(const TrajectoryPreview&) = delete;
+    TrajectoryPreview& operator=(const TrajectoryPreview&) = delete;
+
+    /**
+     * Post a prediction request, replacing (and cancelling) any earlier one
+     * @param balls Current ball state (copied)
+     * @param cueBall Index of the ball to strike
+     * @param direction Shot direction (XZ plane)
+     * @param power Shot power, as passed to Physics::ApplyImpulse
+     * @return Id of the request (matches PreviewResult::RequestId)
+     */
+    unsigned int Request(const BallStore& balls, int cueBall, const Vec3& direction, float power);
+
+    /**
+     * Drop the pending request and abort the prediction in progress
+     * Also discards the last result, so GetLatest returns false until the next one
+     */
+    void Cancel();
+
+    /**
+     * Get the most recent completed prediction
+     * @param result Receives the prediction
+     * @return false if no prediction has completed since the last Cancel
+     */
+    bool GetLatest(PreviewResult& result) const;
+
+    /**
+     * Longest stretch of simulated time a prediction covers, in seconds
+     */
+    void SetMaxTime(float seconds);
+    float GetMaxTime() const;
+
+private:
+    /**
+     * Worker thread: wait for requests and run them
+     */
+    void WorkerLoop();
+
+    /**
+     * Simulate one request
+     * @return false if it was cancelled before it finished
+     */
+    bool Predict(unsigned int id, BallStore& balls, int cueBall, const Vec3& direction,
+                 float power, PreviewResult& result);
+
+    /**
+     * Fill in the first contact of a prediction from the state before the step it happened in
+     */
+    void RecordContact(PreviewResult& result, const BallStore& balls, int cueBall, int objectBall,
+                       const Vec3& cueStart, const Vec3& cueVelocity);
+
+    TableGeometry Geometry;
+    float DeltaTime;
+    std::atomic<float> MaxTime;
+
+    // Worker-owned simulation state
+    Physics Sim;
+    std::vector<PhysicsEvent> Events;
+    std::vector<float> StepStartX;   // Ball positions before the current step
+    std::vector<float> StepStartZ;
+
+    // Pending request, guarded by RequestMutex
+    std::mutex RequestMutex;
+    std::condition_variable RequestReady;
+    BallStore PendingBalls;
+    int PendingCueBall;
+    Vec3 PendingDirection;
+    float PendingPower;
+    bool HasPending;
+    bool Stopping;
+
+    // Id of the newest request; a prediction aborts once it no longer matches
+    std::atomic<unsigned int> LatestRequest;
+
+    // Last completed prediction, guarded by ResultMutex
+    mutable std::mutex ResultMutex;
+    PreviewResult Latest;
+    bool HasResult;
+
+    std::thread Worker;
+};
+
+#endif // TRAJECTORY_PREVIEW_H
@@ -0,0 +1,52 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include "BallStore.h"
+#include "SimulationClock.h"
+#include <cstdint>
+
+/**
+ * World Snapshot
+ * --------------
+ * Plain-data copy of the complete simulation state, for search algorithms
+ * that branch from the same position thousands of times.
+ *
+ * The ball data is kept in exactly the layout of a BallStore block at
+ * capacity MAX_BALLS (every field array, including the awake list), so
+ * saving and restoring a store of that capacity is one memcpy each way and
+ * never allocates. Stores of another capacity are copied field by field.
+ *
+ * The struct is trivially copyable: snapshots can live in preallocated
+ * arrays and be copied, written to disk or sent over the network with
+ * memcpy. The simulation has no random state; the clock is included so a
+ * restored game resumes on the same fixed-step schedule.
+ */
+struct WorldSnapshot
+{
+    // Largest number of balls a snapshot holds (a full rack is 16)
+    static const int MAX_BALLS = 32;
+
+    // Bytes of ball data (a BallStore block at capacity MAX_BALLS)
+    static const int BLOCK_BYTES = BallStore::NUM_FIELDS * MAX_BALLS * 4;
+
+    alignas(32) unsigned char Block[BLOCK_BYTES];
+    int Count;
+    int AwakeCount;
+    SimulationClock Clock;
+
+    /**
+     * Capture a ball store (and optionally a clock)
+     * @return false if the store holds more than MAX_BALLS balls
+     */
+    bool Save(const BallStore& balls);
+    bool Save(const BallStore& balls, const SimulationClock& clock);
+
+    /**
+     * Put the captured state back into a ball store (and optionally a clock)
+     * A store smaller than MAX_BALLS is grown once, so later restores are a single memcpy
+     */
+    void Restore(BallStore& balls) const;
+    void Restore(BallStore& balls, SimulationClock& clock) const;
+};
+
+#endif // WORLD_SNAPSHOT_H
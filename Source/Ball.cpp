@@ -5,17 +5,10 @@
 // Static member initialization
 Model* Ball::s_SphereModel = nullptr;
 
-Ball::Ball(int number, const Vec3& position, float radius, const Vec3& color)
-    : Number(number)
-    , Position(position)
-    , Velocity(0.0f, 0.0f, 0.0f)
-    , Radius(radius)
-    , Color(color)
-    , IsActive(true)
-{
-}
-
-Ball::~Ball()
+Ball::Ball(const BallStore* store, int index, const Vec3& color)
+    : Color(color)
+    , Store(store)
+    , Index(index)
 {
 }
 
@@ -38,9 +31,9 @@ void Ball::CleanupModel()
     }
 }
 
-void Ball::Render(Shader& shader, const Mat4& viewProjection)
+void Ball::Render(Shader& shader, const Mat4& viewProjection) const
 {
-    if (!IsActive || s_SphereModel == nullptr)
+    if (!IsActive() || s_SphereModel == nullptr)
         return;
 
     // Calculate MVP matrix
@@ -56,42 +49,18 @@ void Ball::Render(Shader& shader, const Mat4& viewProjection)
     s_SphereModel->Draw(shader);
 }
 
-void Ball::Update(float deltaTime)
-{
-    if (!IsActive)
-        return;
-
-    // Simple Euler integration
-    Position += Velocity * deltaTime;
-
-    // Keep Y at radius (ball rests on surface)
-    Position.y = Radius;
-}
-
 Mat4 Ball::GetModelMatrix() const
 {
     // Translate to position and scale from unit sphere to ball radius
-    return Mat4::Translate(Position) * Mat4::Scale(Radius);
-}
-
-bool Ball::IsMoving() const
-{
-    return Velocity.LengthSquared() > VELOCITY_THRESHOLD * VELOCITY_THRESHOLD;
-}
-
-void Ball::Stop()
-{
-    Velocity = Vec3(0.0f, 0.0f, 0.0f);
+    return Mat4::Translate(GetPosition()) * Mat4::Scale(GetRadius());
 }
 
 // ============================================================================
 // BALL SET CREATION
 // ============================================================================
 
-std::vector<Ball*> CreateStandardBallSet(float ballRadius)
+std::vector<Ball> CreateStandardBallSet(BallStore& store, float ballRadius)
 {
-    std::vector<Ball*> balls;
-
     Vec3 colors[] = {
         Vec3(1.0f, 1.0f, 1.0f),    // 0: Cue ball (white)
         Vec3(1.0f, 0.85f, 0.0f),   // 1: Yellow
@@ -111,40 +80,14 @@ std::vector<Ball*> CreateStandardBallSet(float ballRadius)
         Vec3(0.7f, 0.3f, 0.3f)     // 15: Maroon stripe (lighter)
     };
 
-    float diameter = ballRadius * 2.0f;
-    float rowSpacing = diameter * 0.866f;
+    int first = store.Size();
+    AddStandardRack(store, ballRadius);
 
-    float rackX = 0.0f;
-    float rackZ = -1.5f;
-
-    int ballOrder[] = {
-        1,
-        2, 3,
-        4, 8, 5,
-        6, 7, 9, 10,
-        11, 12, 13, 14, 15
-    };
-
-    int ballIndex = 0;
-    for (int row = 0; row < 5; row++)
+    std::vector<Ball> balls;
+    for (int i = first; i < store.Size(); i++)
     {
-        int ballsInRow = row + 1;
-        float rowZ = rackZ - row * rowSpacing;
-        float startX = rackX - (ballsInRow - 1) * ballRadius;
-
-        for (int i = 0; i < ballsInRow; i++)
-        {
-            int num = ballOrder[ballIndex];
-            float x = startX + i * diameter;
-            Vec3 pos(x, ballRadius, rowZ);
-            balls.push_back(new Ball(num, pos, ballRadius, colors[num]));
-            ballIndex++;
-        }
+        balls.push_back(Ball(&store, i, colors[store.Number[i]]));
     }
 
-    // Add cue ball
-    Vec3 cuePos(0.0f, ballRadius, 2.5f);
-    balls.insert(balls.begin(), new Ball(0, cuePos, ballRadius, colors[0]));
-
     return balls;
 }
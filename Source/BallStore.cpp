@@ -0,0 +1,275 @@
+#include "../Header/BallStore.h"
+#include <cstring>
+
+// Field arrays start on this boundary so full SIMD loads stay aligned
+static const size_t BLOCK_ALIGNMENT = 32;
+
+BallStore::BallStore()
+    : PosX(nullptr)
+    , PosZ(nullptr)
+    , VelX(nullptr)
+    , VelZ(nullptr)
+    , Radius(nullptr)
+    , Active(nullptr)
+    , Number(nullptr)
+    , Awake(nullptr)
+    , AwakeList(nullptr)
+    , AwakeCount(0)
+    , Count(0)
+    , Capacity(0)
+{
+}
+
+BallStore::BallStore(const BallStore& other)
+    : BallStore()
+{
+    *this = other;
+}
+
+BallStore& BallStore::operator=(const BallStore& other)
+{
+    if (this == &other)
+        return *this;
+
+    Count = 0;
+    Reserve(other.Capacity);
+    Count = other.Count;
+
+    // Fields are laid out by capacity, so copying field by field keeps any capacity difference valid
+    size_t bytes = (size_t)Count * 4;
+    if (bytes > 0)
+    {
+        std::memcpy(PosX, other.PosX, bytes);
+        std::memcpy(PosZ, other.PosZ, bytes);
+        std::memcpy(VelX, other.VelX, bytes);
+        std::memcpy(VelZ, other.VelZ, bytes);
+        std::memcpy(Radius, other.Radius, bytes);
+        std::memcpy(Active, other.Active, bytes);
+        std::memcpy(Number, other.Number, bytes);
+        std::memcpy(Awake, other.Awake, bytes);
+    }
+    AwakeCount = other.AwakeCount;
+    if (AwakeCount > 0)
+        std::memcpy(AwakeList, other.AwakeList, (size_t)AwakeCount * 4);
+    return *this;
+}
+
+int BallStore::Add(int number, const Vec3& position, float radius)
+{
+    if (Count == Capacity)
+        Reserve(Capacity == 0 ? 16 : Capacity * 2);
+
+    int i = Count++;
+    PosX[i] = position.x;
+    PosZ[i] = position.z;
+    VelX[i] = 0.0f;
+    VelZ[i] = 0.0f;
+    Radius[i] = radius;
+    Active[i] = ACTIVE;
+    Number[i] = number;
+    Awake[i] = ASLEEP;
+    return i;
+}
+
+void BallStore::Clear()
+{
+    Count = 0;
+    AwakeCount = 0;
+}
+
+void BallStore::Reserve(int capacity)
+{
+    // Round up to whole 8-wide lanes
+    capacity = (capacity + 7) & ~7;
+    if (capacity <= Capacity)
+        return;
+
+    BallStore old;
+    old.Block.swap(Block);
+    old.Count = Count;
+    old.Capacity = Capacity;
+    old.BindFields();
+
+    Capacity = capacity;
+    Block.assign((size_t)Capacity * NUM_FIELDS * 4 + BLOCK_ALIGNMENT, 0);
+    BindFields();
+
+    if (Count > 0)
+    {
+        size_t bytes = (size_t)Count * 4;
+        std::memcpy(PosX, old.PosX, bytes);
+        std::memcpy(PosZ, old.PosZ, bytes);
+        std::memcpy(VelX, old.VelX, bytes);
+        std::memcpy(VelZ, old.VelZ, bytes);
+        std::memcpy(Radius, old.Radius, bytes);
+        std::memcpy(Active, old.Active, bytes);
+        std::memcpy(Number, old.Number, bytes);
+        std::memcpy(Awake, old.Awake, bytes);
+    }
+    if (AwakeCount > 0)
+        std::memcpy(AwakeList, old.AwakeList, (size_t)AwakeCount * 4);
+}
+
+void BallStore::SetVelocity(int i, const Vec3& velocity)
+{
+    VelX[i] = velocity.x;
+    VelZ[i] = velocity.z;
+    Wake(i);
+}
+
+void BallStore::Wake(int i)
+{
+    if (Awake[i] != ASLEEP)
+        return;
+
+    Awake[i] = AWAKE;
+    AwakeList[AwakeCount++] = i;
+}
+
+void BallStore::Sleep(int i)
+{
+    if (Awake[i] == ASLEEP)
+        return;
+
+    Awake[i] = ASLEEP;
+    for (int k = 0; k < AwakeCount; k++)
+    {
+        if (AwakeList[k] == i)
+        {
+            std::memmove(AwakeList + k, AwakeList + k + 1, (size_t)(AwakeCount - k - 1) * 4);
+            AwakeCount--;
+            break;
+        }
+    }
+}
+
+void BallStore::SleepSlowBalls(float minVelocity)
+{
+    float minSq = minVelocity * minVelocity;
+
+    // Compact the list in place, keeping wake order
+    int kept = 0;
+    for (int k = 0; k < AwakeCount; k++)
+    {
+        int i = AwakeList[k];
+        if (IsActive(i) && !(VelX[i] * VelX[i] + VelZ[i] * VelZ[i] < minSq))
+        {
+            AwakeList[kept++] = i;
+            continue;
+        }
+
+        Stop(i);
+        Awake[i] = ASLEEP;
+    }
+    AwakeCount = kept;
+}
+
+bool BallStore::IsMoving(int i) const
+{
+    return VelX[i] * VelX[i] + VelZ[i] * VelZ[i] > VELOCITY_THRESHOLD * VELOCITY_THRESHOLD;
+}
+
+int BallStore::FindBall(int number) const
+{
+    for (int i = 0; i < Count; i++)
+    {
+        if (Number[i] == number)
+            return i;
+    }
+    return -1;
+}
+
+uint64_t BallStore::ComputeHash() const
+{
+    // FNV-1a over the raw bytes of each field, so -0.0 and 0.0 hash differently
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t bytes)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < bytes; i++)
+        {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    size_t bytes = (size_t)Count * 4;
+    mix(&Count, sizeof(Count));
+    if (Count > 0)
+    {
+        mix(PosX, bytes);
+        mix(PosZ, bytes);
+        mix(VelX, bytes);
+        mix(VelZ, bytes);
+        mix(Active, bytes);
+        mix(Number, bytes);
+    }
+    return hash;
+}
+
+void BallStore::BindFields()
+{
+    if (Block.empty())
+    {
+        PosX = PosZ = VelX = VelZ = Radius = nullptr;
+        Active = Awake = nullptr;
+        Number = AwakeList = nullptr;
+        return;
+    }
+
+    uintptr_t base = (uintptr_t)Block.data();
+    base = (base + BLOCK_ALIGNMENT - 1) & ~(uintptr_t)(BLOCK_ALIGNMENT - 1);
+    size_t stride = (size_t)Capacity * 4;
+
+    unsigned char* p = (unsigned char*)base;
+    PosX   = (float*)(p + 0 * stride);
+    PosZ   = (float*)(p + 1 * stride);
+    VelX   = (float*)(p + 2 * stride);
+    VelZ   = (float*)(p + 3 * stride);
+    Radius = (float*)(p + 4 * stride);
+    Active = (uint32_t*)(p + 5 * stride);
+    Number = (int*)(p + 6 * stride);
+    Awake  = (uint32_t*)(p + 7 * stride);
+    AwakeList = (int*)(p + 8 * stride);
+}
+
+// ============================================================================
+// STANDARD RACK
+// ============================================================================
+
+void AddStandardRack(BallStore& store, float ballRadius)
+{
+    store.Reserve(store.Size() + 16);
+
+    // Cue ball
+    store.Add(0, Vec3(0.0f, ballRadius, 2.5f), ballRadius);
+
+    float diameter = ballRadius * 2.0f;
+    float rowSpacing = diameter * 0.866f;
+
+    float rackX = 0.0f;
+    float rackZ = -1.5f;
+
+    int ballOrder[] = {
+        1,
+        2, 3,
+        4, 8, 5,
+        6, 7, 9, 10,
+        11, 12, 13, 14, 15
+    };
+
+    int ballIndex = 0;
+    for (int row = 0; row < 5; row++)
+    {
+        int ballsInRow = row + 1;
+        float rowZ = rackZ - row * rowSpacing;
+        float startX = rackX - (ballsInRow - 1) * ballRadius;
+
+        for (int i = 0; i < ballsInRow; i++)
+        {
+            float x = startX + i * diameter;
+            store.Add(ballOrder[ballIndex], Vec3(x, ballRadius, rowZ), ballRadius);
+            ballIndex++;
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include "../Header/BatchSimulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Default step: the game's physics tick rate
+static const float DEFAULT_TIME_STEP = 1.0f / 240.0f;
+
+// Default step limit: two simulated minutes, far longer than any shot
+static const int DEFAULT_MAX_STEPS = 240 * 120;
+
+BatchSimulator::BatchSimulator(int threadCount)
+    : TimeStep(DEFAULT_TIME_STEP)
+    , MaxSteps(DEFAULT_MAX_STEPS)
+    , ThreadCount(0)
+    , LastThreadsUsed(0)
+    , LastShotsPerSecond(0.0)
+{
+    SetThreadCount(threadCount);
+}
+
+std::vector<BatchResult> BatchSimulator::Run(const TableGeometry& table,
+                                             const std::vector<BallStore>& states,
+                                             const std::vector<BatchShot>& shots)
+{
+    int jobCount = (int)std::min(states.size(), shots.size());
+    std::vector<BatchResult> results(jobCount);
+
+    int threadCount = std::min(ThreadCount, jobCount);
+    LastThreadsUsed = threadCount;
+    LastShotsPerSecond = 0.0;
+    if (jobCount == 0)
+        return results;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Each worker claims the next unclaimed job until none are left
+    std::atomic<int> nextJob(0);
+    auto worker = [&]()
+    {
+        Physics physics(Prototype);
+        for (int job = nextJob++; job < jobCount; job = nextJob++)
+            RunShot(physics, table, states[job], shots[job], results[job]);
+    };
+
+    // The calling thread works too, so one thread means no spawning at all
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& t : threads)
+        t.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() > 0.0)
+        LastShotsPerSecond = jobCount / elapsed.count();
+
+    return results;
+}
+
+void BatchSimulator::RunShot(Physics& physics, const TableGeometry& table, const BallStore& state,
+                             const BatchShot& shot, BatchResult& result) const
+{
+    result.Balls = state;
+    result.Events.clear();
+
+    physics.SetEventLog(&result.Events);
+    physics.ApplyImpulse(result.Balls, shot.Ball, shot.Direction, shot.Power);
+    result.Steps = physics.RunToRest(result.Balls, table, TimeStep, MaxSteps);
+    result.Stopped = physics.AllBallsStopped(result.Balls);
+    physics.SetEventLog(nullptr);
+}
+
+Physics& BatchSimulator::GetPhysics()
+{
+    return Prototype;
+}
+
+void BatchSimulator::SetTimeStep(float deltaTime)
+{
+    TimeStep = deltaTime;
+}
+
+float BatchSimulator::GetTimeStep() const
+{
+    return TimeStep;
+}
+
+void BatchSimulator::SetMaxSteps(int maxSteps)
+{
+    MaxSteps = maxSteps;
+}
+
+int BatchSimulator::GetMaxSteps() const
+{
+    return MaxSteps;
+}
+
+void BatchSimulator::SetThreadCount(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    ThreadCount = threadCount > 0 ? threadCount : 1;
+}
+
+int BatchSimulator::GetThreadCount() const
+{
+    return ThreadCount;
+}
+
+double BatchSimulator::GetShotsPerSecond() const
+{
+    return LastShotsPerSecond;
+}
+
+double BatchSimulator::GetShotsPerSecondPerCore() const
+{
+    return LastThreadsUsed > 0 ? LastShotsPerSecond / LastThreadsUsed : 0.0;
+}
@@ -0,0 +1,101 @@
+#include "../Header/CushionBVH.h"
+#include <algorithm>
+
+// Query stack size (the tree is balanced, so it needs about log2 of the segment count)
+static const int MAX_QUERY_DEPTH = 64;
+
+void CushionBVH::Build(const std::vector<CushionSegment>& segments)
+{
+    Segments = segments;
+    Nodes.clear();
+
+    if (Segments.empty())
+        return;
+
+    // A balanced binary tree over n leaves has fewer than 2n nodes
+    Nodes.reserve(Segments.size() * 2);
+    Nodes.push_back(Node());
+    BuildNode(0, 0, (int)Segments.size());
+}
+
+void CushionBVH::BuildNode(int node, int first, int count)
+{
+    float minX = Segments[first].AX, maxX = minX;
+    float minZ = Segments[first].AZ, maxZ = minZ;
+    float centerMinX = 1e30f, centerMaxX = -1e30f;
+    float centerMinZ = 1e30f, centerMaxZ = -1e30f;
+    for (int i = first; i < first + count; i++)
+    {
+        const CushionSegment& s = Segments[i];
+        minX = std::min(minX, std::min(s.AX, s.BX));
+        maxX = std::max(maxX, std::max(s.AX, s.BX));
+        minZ = std::min(minZ, std::min(s.AZ, s.BZ));
+        maxZ = std::max(maxZ, std::max(s.AZ, s.BZ));
+
+        float cx = (s.AX + s.BX) * 0.5f;
+        float cz = (s.AZ + s.BZ) * 0.5f;
+        centerMinX = std::min(centerMinX, cx);
+        centerMaxX = std::max(centerMaxX, cx);
+        centerMinZ = std::min(centerMinZ, cz);
+        centerMaxZ = std::max(centerMaxZ, cz);
+    }
+
+    Nodes[node].MinX = minX;
+    Nodes[node].MinZ = minZ;
+    Nodes[node].MaxX = maxX;
+    Nodes[node].MaxZ = maxZ;
+
+    if (count <= MAX_LEAF_SEGMENTS)
+    {
+        Nodes[node].First = first;
+        Nodes[node].Count = count;
+        return;
+    }
+
+    // Split at the median center along the axis the centers spread furthest
+    bool splitX = centerMaxX - centerMinX >= centerMaxZ - centerMinZ;
+    int half = count / 2;
+    std::nth_element(Segments.begin() + first, Segments.begin() + first + half, Segments.begin() + first + count,
+                     [splitX](const CushionSegment& a, const CushionSegment& b)
+    {
+        return splitX ? a.AX + a.BX < b.AX + b.BX : a.AZ + a.BZ < b.AZ + b.BZ;
+    });
+
+    int left = (int)Nodes.size();
+    Nodes.push_back(Node());
+    Nodes.push_back(Node());
+    Nodes[node].First = left;
+    Nodes[node].Count = 0;
+
+    BuildNode(left, first, half);
+    BuildNode(left + 1, first + half, count - half);
+}
+
+void CushionBVH::Query(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const
+{
+    out.clear();
+    if (Nodes.empty())
+        return;
+
+    int stack[MAX_QUERY_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& n = Nodes[stack[--top]];
+        if (n.MinX > maxX || n.MaxX < minX || n.MinZ > maxZ || n.MaxZ < minZ)
+            continue;
+
+        if (n.Count > 0)
+        {
+            for (int i = n.First; i < n.First + n.Count; i++)
+                out.push_back(i);
+        }
+        else if (top + 2 <= MAX_QUERY_DEPTH)
+        {
+            stack[top++] = n.First + 1;
+            stack[top++] = n.First;
+        }
+    }
+}
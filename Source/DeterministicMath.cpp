@@ -0,0 +1,191 @@
+#include "../Header/DeterministicMath.h"
+#include <cmath>
+#include <limits>
+
+// ln(2) split so that k * LN2_HI is exact for the k used in range reduction
+static const double LN2_HI = 6.93147180369123816490e-01;
+static const double LN2_LO = 1.90821492927058770002e-10;
+static const double INV_LN2 = 1.44269504088896338700e+00;
+static const double SQRT_HALF = 0.70710678118654752440;
+
+// pi / 2 split in three so that k * PIO2_1 and k * PIO2_2 are exact for the k used in range reduction
+static const double PIO2_1 = 1.57079632673412561417e+00;
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624879595063154e-21;
+static const double INV_PIO2 = 6.36619772367581382433e-01;
+static const double PI_VALUE = 3.14159265358979311600e+00;
+static const double PI_HALF = 1.57079632679489655800e+00;
+static const double PI_QUARTER = 7.85398163397448278999e-01;
+
+// tan(pi / 8): atan arguments above it are reduced around pi / 4
+static const double TAN_PI_8 = 4.14213562373095034514e-01;
+
+// Beyond these e^x overflows / underflows double precision
+static const double EXP_MAX_ARG = 709.0;
+static const double EXP_MIN_ARG = -745.0;
+
+namespace DeterministicMath
+{
+
+double Exp(double x)
+{
+    if (x != x)
+        return x;
+    if (x > EXP_MAX_ARG)
+        return std::numeric_limits<double>::infinity();
+    if (x < EXP_MIN_ARG)
+        return 0.0;
+
+    // x = k ln2 + r with |r| <= ln2 / 2, so e^x = 2^k e^r
+    double k = std::floor(x * INV_LN2 + 0.5);
+    double r = (x - k * LN2_HI) - k * LN2_LO;
+
+    // Taylor series of e^r, evaluated in Horner form (|r|^14 / 14! < 1e-19)
+    double p = 1.0;
+    for (int n = 13; n >= 1; n--)
+        p = 1.0 + p * r / n;
+
+    return std::ldexp(p, (int)k);
+}
+
+double Log(double x)
+{
+    if (x != x || x < 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    if (x == 0.0)
+        return -std::numeric_limits<double>::infinity();
+    if (x == std::numeric_limits<double>::infinity())
+        return x;
+
+    // x = m 2^e with m in [sqrt(1/2), sqrt(2))
+    int e;
+    double m = std::frexp(x, &e);
+    if (m < SQRT_HALF)
+    {
+        m *= 2.0;
+        e--;
+    }
+
+    // ln(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double series = 0.0;
+    for (int n = 25; n >= 3; n -= 2)
+        series = (series + 1.0 / n) * s2;
+    double lnM = 2.0 * s * (1.0 + series);
+
+    return (e * LN2_HI + lnM) + e * LN2_LO;
+}
+
+float Pow(float base, float exponent)
+{
+    return (float)Exp((double)exponent * Log((double)base));
+}
+
+/**
+ * sin(r) and cos(r) for |r| <= pi / 4 (Taylor series in Horner form, |r|^24 / 24! < 1e-25)
+ */
+static double SinReduced(double r)
+{
+    double r2 = r * r;
+    double p = 1.0;
+    for (int n = 11; n >= 1; n--)
+        p = 1.0 - p * r2 / ((2 * n) * (2 * n + 1));
+    return r * p;
+}
+
+static double CosReduced(double r)
+{
+    double r2 = r * r;
+    double p = 1.0;
+    for (int n = 11; n >= 1; n--)
+        p = 1.0 - p * r2 / ((2 * n - 1) * (2 * n));
+    return p;
+}
+
+/**
+ * x = k pi / 2 + r with |r| <= pi / 4
+ * @return k modulo 4 (the quadrant)
+ */
+static int ReduceQuarterTurns(double x, double& r)
+{
+    double k = std::floor(x * INV_PIO2 + 0.5);
+    r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+    return (int)(k - 4.0 * std::floor(k * 0.25));
+}
+
+double Sin(double x)
+{
+    if (x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    double r;
+    switch (ReduceQuarterTurns(x, r))
+    {
+    case 0: return SinReduced(r);
+    case 1: return CosReduced(r);
+    case 2: return -SinReduced(r);
+    default: return -CosReduced(r);
+    }
+}
+
+double Cos(double x)
+{
+    if (x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    double r;
+    switch (ReduceQuarterTurns(x, r))
+    {
+    case 0: return CosReduced(r);
+    case 1: return -SinReduced(r);
+    case 2: return -CosReduced(r);
+    default: return SinReduced(r);
+    }
+}
+
+/**
+ * atan(t) for 0 <= t <= 1
+ */
+static double AtanUnit(double t)
+{
+    // Around pi / 4 above tan(pi / 8): atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+    double offset = 0.0;
+    if (t > TAN_PI_8)
+    {
+        offset = PI_QUARTER;
+        t = (t - 1.0) / (t + 1.0);
+    }
+
+    // Halve the angle once (sqrt is correctly rounded): |u| <= 0.1989
+    double u = t / (1.0 + std::sqrt(1.0 + t * t));
+
+    // atan(u) = u - u^3 / 3 + u^5 / 5 - ... (|u|^29 / 29 < 1e-21)
+    double u2 = u * u;
+    double series = 0.0;
+    for (int n = 27; n >= 3; n -= 2)
+        series = (1.0 / n - series) * u2;
+    return offset + 2.0 * (u - u * series);
+}
+
+double Atan2(double y, double x)
+{
+    if (x != x || y != y)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    double ax = std::fabs(x);
+    double ay = std::fabs(y);
+    double angle;
+    if (ay == 0.0 && ax == 0.0)
+        angle = 0.0;
+    else if (ay <= ax)
+        angle = AtanUnit(ay / ax);
+    else
+        angle = PI_HALF - AtanUnit(ax / ay);
+
+    if (x < 0.0 || (x == 0.0 && std::signbit(x)))
+        angle = PI_VALUE - angle;
+    return std::signbit(y) ? -angle : angle;
+}
+
+}
@@ -0,0 +1,227 @@
+#include "../Header/DistanceField.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+static const char FIELD_MAGIC[4] = { 'B', 'S', 'D', 'F' };
+
+// Bumped whenever the bake or the file layout changes, so old caches are rebaked
+static const uint32_t FIELD_VERSION = 1;
+
+DistanceField::DistanceField()
+    : OriginX(0.0f)
+    , OriginZ(0.0f)
+    , InvCellSize(1.0f)
+    , Columns(0)
+    , Rows(0)
+    , MaxCoordX(0.0f)
+    , MaxCoordZ(0.0f)
+{
+}
+
+void DistanceField::SetLayout(float originX, float originZ, float cellSize, int columns, int rows)
+{
+    OriginX = originX;
+    OriginZ = originZ;
+    InvCellSize = 1.0f / cellSize;
+    Columns = columns;
+    Rows = rows;
+
+    // Stay just below the last node so bilinear sampling never reads past it
+    MaxCoordX = (float)(columns - 1) * 0.99999f;
+    MaxCoordZ = (float)(rows - 1) * 0.99999f;
+
+    Nodes.assign((size_t)columns * rows, Node());
+}
+
+void DistanceField::Clear()
+{
+    Nodes.clear();
+    Nodes.shrink_to_fit();
+    Columns = 0;
+    Rows = 0;
+}
+
+void DistanceField::Bake(const CushionBVH& cushions, float minX, float minZ, float maxX, float maxZ,
+                         float cellSize, int threadCount)
+{
+    int columns = (int)std::ceil((maxX - minX) / cellSize) + 1;
+    int rows = (int)std::ceil((maxZ - minZ) / cellSize) + 1;
+    SetLayout(minX, minZ, cellSize, columns < 2 ? 2 : columns, rows < 2 ? 2 : rows);
+
+    const CushionSegment* segments = cushions.GetSegments();
+    int numSegments = cushions.GetSegmentCount();
+
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+    if (threadCount > Rows)
+        threadCount = Rows;
+
+    // Each worker claims the next unbaked row until none are left
+    std::atomic<int> nextRow(0);
+    auto worker = [&]()
+    {
+        for (int row = nextRow++; row < Rows; row = nextRow++)
+        {
+            double z = OriginZ + row * (double)cellSize;
+            for (int col = 0; col < Columns; col++)
+            {
+                double x = OriginX + col * (double)cellSize;
+
+                // Nearest boundary point, and the parity of boundary crossings along +X
+                double bestSq = 1e30;
+                double nearX = x;
+                double nearZ = z;
+                bool inside = false;
+
+                for (int s = 0; s < numSegments; s++)
+                {
+                    const CushionSegment& seg = segments[s];
+                    double dx = (double)seg.BX - seg.AX;
+                    double dz = (double)seg.BZ - seg.AZ;
+                    double lenSq = dx * dx + dz * dz;
+                    double t = lenSq > 0.0 ? ((x - seg.AX) * dx + (z - seg.AZ) * dz) / lenSq : 0.0;
+                    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+
+                    double px = seg.AX + dx * t;
+                    double pz = seg.AZ + dz * t;
+                    double distSq = (x - px) * (x - px) + (z - pz) * (z - pz);
+                    if (distSq < bestSq)
+                    {
+                        bestSq = distSq;
+                        nearX = px;
+                        nearZ = pz;
+                    }
+
+                    if ((seg.AZ > z) != (seg.BZ > z))
+                    {
+                        double crossX = seg.AX + (z - seg.AZ) * dx / dz;
+                        if (x < crossX)
+                            inside = !inside;
+                    }
+                }
+
+                double dist = std::sqrt(bestSq);
+                double sign = inside ? 1.0 : -1.0;
+                Node& node = Nodes[(size_t)row * Columns + col];
+                node.Distance = (float)(dist * sign);
+
+                // Away from the nearest boundary point inside, toward it outside: always into the table
+                if (dist > 1e-9)
+                {
+                    node.GradX = (int16_t)std::lround(sign * (x - nearX) / dist * 32767.0);
+                    node.GradZ = (int16_t)std::lround(sign * (z - nearZ) / dist * 32767.0);
+                }
+                else
+                {
+                    node.GradX = 0;
+                    node.GradZ = 0;
+                }
+            }
+        }
+    };
+
+    // The calling thread works too, so one thread means no spawning at all
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& t : threads)
+        t.join();
+}
+
+/**
+ * Fold bytes into an FNV-1a hash
+ */
+static void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+uint64_t DistanceField::ComputeKey(const CushionBVH& cushions, float minX, float minZ, float maxX, float maxZ,
+                                   float cellSize)
+{
+    uint64_t hash = 1469598103934665603ull;
+    HashBytes(hash, &FIELD_VERSION, sizeof(FIELD_VERSION));
+    const float layout[5] = { minX, minZ, maxX, maxZ, cellSize };
+    HashBytes(hash, layout, sizeof(layout));
+
+    const CushionSegment* segments = cushions.GetSegments();
+    for (int s = 0; s < cushions.GetSegmentCount(); s++)
+    {
+        const float points[4] = { segments[s].AX, segments[s].AZ, segments[s].BX, segments[s].BZ };
+        HashBytes(hash, points, sizeof(points));
+    }
+    return hash;
+}
+
+bool DistanceField::Save(const char* path, uint64_t key) const
+{
+    if (!IsBaked())
+        return false;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    // Native byte order: cache files are not meant to move between machines
+    float cellSize = GetCellSize();
+    file.write(FIELD_MAGIC, 4);
+    file.write((const char*)&FIELD_VERSION, sizeof(FIELD_VERSION));
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&Columns, sizeof(Columns));
+    file.write((const char*)&Rows, sizeof(Rows));
+    file.write((const char*)&OriginX, sizeof(OriginX));
+    file.write((const char*)&OriginZ, sizeof(OriginZ));
+    file.write((const char*)&cellSize, sizeof(cellSize));
+    file.write((const char*)Nodes.data(), (std::streamsize)GetMemoryBytes());
+    return file.good();
+}
+
+bool DistanceField::Load(const char* path, uint64_t key)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t fileKey = 0;
+    int columns = 0;
+    int rows = 0;
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    float cellSize = 0.0f;
+
+    file.read(magic, 4);
+    file.read((char*)&version, sizeof(version));
+    file.read((char*)&fileKey, sizeof(fileKey));
+    file.read((char*)&columns, sizeof(columns));
+    file.read((char*)&rows, sizeof(rows));
+    file.read((char*)&originX, sizeof(originX));
+    file.read((char*)&originZ, sizeof(originZ));
+    file.read((char*)&cellSize, sizeof(cellSize));
+
+    if (!file.good() || std::memcmp(magic, FIELD_MAGIC, 4) != 0 || version != FIELD_VERSION || fileKey != key ||
+        columns < 2 || rows < 2 || columns > 1 << 14 || rows > 1 << 14 || !(cellSize > 0.0f))
+        return false;
+
+    SetLayout(originX, originZ, cellSize, columns, rows);
+    file.read((char*)Nodes.data(), (std::streamsize)GetMemoryBytes());
+    if (!file.good())
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
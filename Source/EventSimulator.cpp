@@ -0,0 +1,690 @@
+#include "../Header/EventSimulator.h"
+#include "../Header/Physics.h"
+#include "../Header/RollingMotion.h"
+#include <cmath>
+#include <limits>
+
+// Gap below which two balls count as touching
+static const double CONTACT_TOLERANCE = 1e-9;
+
+// Closing speed below which touching balls are treated as resting against each other
+static const double MIN_CLOSING_SPEED = 1e-6;
+
+// Time skipped past a touching pair that is already separating
+static const double SEPARATION_STEP = 1e-4;
+
+// Root-finding iterations before a contact search is deferred to a PairRecheck event
+static const int MAX_CONTACT_ITERATIONS = 64;
+
+// Distance a ball is moved past the edge of a pocket gap before cushions apply again
+static const double GAP_EXIT_MARGIN = 1e-6;
+
+static const double NEVER = std::numeric_limits<double>::infinity();
+
+/**
+ * Squared distance from point p to segment [a, b] in the XZ plane
+ */
+static double PointSegmentDistanceSq(double px, double pz, double ax, double az, double bx, double bz)
+{
+    double ex = bx - ax;
+    double ez = bz - az;
+    double lenSq = ex * ex + ez * ez;
+    double t = 0.0;
+    if (lenSq > 0.0)
+    {
+        t = ((px - ax) * ex + (pz - az) * ez) / lenSq;
+        if (t < 0.0) t = 0.0;
+        if (t > 1.0) t = 1.0;
+    }
+    double dx = px - (ax + ex * t);
+    double dz = pz - (az + ez * t);
+    return dx * dx + dz * dz;
+}
+
+/**
+ * Squared distance between segments [a0, a1] and [b0, b1] in the XZ plane
+ */
+static double SegmentDistanceSq(double a0x, double a0z, double a1x, double a1z,
+                                double b0x, double b0z, double b1x, double b1z)
+{
+    // Proper crossing: the endpoints of each segment lie on opposite sides of the other
+    double ax = a1x - a0x, az = a1z - a0z;
+    double bx = b1x - b0x, bz = b1z - b0z;
+    double s0 = ax * (b0z - a0z) - az * (b0x - a0x);
+    double s1 = ax * (b1z - a0z) - az * (b1x - a0x);
+    double s2 = bx * (a0z - b0z) - bz * (a0x - b0x);
+    double s3 = bx * (a1z - b0z) - bz * (a1x - b0x);
+    if (((s0 < 0.0 && s1 > 0.0) || (s0 > 0.0 && s1 < 0.0)) &&
+        ((s2 < 0.0 && s3 > 0.0) || (s2 > 0.0 && s3 < 0.0)))
+        return 0.0;
+
+    double d = PointSegmentDistanceSq(a0x, a0z, b0x, b0z, b1x, b1z);
+    double e = PointSegmentDistanceSq(a1x, a1z, b0x, b0z, b1x, b1z);
+    double f = PointSegmentDistanceSq(b0x, b0z, a0x, a0z, a1x, a1z);
+    double g = PointSegmentDistanceSq(b1x, b1z, a0x, a0z, a1x, a1z);
+    if (e < d) d = e;
+    if (f < d) d = f;
+    if (g < d) d = g;
+    return d;
+}
+
+/**
+ * Distances along a ray (unit direction) at which it enters and leaves a circle
+ * @return false if the ray's line misses the circle
+ */
+static bool RayCircle(double x, double z, double dirX, double dirZ,
+                      double cx, double cz, double radius, double& enter, double& exit)
+{
+    double ox = x - cx;
+    double oz = z - cz;
+    double b = ox * dirX + oz * dirZ;
+    double c = ox * ox + oz * oz - radius * radius;
+    double disc = b * b - c;
+    if (disc < 0.0)
+        return false;
+    double root = std::sqrt(disc);
+    enter = -b - root;
+    exit = -b + root;
+    return true;
+}
+
+EventSimulator::EventSimulator()
+    : TablePtr(nullptr)
+    , Now(0.0)
+    , EventCount(0)
+{
+}
+
+void EventSimulator::Reset(const BallStore& balls, const TableGeometry& table)
+{
+    TablePtr = &table;
+    Now = 0.0;
+    EventCount = 0;
+    Queue = std::priority_queue<Event>();
+
+    int numBalls = balls.Size();
+    Balls.assign(numBalls, Motion());
+    for (int i = 0; i < numBalls; i++)
+    {
+        Motion& m = Balls[i];
+        m.Radius = balls.Radius[i];
+        m.Active = balls.IsActive(i);
+        m.Number = balls.Number[i];
+        m.Stamp = 0;
+        SetMotion(i, balls.PosX[i], balls.PosZ[i], balls.VelX[i], balls.VelZ[i]);
+    }
+
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (!Balls[i].Active)
+            continue;
+
+        ScheduleBallEvents(i);
+        for (int j = i + 1; j < numBalls; j++)
+        {
+            if (Balls[j].Active)
+                SchedulePair(i, j, Now);
+        }
+    }
+}
+
+void EventSimulator::Advance(BallStore& balls, float duration)
+{
+    double endTime = Now + duration;
+    while (ProcessNextEvent(endTime))
+    {
+    }
+    Now = endTime;
+    WriteState(balls);
+}
+
+int EventSimulator::RunToRest(BallStore& balls, int maxEvents)
+{
+    int processed = 0;
+    while (processed < maxEvents && ProcessNextEvent(NEVER))
+        processed++;
+
+    WriteState(balls);
+    return processed;
+}
+
+bool EventSimulator::AllBallsStopped(const BallStore& balls) const
+{
+    int numBalls = balls.Size();
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (balls.IsActive(i) && balls.IsMoving(i))
+            return false;
+    }
+    return true;
+}
+
+double EventSimulator::GetTime() const
+{
+    return Now;
+}
+
+int EventSimulator::GetEventCount() const
+{
+    return EventCount;
+}
+
+// ============================================================================
+// MOTION
+// ============================================================================
+
+void EventSimulator::PositionAt(int i, double t, double& x, double& z) const
+{
+    const Motion& m = Balls[i];
+    x = m.StartX;
+    z = m.StartZ;
+    if (m.Speed <= 0.0)
+        return;
+
+    double end = t < m.StopTime ? t : m.StopTime;
+    double d = RollingMotion::DistanceAt(m.Speed, end - m.StartTime);
+    x += m.DirX * d;
+    z += m.DirZ * d;
+}
+
+void EventSimulator::VelocityAt(int i, double t, double& vx, double& vz) const
+{
+    const Motion& m = Balls[i];
+    if (m.Speed <= 0.0 || t >= m.StopTime)
+    {
+        vx = 0.0;
+        vz = 0.0;
+        return;
+    }
+
+    double s = RollingMotion::SpeedAt(m.Speed, t - m.StartTime);
+    vx = m.DirX * s;
+    vz = m.DirZ * s;
+}
+
+void EventSimulator::SetMotion(int i, double x, double z, double vx, double vz)
+{
+    Motion& m = Balls[i];
+    m.StartTime = Now;
+    m.StartX = x;
+    m.StartZ = z;
+    m.Stamp++;
+
+    double len = std::sqrt(vx * vx + vz * vz);
+    double speed = len;
+    if (speed > PhysicsConstants::MAX_VELOCITY)
+        speed = PhysicsConstants::MAX_VELOCITY;
+
+    if (speed < PhysicsConstants::MIN_VELOCITY)
+    {
+        m.DirX = 0.0;
+        m.DirZ = 0.0;
+        m.Speed = 0.0;
+        m.StopTime = Now;
+        return;
+    }
+
+    m.DirX = vx / len;
+    m.DirZ = vz / len;
+    m.Speed = speed;
+    m.StopTime = Now + RollingMotion::TimeToSpeed(speed, PhysicsConstants::MIN_VELOCITY);
+}
+
+// ============================================================================
+// EVENT PREDICTION
+// ============================================================================
+
+void EventSimulator::ScheduleBallEvents(int i)
+{
+    const Motion& m = Balls[i];
+    if (!m.Active || m.Speed <= 0.0)
+        return;
+
+    const TableGeometry& table = *TablePtr;
+    double rollTime = m.StopTime - m.StartTime;
+    double rollDistance = RollingMotion::DistanceAt(m.Speed, rollTime);
+
+    // Rest
+    Queue.push({ m.StopTime, EventType::Rest, i, -1, m.Stamp, 0 });
+
+    // Pockets: first entry of the center into a pocket circle
+    const Vec3* pockets = table.GetPocketPositions();
+    double pocketDistance = NEVER;
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        double enter, exit;
+        if (!RayCircle(m.StartX, m.StartZ, m.DirX, m.DirZ, pockets[p].x, pockets[p].z,
+                       table.GetPocketRadius(), enter, exit))
+            continue;
+        if (exit < 0.0)
+            continue;
+        if (enter < 0.0)
+            enter = 0.0;
+        if (enter < pocketDistance)
+            pocketDistance = enter;
+    }
+    if (pocketDistance <= rollDistance)
+    {
+        double t = RollingMotion::TimeAtDistance(m.Speed, pocketDistance, rollTime);
+        Queue.push({ m.StartTime + t, EventType::Pocket, i, -1, m.Stamp, 0 });
+    }
+
+    // Cushions: nearest rail the ball is moving towards
+    double r = m.Radius;
+    double railDistance = NEVER;
+    if (m.DirX < 0.0)
+        railDistance = std::fmin(railDistance, (table.GetMinX() + r - m.StartX) / m.DirX);
+    if (m.DirX > 0.0)
+        railDistance = std::fmin(railDistance, (table.GetMaxX() - r - m.StartX) / m.DirX);
+    if (m.DirZ < 0.0)
+        railDistance = std::fmin(railDistance, (table.GetMinZ() + r - m.StartZ) / m.DirZ);
+    if (m.DirZ > 0.0)
+        railDistance = std::fmin(railDistance, (table.GetMaxZ() - r - m.StartZ) / m.DirZ);
+    if (railDistance < 0.0)
+        railDistance = 0.0;
+
+    double cushionDistance = NEVER;
+    int pocket;
+    if (railDistance < NEVER)
+    {
+        double cx = m.StartX + m.DirX * railDistance;
+        double cz = m.StartZ + m.DirZ * railDistance;
+        if (!IsInPocketGap(cx, cz, pocket))
+        {
+            cushionDistance = railDistance;
+        }
+        else
+        {
+            // The rail is open here: check again where the ball leaves the gap
+            double enter, exit;
+            if (RayCircle(m.StartX, m.StartZ, m.DirX, m.DirZ, pockets[pocket].x, pockets[pocket].z,
+                          table.GetPocketGapRadius(), enter, exit))
+                cushionDistance = exit + GAP_EXIT_MARGIN;
+        }
+    }
+
+    // A ball already inside a gap may be past a rail; it is pushed back when it leaves
+    if (IsInPocketGap(m.StartX, m.StartZ, pocket))
+    {
+        double enter, exit;
+        if (RayCircle(m.StartX, m.StartZ, m.DirX, m.DirZ, pockets[pocket].x, pockets[pocket].z,
+                      table.GetPocketGapRadius(), enter, exit))
+            cushionDistance = std::fmin(cushionDistance, exit + GAP_EXIT_MARGIN);
+    }
+
+    if (cushionDistance <= rollDistance)
+    {
+        double t = RollingMotion::TimeAtDistance(m.Speed, cushionDistance, rollTime);
+        Queue.push({ m.StartTime + t, EventType::Cushion, i, -1, m.Stamp, 0 });
+    }
+}
+
+void EventSimulator::ScheduleBall(int i, int skip)
+{
+    if (!Balls[i].Active)
+        return;
+
+    ScheduleBallEvents(i);
+
+    int numBalls = (int)Balls.size();
+    for (int j = 0; j < numBalls; j++)
+    {
+        if (j != i && j != skip && Balls[j].Active)
+            SchedulePair(i, j, Now);
+    }
+}
+
+void EventSimulator::SchedulePair(int a, int b, double fromTime)
+{
+    bool contact;
+    double t = FindContactTime(a, b, fromTime, contact);
+    if (t < 0.0)
+        return;
+
+    EventType type = contact ? EventType::BallContact : EventType::PairRecheck;
+    Queue.push({ t, type, a, b, Balls[a].Stamp, Balls[b].Stamp });
+}
+
+double EventSimulator::FindContactTime(int a, int b, double fromTime, bool& contact) const
+{
+    contact = false;
+
+    const Motion& ma = Balls[a];
+    const Motion& mb = Balls[b];
+    if (ma.Speed <= 0.0 && mb.Speed <= 0.0)
+        return -1.0;
+
+    // After both balls stop nothing can change
+    double endTime = ma.StopTime > mb.StopTime ? ma.StopTime : mb.StopTime;
+    if (fromTime >= endTime)
+        return -1.0;
+
+    // Cheap rejection: the remaining paths never come within contact distance
+    double minDist = ma.Radius + mb.Radius;
+    double a0x, a0z, a1x, a1z, b0x, b0z, b1x, b1z;
+    PositionAt(a, fromTime, a0x, a0z);
+    PositionAt(a, endTime, a1x, a1z);
+    PositionAt(b, fromTime, b0x, b0z);
+    PositionAt(b, endTime, b1x, b1z);
+    if (SegmentDistanceSq(a0x, a0z, a1x, a1z, b0x, b0z, b1x, b1z) >= minDist * minDist)
+        return -1.0;
+
+    // Root search for gap(t) = |pb - pa| - minDist, starting from below the root.
+    // Each iteration takes the larger of a conservative-advancement step
+    // (gap / combined speed, which can never pass a contact) and a Newton
+    // step; if the Newton step lands inside the other ball the root is
+    // bracketed and found by bisection.
+    double t = fromTime;
+    for (int iter = 0; iter < MAX_CONTACT_ITERATIONS; iter++)
+    {
+        double pax, paz, pbx, pbz, vax, vaz, vbx, vbz;
+        PositionAt(a, t, pax, paz);
+        PositionAt(b, t, pbx, pbz);
+        VelocityAt(a, t, vax, vaz);
+        VelocityAt(b, t, vbx, vbz);
+
+        double dx = pbx - pax;
+        double dz = pbz - paz;
+        double dist = std::sqrt(dx * dx + dz * dz);
+        double gap = dist - minDist;
+
+        // Rate at which the gap closes (positive = approaching)
+        double closing = dist > 0.0 ? ((vax - vbx) * dx + (vaz - vbz) * dz) / dist : 0.0;
+
+        if (gap <= CONTACT_TOLERANCE)
+        {
+            if (closing > MIN_CLOSING_SPEED)
+            {
+                contact = true;
+                return t;
+            }
+
+            // Touching but separating or sliding (e.g. right after a contact)
+            t += SEPARATION_STEP;
+            if (t >= endTime)
+                return -1.0;
+            continue;
+        }
+
+        double bound = 0.0;
+        if (ma.Speed > 0.0 && t < ma.StopTime)
+            bound += RollingMotion::SpeedAt(ma.Speed, t - ma.StartTime);
+        if (mb.Speed > 0.0 && t < mb.StopTime)
+            bound += RollingMotion::SpeedAt(mb.Speed, t - mb.StartTime);
+        if (bound <= 0.0)
+            return -1.0;
+
+        double next = t + gap / bound;
+        if (closing > 0.0)
+        {
+            double newton = t + gap / closing;
+            if (newton > endTime)
+                newton = endTime;
+
+            PositionAt(a, newton, pax, paz);
+            PositionAt(b, newton, pbx, pbz);
+            dx = pbx - pax;
+            dz = pbz - paz;
+            if (dx * dx + dz * dz < minDist * minDist)
+            {
+                // Contact lies in (next, newton]
+                double lo = next, hi = newton;
+                PositionAt(a, lo, pax, paz);
+                PositionAt(b, lo, pbx, pbz);
+                dx = pbx - pax;
+                dz = pbz - paz;
+                if (dx * dx + dz * dz <= minDist * minDist)
+                    lo = t;
+                for (int k = 0; k < 60 && hi - lo > 1e-12; k++)
+                {
+                    double mid = 0.5 * (lo + hi);
+                    PositionAt(a, mid, pax, paz);
+                    PositionAt(b, mid, pbx, pbz);
+                    dx = pbx - pax;
+                    dz = pbz - paz;
+                    if (dx * dx + dz * dz < minDist * minDist)
+                        hi = mid;
+                    else
+                        lo = mid;
+                }
+                contact = true;
+                return hi;
+            }
+
+            if (newton > next)
+                next = newton;
+        }
+
+        if (next >= endTime)
+            return -1.0;
+        t = next;
+    }
+
+    return t;
+}
+
+bool EventSimulator::IsInPocketGap(double x, double z, int& pocket) const
+{
+    const Vec3* pockets = TablePtr->GetPocketPositions();
+    double gap = TablePtr->GetPocketGapRadius();
+
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        double dx = x - pockets[p].x;
+        double dz = z - pockets[p].z;
+        if (dx * dx + dz * dz < gap * gap)
+        {
+            pocket = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// EVENT HANDLING
+// ============================================================================
+
+bool EventSimulator::ProcessNextEvent(double endTime)
+{
+    while (!Queue.empty())
+    {
+        Event e = Queue.top();
+        if (e.Time > endTime)
+            return false;
+        Queue.pop();
+
+        // Discard events predicted from motion that has since changed
+        const Motion& a = Balls[e.A];
+        if (!a.Active || a.Stamp != e.StampA)
+            continue;
+        if (e.B >= 0)
+        {
+            const Motion& b = Balls[e.B];
+            if (!b.Active || b.Stamp != e.StampB)
+                continue;
+        }
+
+        if (e.Time > Now)
+            Now = e.Time;
+
+        switch (e.Type)
+        {
+        case EventType::BallContact:
+            HandleBallContact(e.A, e.B);
+            break;
+        case EventType::PairRecheck:
+            SchedulePair(e.A, e.B, Now);
+            break;
+        case EventType::Cushion:
+            HandleCushion(e.A);
+            break;
+        case EventType::Pocket:
+            HandlePocket(e.A);
+            break;
+        case EventType::Rest:
+        {
+            double x, z;
+            PositionAt(e.A, Now, x, z);
+            SetMotion(e.A, x, z, 0.0, 0.0);
+            break;
+        }
+        }
+
+        EventCount++;
+        return true;
+    }
+    return false;
+}
+
+void EventSimulator::HandleBallContact(int a, int b)
+{
+    double pax, paz, pbx, pbz, vax, vaz, vbx, vbz;
+    PositionAt(a, Now, pax, paz);
+    PositionAt(b, Now, pbx, pbz);
+    VelocityAt(a, Now, vax, vaz);
+    VelocityAt(b, Now, vbx, vbz);
+
+    // Normal from a to b
+    double dx = pbx - pax;
+    double dz = pbz - paz;
+    double dist = std::sqrt(dx * dx + dz * dz);
+    if (dist < 0.0001)
+    {
+        dx = 1.0;
+        dz = 0.0;
+        dist = 1.0;
+    }
+    double nx = dx / dist;
+    double nz = dz / dist;
+
+    // Same equal-mass impulse as Physics::ResolveBallCollision
+    double velAlongNormal = (vax - vbx) * nx + (vaz - vbz) * nz;
+    if (velAlongNormal > 0.0)
+    {
+        double j = -(1.0 + PhysicsConstants::BALL_RESTITUTION) * velAlongNormal / 2.0;
+        vax += nx * j;
+        vaz += nz * j;
+        vbx -= nx * j;
+        vbz -= nz * j;
+    }
+
+    // A ball knocked slower than MIN_VELOCITY stops dead, which can leave
+    // the other one still pressing into it; remove that remaining normal
+    // motion so the pair does not keep colliding at the same instant
+    const double minSq = (double)PhysicsConstants::MIN_VELOCITY * PhysicsConstants::MIN_VELOCITY;
+    bool restA = vax * vax + vaz * vaz < minSq;
+    bool restB = vbx * vbx + vbz * vbz < minSq;
+    if (restA)
+        vax = vaz = 0.0;
+    if (restB)
+        vbx = vbz = 0.0;
+
+    double remaining = (vax - vbx) * nx + (vaz - vbz) * nz;
+    if (remaining > 0.0)
+    {
+        if (restB)
+        {
+            vax -= nx * remaining;
+            vaz -= nz * remaining;
+        }
+        else if (restA)
+        {
+            vbx += nx * remaining;
+            vbz += nz * remaining;
+        }
+    }
+
+    SetMotion(a, pax, paz, vax, vaz);
+    SetMotion(b, pbx, pbz, vbx, vbz);
+    ScheduleBall(a, -1);
+    ScheduleBall(b, a);
+}
+
+void EventSimulator::HandleCushion(int i)
+{
+    const TableGeometry& table = *TablePtr;
+    double x, z, vx, vz;
+    PositionAt(i, Now, x, z);
+    VelocityAt(i, Now, vx, vz);
+
+    int pocket;
+    if (!IsInPocketGap(x, z, pocket))
+    {
+        // Same clamp and reflection as Physics::ResolveCushionCollisions;
+        // the tolerance catches contacts that round to just short of the rail
+        const double tolerance = 1e-9;
+        double r = Balls[i].Radius;
+        double e = PhysicsConstants::CUSHION_RESTITUTION;
+
+        if (x - r < table.GetMinX() + tolerance)
+        {
+            x = table.GetMinX() + r;
+            if (vx < 0.0)
+                vx = -vx * e;
+        }
+        if (x + r > table.GetMaxX() - tolerance)
+        {
+            x = table.GetMaxX() - r;
+            if (vx > 0.0)
+                vx = -vx * e;
+        }
+        if (z - r < table.GetMinZ() + tolerance)
+        {
+            z = table.GetMinZ() + r;
+            if (vz < 0.0)
+                vz = -vz * e;
+        }
+        if (z + r > table.GetMaxZ() - tolerance)
+        {
+            z = table.GetMaxZ() - r;
+            if (vz > 0.0)
+                vz = -vz * e;
+        }
+    }
+
+    SetMotion(i, x, z, vx, vz);
+    ScheduleBall(i, -1);
+}
+
+void EventSimulator::HandlePocket(int i)
+{
+    Motion& m = Balls[i];
+    if (m.Number == 0)
+    {
+        // Cue ball: respawn at original position
+        SetMotion(i, 0.0, 2.0, 0.0, 0.0);
+        ScheduleBall(i, -1);
+    }
+    else
+    {
+        // Regular ball: deactivate
+        double x, z;
+        PositionAt(i, Now, x, z);
+        SetMotion(i, x, z, 0.0, 0.0);
+        m.Active = false;
+    }
+}
+
+void EventSimulator::WriteState(BallStore& balls) const
+{
+    int numBalls = (int)Balls.size();
+    for (int i = 0; i < numBalls; i++)
+    {
+        double x, z, vx, vz;
+        PositionAt(i, Now, x, z);
+        VelocityAt(i, Now, vx, vz);
+
+        balls.PosX[i] = (float)x;
+        balls.PosZ[i] = (float)z;
+        balls.VelX[i] = (float)vx;
+        balls.VelZ[i] = (float)vz;
+        balls.SetActive(i, Balls[i].Active);
+
+        // Keep the store's sleeping state in step with the motion
+        if (Balls[i].Active && (vx != 0.0 || vz != 0.0))
+            balls.Wake(i);
+        else
+            balls.Sleep(i);
+    }
+}
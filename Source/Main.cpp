@@ -12,6 +12,8 @@
  * - W/S: Adjust shot power
  * - Scroll: Zoom in/out (changes FOV)
  * - F11: Toggle fullscreen / borderless windowed
+ * - R: Start/stop recording a replay
+ * - P: Play back the last replay
  *
  * Requirements met:
  * - Modern OpenGL (VAO, VBO, shaders)
@@ -29,6 +31,10 @@
 #include "../Header/Table.h"
 #include "../Header/Ball.h"
 #include "../Header/Physics.h"
+#include "../Header/SimulationClock.h"
+#include "../Header/TrajectoryPreview.h"
+#include "../Header/Replay.h"
+#include "../Header/WorldSnapshot.h"
 #include "../Header/Util.h"
 
 #include <iostream>
@@ -55,6 +61,18 @@ const float BALL_RADIUS = 0.057f;  // Standard pool ball radius (scaled)
 const float MIN_SHOT_POWER = 1.0f;
 const float MAX_SHOT_POWER = 8.0f;
 
+// ---- Physics Timing ----
+// Physics runs in fixed steps independent of the frame rate
+const float PHYSICS_TICK_RATE = 240.0f;       // Steps per second
+const int MAX_PHYSICS_STEPS_PER_FRAME = 16;   // Beyond this, time is dropped (spiral-of-death guard)
+
+// ---- Aiming ----
+const float MIN_DRAG_DISTANCE = 0.05f;   // Shorter drags do not shoot
+const float MAX_DRAG_DISTANCE = 3.0f;    // Drag distance for full power
+
+// ---- Replays ----
+const char* const REPLAY_FILE = "replay.brp";
+
 // ============================================================================
 // GLOBAL STATE
 // ============================================================================
@@ -67,6 +85,10 @@ bool g_FaceCullingEnabled = false;
 bool g_KeyDPressed = false;
 bool g_KeyCPressed = false;
 
+// Replay requests (handled in the main loop, which owns the recorder)
+bool g_ToggleRecording = false;
+bool g_TogglePlayback = false;
+
 // Window mode: true = fullscreen, false = borderless windowed
 bool g_IsFullscreen = true;
 
@@ -299,6 +321,12 @@ void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
     }
     g_KeyCPressed = (key == GLFW_KEY_C && action != GLFW_RELEASE);
 
+    // R to start/stop recording, P to start/stop playback
+    if (key == GLFW_KEY_R && action == GLFW_PRESS)
+        g_ToggleRecording = true;
+    if (key == GLFW_KEY_P && action == GLFW_PRESS)
+        g_TogglePlayback = true;
+
     // F11 to toggle fullscreen / borderless windowed
     if (key == GLFW_KEY_F11 && action == GLFW_PRESS)
     {
@@ -420,6 +448,35 @@ void ApplyRenderState()
     }
 }
 
+/**
+ * Draw a path as a chain of thin boxes lying on the table
+ * Uses the aim indicator mesh; lighting uniforms should already be emissive
+ */
+void RenderPath(Shader& shader, const Mat4& viewProjection, const std::vector<Vec3>& path, const Vec3& color, float height)
+{
+    shader.SetVec3("uObjectColor", color.Ptr());
+    glBindVertexArray(g_AimVAO);
+
+    for (size_t i = 1; i < path.size(); i++)
+    {
+        Vec3 segment = path[i] - path[i - 1];
+        float length = segment.Length();
+        if (length < 0.0001f)
+            continue;
+
+        Vec3 mid = (path[i] + path[i - 1]) * 0.5f;
+        Mat4 model = Mat4::Translate(mid.x, height, mid.z) *
+                     Mat4::RotateY(atan2f(segment.x, segment.z)) *
+                     Mat4::Scale(0.008f, 0.008f, length);
+        Mat4 mvp = viewProjection * model;
+        shader.SetMat4("uMVP", mvp.Ptr());
+        shader.SetMat4("uModel", model.Ptr());
+        glDrawElements(GL_TRIANGLES, g_AimIndexCount, GL_UNSIGNED_INT, 0);
+    }
+
+    glBindVertexArray(0);
+}
+
 void RenderOverlay(Shader& overlayShader, GLuint textureID, float alpha)
 {
     // Disable depth testing for 2D overlay
@@ -457,6 +514,33 @@ void RenderOverlay(Shader& overlayShader, GLuint textureID, float alpha)
         glEnable(GL_DEPTH_TEST);
 }
 
+// ============================================================================
+// AIMING
+// ============================================================================
+
+/**
+ * Work out the shot the current mouse drag would play
+ * @param balls Ball state store
+ * @param direction Receives the shot direction (from cue ball toward the mouse)
+ * @param power Receives the shot power
+ * @return Index of the cue ball, or -1 if there is no shot (no cue ball, drag too short)
+ */
+int GetAimShot(const BallStore& balls, Vec3& direction, float& power)
+{
+    int cueBall = balls.FindBall(0);
+    if (cueBall < 0 || !balls.IsActive(cueBall))
+        return -1;
+
+    Vec3 diff = g_MouseWorldPos - Vec3(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]);
+    float dragDist = diff.Length();
+    if (dragDist <= MIN_DRAG_DISTANCE)
+        return -1;
+
+    direction = Vec3(diff.x, 0.0f, diff.z).Normalized();
+    power = MIN_SHOT_POWER + (MAX_SHOT_POWER - MIN_SHOT_POWER) * Clamp(dragDist / MAX_DRAG_DISTANCE, 0.0f, 1.0f);
+    return cueBall;
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -565,12 +649,30 @@ int main()
     Table table;
     table.InitMesh();
 
-    // Balls - load the shared sphere model once, then create ball instances
+    // Balls - load the shared sphere model once, then fill the physics store
+    // and create a render view for every ball
     Ball::LoadModel("Resources/sphere.obj");
-    std::vector<Ball*> balls = CreateStandardBallSet(BALL_RADIUS);
+    BallStore ballStore;
+    std::vector<Ball> balls = CreateStandardBallSet(ballStore, BALL_RADIUS);
 
     // Physics
     Physics physics;
+    SimulationClock simClock(PHYSICS_TICK_RATE, MAX_PHYSICS_STEPS_PER_FRAME);
+
+    // Shot prediction runs on its own thread while the player aims
+    TrajectoryPreview preview(table, simClock.GetStepTime());
+    PreviewResult previewResult;
+    bool previewRequested = false;
+    Vec3 previewDir;
+    float previewPower = 0.0f;
+
+    // Replays: recording streams every physics step to a file; playback drives
+    // the balls from the file and puts the game back where it was afterwards
+    ReplayRecorder recorder;
+    ReplayReader replayReader;
+    WorldSnapshot replaySavedState;
+    bool playingBack = false;
+    double playbackTime = 0.0;
 
     // Overlay quad, aim indicator, shadow map, lamp
     InitOverlayQuad();
@@ -606,9 +708,12 @@ int main()
     std::cout << "  D: Toggle depth testing" << std::endl;
     std::cout << "  C: Toggle face culling" << std::endl;
     std::cout << "  Mouse drag: Aim and shoot (drag from cue ball, further = harder)" << std::endl;
+    std::cout << "  R: Start/stop recording a replay" << std::endl;
+    std::cout << "  P: Play back the last replay" << std::endl;
     std::cout << "===================\n" << std::endl;
 
     auto lastTime = std::chrono::high_resolution_clock::now();
+    auto lastOverrunReport = lastTime;
     float deltaTime = 0.0f;
 
     while (!glfwWindowShouldClose(window))
@@ -618,46 +723,127 @@ int main()
         deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
 
-        // Cap deltaTime to prevent physics explosions on frame spikes (alt-tab, first frame, etc.)
-        if (deltaTime > 0.05f)
-            deltaTime = 0.05f;
-
         // ============ Input ============
         glfwPollEvents();
 
-        // Handle mouse drag shooting
-        // On release: shoot the cue ball in the direction from cue ball to mouse
-        if (wasDragging && !g_IsDragging && physics.AllBallsStopped(balls))
+        // Start/stop recording (not while a replay is playing)
+        if (g_ToggleRecording)
         {
-            Ball* cueBall = nullptr;
-            for (Ball* ball : balls)
+            g_ToggleRecording = false;
+            if (recorder.IsRecording())
+            {
+                int frames = recorder.GetFrameCount();
+                recorder.Close();
+                std::cout << "Replay saved: " << frames << " frames, " << recorder.GetBytesWritten() / 1024.0
+                          << " KB" << std::endl;
+            }
+            else if (!playingBack)
+            {
+                if (recorder.Open(REPLAY_FILE, ballStore, simClock.GetStepTime()))
+                    std::cout << "Recording replay to " << REPLAY_FILE << std::endl;
+                else
+                    std::cerr << "Cannot create " << REPLAY_FILE << std::endl;
+            }
+        }
+
+        // Start/stop playback (not while recording)
+        if (g_TogglePlayback)
+        {
+            g_TogglePlayback = false;
+            if (playingBack)
+            {
+                playingBack = false;
+                replaySavedState.Restore(ballStore, simClock);
+            }
+            else if (!recorder.IsRecording())
             {
-                if (ball->Number == 0 && ball->IsActive)
+                if (replayReader.Open(REPLAY_FILE) && replayReader.GetBallCount() == ballStore.Size())
+                {
+                    replaySavedState.Save(ballStore, simClock);
+                    playingBack = true;
+                    playbackTime = 0.0;
+                    std::cout << "Playing replay (" << replayReader.GetDuration() << " s)" << std::endl;
+                }
+                else
                 {
-                    cueBall = ball;
-                    break;
+                    std::cerr << "No replay to play in " << REPLAY_FILE << std::endl;
                 }
             }
+        }
+
+        // Handle mouse drag shooting
+        // On release: shoot the cue ball in the direction from cue ball to mouse
+        if (wasDragging && !g_IsDragging && !playingBack && physics.AllBallsStopped(ballStore))
+        {
+            Vec3 shotDir;
+            float power;
+            int cueBall = GetAimShot(ballStore, shotDir, power);
 
-            if (cueBall)
+            if (cueBall >= 0)
             {
-                Vec3 diff = g_MouseWorldPos - Vec3(cueBall->Position.x, 0.0f, cueBall->Position.z);
-                float dragDist = diff.Length();
+                physics.ApplyImpulse(ballStore, cueBall, shotDir, power);
+                std::cout << "Shot! Power: " << power << std::endl;
+            }
+        }
+        wasDragging = g_IsDragging;
 
-                if (dragDist > 0.05f) // Minimum drag distance to shoot
+        // Post a new prediction only when the aim changes; the worker drops stale ones
+        {
+            Vec3 aimDir;
+            float aimPower = 0.0f;
+            int cueBall = -1;
+            if (g_IsDragging && !playingBack && physics.AllBallsStopped(ballStore))
+                cueBall = GetAimShot(ballStore, aimDir, aimPower);
+
+            if (cueBall >= 0)
+            {
+                if (!previewRequested || Dot(aimDir, previewDir) < 0.99999f || fabsf(aimPower - previewPower) > 0.01f)
                 {
-                    Vec3 shotDir = Vec3(diff.x, 0.0f, diff.z).Normalized();
-                    float maxDragDist = 3.0f;
-                    float power = MIN_SHOT_POWER + (MAX_SHOT_POWER - MIN_SHOT_POWER) * Clamp(dragDist / maxDragDist, 0.0f, 1.0f);
-                    physics.ApplyImpulse(cueBall, shotDir, power);
-                    std::cout << "Shot! Power: " << power << std::endl;
+                    preview.Request(ballStore, cueBall, aimDir, aimPower);
+                    previewRequested = true;
+                    previewDir = aimDir;
+                    previewPower = aimPower;
                 }
             }
+            else if (previewRequested)
+            {
+                preview.Cancel();
+                previewRequested = false;
+            }
         }
-        wasDragging = g_IsDragging;
 
         // ============ Update ============
-        physics.Update(balls, table, deltaTime);
+        // Fixed-step physics: run as many steps as the elapsed time pays for.
+        // Frame spikes (alt-tab, first frame, etc.) are absorbed by the step cap
+        int physicsSteps = simClock.Advance(deltaTime);
+        if (playingBack)
+        {
+            // The replay drives the balls; the game resumes from its saved state at the end
+            playbackTime += deltaTime;
+            replayReader.ReadFrame(replayReader.FrameAtTime(playbackTime), ballStore);
+            if (playbackTime >= replayReader.GetDuration())
+            {
+                playingBack = false;
+                replaySavedState.Restore(ballStore, simClock);
+            }
+        }
+        else
+        {
+            for (int step = 0; step < physicsSteps; step++)
+            {
+                physics.Update(ballStore, table, simClock.GetStepTime());
+                if (recorder.IsRecording())
+                    recorder.RecordFrame(ballStore);
+            }
+        }
+
+        // Report the spiral of death (at most once per second)
+        if (simClock.IsFallingBehind() && currentTime - lastOverrunReport > std::chrono::seconds(1))
+        {
+            std::cout << "Physics falling behind: dropped " << simClock.GetDroppedTime() * 1000.0
+                      << " ms of simulation over " << simClock.GetOverrunFrameCount() << " frames" << std::endl;
+            lastOverrunReport = currentTime;
+        }
 
         // Update camera aspect ratio if window was resized
         camera.SetAspectRatio((float)g_WindowWidth / (float)g_WindowHeight);
@@ -670,14 +856,14 @@ int main()
         glEnable(GL_DEPTH_TEST);
 
         shadowShader.Use();
-        for (Ball* ball : balls)
+        for (const Ball& ball : balls)
         {
-            if (!ball->IsActive) continue;
-            Mat4 model = ball->GetModelMatrix();
+            if (!ball.IsActive()) continue;
+            Mat4 model = ball.GetModelMatrix();
             Mat4 shadowMVP = lightSpaceMatrix * model;
             shadowShader.SetMat4("uMVP", shadowMVP.Ptr());
             shadowShader.SetMat4("uModel", model.Ptr());
-            ball->Render(shadowShader, lightSpaceMatrix);
+            ball.Render(shadowShader, lightSpaceMatrix);
         }
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -719,9 +905,9 @@ int main()
         // --- Render balls (shiny resin/plastic material) ---
         billiardShader.SetVec3("uMaterial.kS", 0.9f, 0.9f, 0.9f);  // Strong white specular highlight
         billiardShader.SetFloat("uMaterial.shine", 64.0f);          // High shininess
-        for (Ball* ball : balls)
+        for (const Ball& ball : balls)
         {
-            ball->Render(billiardShader, viewProjection);
+            ball.Render(billiardShader, viewProjection);
         }
 
         // Render lamp (emissive - full ambient, bypass spotlight)
@@ -745,31 +931,23 @@ int main()
         }
 
         // Render aim line when dragging and balls are stopped
-        if (g_IsDragging && physics.AllBallsStopped(balls))
+        if (g_IsDragging && !playingBack && physics.AllBallsStopped(ballStore))
         {
-            Ball* cueBall = nullptr;
-            for (Ball* ball : balls)
-            {
-                if (ball->Number == 0 && ball->IsActive)
-                {
-                    cueBall = ball;
-                    break;
-                }
-            }
+            int cueBall = ballStore.FindBall(0);
 
-            if (cueBall)
+            if (cueBall >= 0 && ballStore.IsActive(cueBall))
             {
-                Vec3 cuePosXZ(cueBall->Position.x, 0.0f, cueBall->Position.z);
+                Vec3 cuePosXZ(ballStore.PosX[cueBall], 0.0f, ballStore.PosZ[cueBall]);
                 Vec3 diff = g_MouseWorldPos - cuePosXZ;
                 float dragDist = diff.Length();
 
-                if (dragDist > 0.05f)
+                if (dragDist > MIN_DRAG_DISTANCE)
                 {
                     Vec3 aimDir = diff.Normalized();
                     float aimAngle = atan2f(aimDir.x, aimDir.z);
 
                     // Color based on power: green (weak) -> yellow -> red (strong)
-                    float powerFrac = Clamp(dragDist / 3.0f, 0.0f, 1.0f);
+                    float powerFrac = Clamp(dragDist / MAX_DRAG_DISTANCE, 0.0f, 1.0f);
                     Vec3 aimColor;
                     if (powerFrac < 0.5f)
                     {
@@ -788,7 +966,7 @@ int main()
 
                     float lineLen = 0.3f + powerFrac * 0.4f;
 
-                    Mat4 aimModel = Mat4::Translate(cueBall->Position + aimDir * (cueBall->Radius + lineLen / 2.0f + 0.02f)) *
+                    Mat4 aimModel = Mat4::Translate(ballStore.GetPosition(cueBall) + aimDir * (ballStore.Radius[cueBall] + lineLen / 2.0f + 0.02f)) *
                                     Mat4::RotateY(aimAngle) *
                                     Mat4::Scale(0.015f, 0.015f, lineLen);
                     Mat4 aimMVP = viewProjection * aimModel;
@@ -801,6 +979,29 @@ int main()
                     glDrawElements(GL_TRIANGLES, g_AimIndexCount, GL_UNSIGNED_INT, 0);
                     glBindVertexArray(0);
 
+                    // Predicted paths from the latest finished preview (may lag the aim by a frame or two)
+                    if (previewRequested && preview.GetLatest(previewResult))
+                    {
+                        float pathHeight = ballStore.Radius[cueBall] * 0.1f;
+                        RenderPath(billiardShader, viewProjection, previewResult.CuePath, Vec3(1.0f, 1.0f, 1.0f), pathHeight);
+                        RenderPath(billiardShader, viewProjection, previewResult.ObjectPath, aimColor, pathHeight);
+
+                        // Ghost marker where the cue ball meets the object ball
+                        if (previewResult.HasContact)
+                        {
+                            float size = ballStore.Radius[cueBall];
+                            Mat4 ghostModel = Mat4::Translate(previewResult.ContactPosition.x, size, previewResult.ContactPosition.z) *
+                                              Mat4::Scale(size);
+                            Mat4 ghostMVP = viewProjection * ghostModel;
+                            billiardShader.SetMat4("uMVP", ghostMVP.Ptr());
+                            billiardShader.SetMat4("uModel", ghostModel.Ptr());
+                            billiardShader.SetVec3("uObjectColor", 0.8f, 0.8f, 0.8f);
+                            glBindVertexArray(g_AimVAO);
+                            glDrawElements(GL_TRIANGLES, g_AimIndexCount, GL_UNSIGNED_INT, 0);
+                            glBindVertexArray(0);
+                        }
+                    }
+
                     // Restore lighting
                     billiardShader.SetVec3("uLight.kA", lightKA.Ptr());
                 }
@@ -830,11 +1031,7 @@ int main()
     // ==================== Cleanup ====================
     std::cout << "Cleaning up..." << std::endl;
 
-    // Delete balls
-    for (Ball* ball : balls)
-    {
-        delete ball;
-    }
+    // Release ball views and the shared model
     balls.clear();
     Ball::CleanupModel();
 
@@ -0,0 +1,216 @@
+#include "../Header/MathUtil.h"
+
+// ============================================================================
+// MAT4 IMPLEMENTATION
+// ============================================================================
+
+template <class T>
+TMat4<T> TMat4<T>::operator*(const TMat4& other) const
+{
+    TMat4 result;
+    // Clear result to zero
+    for (int i = 0; i < 16; i++) result.m[i] = 0;
+
+    // Matrix multiplication (column-major)
+    for (int col = 0; col < 4; col++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                result.m[col * 4 + row] += m[k * 4 + row] * other.m[col * 4 + k];
+            }
+        }
+    }
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Identity()
+{
+    return TMat4(); // Default constructor creates identity
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Translate(T x, T y, T z)
+{
+    TMat4 result;
+    result.m[12] = x;
+    result.m[13] = y;
+    result.m[14] = z;
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Translate(const TVec3<T>& v)
+{
+    return Translate(v.x, v.y, v.z);
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Scale(T x, T y, T z)
+{
+    TMat4 result;
+    result.m[0] = x;
+    result.m[5] = y;
+    result.m[10] = z;
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Scale(T s)
+{
+    return Scale(s, s, s);
+}
+
+template <class T>
+TMat4<T> TMat4<T>::RotateX(T radians)
+{
+    TMat4 result;
+    T c = std::cos(radians);
+    T s = std::sin(radians);
+    result.m[5] = c;
+    result.m[6] = s;
+    result.m[9] = -s;
+    result.m[10] = c;
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::RotateY(T radians)
+{
+    TMat4 result;
+    T c = std::cos(radians);
+    T s = std::sin(radians);
+    result.m[0] = c;
+    result.m[2] = -s;
+    result.m[8] = s;
+    result.m[10] = c;
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::RotateZ(T radians)
+{
+    TMat4 result;
+    T c = std::cos(radians);
+    T s = std::sin(radians);
+    result.m[0] = c;
+    result.m[1] = s;
+    result.m[4] = -s;
+    result.m[5] = c;
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Perspective(T fovY, T aspect, T nearPlane, T farPlane)
+{
+    TMat4 result;
+    // Clear to zero
+    for (int i = 0; i < 16; i++) result.m[i] = 0;
+
+    T tanHalfFov = std::tan(fovY / 2);
+
+    result.m[0] = 1.0f / (aspect * tanHalfFov);
+    result.m[5] = 1.0f / tanHalfFov;
+    result.m[10] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    result.m[11] = -1.0f;
+    result.m[14] = -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane);
+    result.m[15] = 0.0f;
+
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Ortho(T left, T right, T bottom, T top, T nearPlane, T farPlane)
+{
+    TMat4 result;
+    for (int i = 0; i < 16; i++) result.m[i] = 0;
+
+    result.m[0]  =  2.0f / (right - left);
+    result.m[5]  =  2.0f / (top - bottom);
+    result.m[10] = -2.0f / (farPlane - nearPlane);
+    result.m[12] = -(right + left) / (right - left);
+    result.m[13] = -(top + bottom) / (top - bottom);
+    result.m[14] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    result.m[15] =  1.0f;
+
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::LookAt(const TVec3<T>& eye, const TVec3<T>& target, const TVec3<T>& up)
+{
+    TVec3<T> f = (target - eye).Normalized();  // Forward
+    TVec3<T> r = Cross(f, up).Normalized();     // Right
+    TVec3<T> u = Cross(r, f);                   // Up (recalculated)
+
+    TMat4 result;
+
+    // Rotation part
+    result.m[0] = r.x;
+    result.m[1] = u.x;
+    result.m[2] = -f.x;
+    result.m[3] = 0.0f;
+
+    result.m[4] = r.y;
+    result.m[5] = u.y;
+    result.m[6] = -f.y;
+    result.m[7] = 0.0f;
+
+    result.m[8] = r.z;
+    result.m[9] = u.z;
+    result.m[10] = -f.z;
+    result.m[11] = 0.0f;
+
+    // Translation part
+    result.m[12] = -Dot(r, eye);
+    result.m[13] = -Dot(u, eye);
+    result.m[14] = Dot(f, eye);
+    result.m[15] = 1.0f;
+
+    return result;
+}
+
+template <class T>
+TMat4<T> TMat4<T>::Inverse() const
+{
+    T inv[16], det;
+
+    inv[0] = m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+    inv[4] = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+    inv[8] = m[4]*m[9]*m[15] - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+    inv[12] = -m[4]*m[9]*m[14] + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+
+    inv[1] = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+    inv[5] = m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+    inv[9] = -m[0]*m[9]*m[15] + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+    inv[13] = m[0]*m[9]*m[14] - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+
+    inv[2] = m[1]*m[6]*m[15] - m[1]*m[7]*m[14] - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7] - m[13]*m[3]*m[6];
+    inv[6] = -m[0]*m[6]*m[15] + m[0]*m[7]*m[14] + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7] + m[12]*m[3]*m[6];
+    inv[10] = m[0]*m[5]*m[15] - m[0]*m[7]*m[13] - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7] - m[12]*m[3]*m[5];
+    inv[14] = -m[0]*m[5]*m[14] + m[0]*m[6]*m[13] + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6] + m[12]*m[2]*m[5];
+
+    inv[3] = -m[1]*m[6]*m[11] + m[1]*m[7]*m[10] + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7] + m[9]*m[3]*m[6];
+    inv[7] = m[0]*m[6]*m[11] - m[0]*m[7]*m[10] - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7] - m[8]*m[3]*m[6];
+    inv[11] = -m[0]*m[5]*m[11] + m[0]*m[7]*m[9] + m[4]*m[1]*m[11] - m[4]*m[3]*m[9] - m[8]*m[1]*m[7] + m[8]*m[3]*m[5];
+    inv[15] = m[0]*m[5]*m[10] - m[0]*m[6]*m[9] - m[4]*m[1]*m[10] + m[4]*m[2]*m[9] + m[8]*m[1]*m[6] - m[8]*m[2]*m[5];
+
+    det = m[0]*inv[0] + m[1]*inv[4] + m[2]*inv[8] + m[3]*inv[12];
+
+    if (std::fabs(det) < (T)0.00001f)
+        return TMat4::Identity();
+
+    det = 1 / det;
+
+    TMat4 result;
+    for (int i = 0; i < 16; i++)
+        result.m[i] = inv[i] * det;
+
+    return result;
+}
+
+// Float for the game and the physics, double for the double precision policies
+template struct TMat4<float>;
+template struct TMat4<double>;
@@ -1,164 +1,731 @@
 #include "../Header/Physics.h"
+#include "../Header/DeterministicMath.h"
+#include "../Header/RollingMotion.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 
+/**
+ * Fraction of velocity kept by rolling friction over one step
+ */
+static float FrictionFactor(float deltaTime)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return DeterministicMath::Pow(PhysicsConstants::ROLLING_FRICTION, deltaTime);
+#else
+    return powf(PhysicsConstants::ROLLING_FRICTION, deltaTime);
+#endif
+}
+
+#ifndef BILLIARD_NO_PHYSICS_STATS
+
+// Add to a counter of the current step
+#define PHYSICS_STAT(counter, amount) (StepStats.counter += (amount))
+
+/**
+ * Splits a step's wall time into phases (reads the clock only when active)
+ */
+struct PhaseClock
+{
+    bool Active;
+    std::chrono::steady_clock::time_point Last;
+
+    explicit PhaseClock(bool active)
+        : Active(active)
+    {
+        if (Active)
+            Last = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Charge the time since the previous lap to a phase
+     */
+    void Lap(PhysicsStats& stats, PhysicsPhase phase)
+    {
+        if (!Active)
+            return;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        stats.PhaseSeconds[(int)phase] += std::chrono::duration<double>(now - Last).count();
+        Last = now;
+    }
+};
+
+#else
+
+#define PHYSICS_STAT(counter, amount) ((void)sizeof(amount))
+
+struct PhaseClock
+{
+    explicit PhaseClock(bool) {}
+    void Lap(PhysicsStats&, PhysicsPhase) {}
+};
+
+#endif
+
 Physics::Physics()
+    : Kernels(PhysicsKernels::DetectInstructionSet())
+    , Mode(StepMode::MultiPass)
+    , Iterations(IterationMode::Adaptive)
+    , MaxIterations(PhysicsConstants::COLLISION_ITERATIONS)
+    , LastIterations(0)
+    , ResidualPenetration(0.0f)
+    , FastForward(false)
+    , ContinuousCollision(true)
+    , MissedCollisions(0)
+    , EventLog(nullptr)
+    , LogTime(0.0)
+    , PhaseTiming(true)
+    , Method(Broadphase::Auto)
+    , PairListValid(false)
+    , PairListAwake(0)
 {
 }
 
-void Physics::Update(std::vector<Ball*>& balls, const Table& table, float deltaTime)
+void Physics::Update(BallStore& balls, const TableGeometry& table, float deltaTime)
 {
-    // Apply friction first
-    ApplyFriction(balls, deltaTime);
+    // Discrete events are stamped with the end of the step
+    LogTime += deltaTime;
 
-    // Integrate positions
-    IntegratePositions(balls, deltaTime);
+    // Balls moved: the sweep-and-prune pairs of the last step are stale
+    PairListValid = false;
 
-    // Resolve collisions (multiple iterations for stability)
-    const int COLLISION_ITERATIONS = 3;
-    for (int i = 0; i < COLLISION_ITERATIONS; i++)
+#ifndef BILLIARD_NO_PHYSICS_STATS
+    StepStats.Reset();
+    StepStats.Steps = 1;
+    StepStats.TimedSteps = PhaseTiming && TotalStats.Steps % PhysicsStats::TIMING_INTERVAL == 0 ? 1 : 0;
+#endif
+    PhaseClock clock(StepStats.TimedSteps != 0);
+
+    // Where each awake ball's path starts, for the swept collision tests
+    // (sleeping balls do not move; their entries are not used)
+    if ((int)StepStartX.size() < balls.Size())
+    {
+        StepStartX.resize(balls.Size());
+        StepStartZ.resize(balls.Size());
+    }
+    const int* awake = balls.GetAwakeBalls();
+    for (int k = 0; k < balls.GetAwakeCount(); k++)
     {
-        ResolveBallCollisions(balls);
-        ResolveCushionCollisions(balls, table);
+        int i = awake[k];
+        StepStartX[i] = balls.PosX[i];
+        StepStartZ[i] = balls.PosZ[i];
     }
 
+    if (Mode == StepMode::Fused)
+    {
+        // Clamp/stop of last step, friction and integration in one sweep
+        FusedIntegrate(balls, deltaTime);
+    }
+    else
+    {
+        // Apply friction first
+        ApplyFriction(balls, deltaTime);
+
+        // Integrate positions
+        IntegratePositions(balls, deltaTime);
+    }
+    clock.Lap(StepStats, PhysicsPhase::Integrate);
+
+    // Catch contacts that fast balls skipped over during integration
+    ResolveSweptCollisions(balls, table, deltaTime);
+    clock.Lap(StepStats, PhysicsPhase::Swept);
+
+    // Resolve collisions (multiple iterations for stability; adaptive mode
+    // stops once a pass finds nothing to resolve)
+    bool adaptive = Iterations == IterationMode::Adaptive;
+    int maxIterations = adaptive ? MaxIterations : PhysicsConstants::COLLISION_ITERATIONS;
+    float penetration = 0.0f;
+    int iteration = 0;
+    while (iteration < maxIterations)
+    {
+        float ballDepth = ResolveBallCollisions(balls, table);
+        clock.Lap(StepStats, PhysicsPhase::BallCollisions);
+        float cushionDepth = ResolveCushionCollisions(balls, table);
+        clock.Lap(StepStats, PhysicsPhase::Cushions);
+
+        iteration++;
+        penetration = ballDepth > cushionDepth ? ballDepth : cushionDepth;
+        if (adaptive && penetration == 0.0f)
+            break;
+    }
+    LastIterations = iteration;
+    ResidualPenetration = penetration;
+    PHYSICS_STAT(Iterations, iteration);
+#ifndef BILLIARD_NO_PHYSICS_STATS
+    if (penetration > 0.0f)
+    {
+        StepStats.CappedSteps = 1;
+        StepStats.MaxPenetration = penetration;
+    }
+#endif
+
     // Check if any balls fell into pockets
     CheckPockets(balls, table);
+    clock.Lap(StepStats, PhysicsPhase::Pockets);
 
-    // Clamp velocities and stop slow balls
-    ClampVelocities(balls);
-    StopSlowBalls(balls);
+    // Clamp velocities and stop slow balls (deferred to the next step when fused)
+    if (Mode == StepMode::MultiPass)
+    {
+        ClampVelocities(balls);
+        StopSlowBalls(balls);
+    }
+
+    // Balls that came to rest (or were potted) leave the awake list. In fused
+    // mode this applies the pending rest test early, which changes nothing:
+    // the next fused sweep would zero those velocities before moving them
+    balls.SleepSlowBalls(PhysicsConstants::MIN_VELOCITY);
+    clock.Lap(StepStats, PhysicsPhase::Finish);
+
+#ifndef BILLIARD_NO_PHYSICS_STATS
+    TotalStats.Add(StepStats);
+#endif
 }
 
-void Physics::ApplyImpulse(Ball* ball, const Vec3& direction, float power)
+int Physics::RunToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps)
 {
-    if (!ball || !ball->IsActive)
+    int steps = 0;
+    while (steps < maxSteps && !AllBallsStopped(balls))
+    {
+        Update(balls, table, deltaTime);
+        steps++;
+
+        if (FastForward && steps % PhysicsConstants::FAST_FORWARD_INTERVAL == 0)
+            steps += FastForwardToRest(balls, table, deltaTime, maxSteps - steps);
+    }
+    return steps;
+}
+
+/**
+ * Squared distance from a point to a segment
+ */
+static float PointSegmentDistanceSq(float px, float pz, float ax, float az, float bx, float bz)
+{
+    float dx = bx - ax;
+    float dz = bz - az;
+    float lenSq = dx * dx + dz * dz;
+    float t = lenSq > 0.0f ? ((px - ax) * dx + (pz - az) * dz) / lenSq : 0.0f;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+    float ex = px - (ax + dx * t);
+    float ez = pz - (az + dz * t);
+    return ex * ex + ez * ez;
+}
+
+/**
+ * Squared distance between two segments (0 if they cross)
+ */
+static float SegmentDistanceSq(float ax, float az, float bx, float bz,
+                               float cx, float cz, float dx, float dz)
+{
+    // C and D on opposite sides of AB, and A and B on opposite sides of CD
+    float abX = bx - ax, abZ = bz - az;
+    float cdX = dx - cx, cdZ = dz - cz;
+    float c1 = abX * (cz - az) - abZ * (cx - ax);
+    float d1 = abX * (dz - az) - abZ * (dx - ax);
+    float a2 = cdX * (az - cz) - cdZ * (ax - cx);
+    float b2 = cdX * (bz - cz) - cdZ * (bx - cx);
+    if (c1 * d1 < 0.0f && a2 * b2 < 0.0f)
+        return 0.0f;
+
+    float best = PointSegmentDistanceSq(ax, az, cx, cz, dx, dz);
+    best = std::min(best, PointSegmentDistanceSq(bx, bz, cx, cz, dx, dz));
+    best = std::min(best, PointSegmentDistanceSq(cx, cz, ax, az, bx, bz));
+    best = std::min(best, PointSegmentDistanceSq(dx, dz, ax, az, bx, bz));
+    return best;
+}
+
+int Physics::FastForwardToRest(BallStore& balls, const TableGeometry& table, float deltaTime, int maxSteps)
+{
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    if (numAwake == 0)
+        return 0;
+
+    // The same per-step friction as ApplyFriction
+    double factor = FrictionFactor(deltaTime);
+    double reduction = PhysicsConstants::LINEAR_DECELERATION * deltaTime;
+    float railBand = table.GetRailBandWidth();
+
+    // Where each awake ball stops, and whether its path stays in open table
+    RestPaths.clear();
+    int steps = 0;
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awake[k];
+        if (!balls.IsActive(i))
+            continue;
+
+        // Fused steps clamp a collision's output at the start of the next step
+        float speed = sqrtf(balls.VelX[i] * balls.VelX[i] + balls.VelZ[i] * balls.VelZ[i]);
+        float clamped = std::min(speed, PhysicsConstants::MAX_VELOCITY);
+        int ballSteps = RollingMotion::SteppedStepsToRest(clamped, factor, reduction, PhysicsConstants::MIN_VELOCITY);
+        float distance = (float)RollingMotion::SteppedDistance(clamped, factor, reduction, deltaTime, ballSteps);
+
+        RestPath path;
+        path.Ball = i;
+        path.EndX = balls.PosX[i];
+        path.EndZ = balls.PosZ[i];
+        if (ballSteps > 0)
+        {
+            path.EndX += balls.VelX[i] / speed * distance;
+            path.EndZ += balls.VelZ[i] / speed * distance;
+        }
+
+        // Cushions and pockets are only reachable from flagged zone cells
+        if (balls.Radius[i] >= railBand ||
+            !table.IsOpenPath(balls.PosX[i], balls.PosZ[i], path.EndX, path.EndZ))
+            return 0;
+
+        RestPaths.push_back(path);
+        steps = std::max(steps, ballSteps);
+    }
+    if (steps > maxSteps)
+        return 0;
+
+    // Swept circles must stay clear of every other ball, with a margin for the
+    // round-off that separates the steps from the closed form
+    const float margin = 1.0f + PhysicsConstants::FAST_FORWARD_MARGIN;
+    int numBalls = balls.Size();
+    int numPaths = (int)RestPaths.size();
+    for (int p = 0; p < numPaths; p++)
+    {
+        const RestPath& a = RestPaths[p];
+        int i = a.Ball;
+        float ax = balls.PosX[i];
+        float az = balls.PosZ[i];
+
+        // Resting balls
+        for (int j = 0; j < numBalls; j++)
+        {
+            if (j == i || !balls.IsActive(j) || balls.IsAwake(j))
+                continue;
+
+            float reach = (balls.Radius[i] + balls.Radius[j]) * margin;
+            if (PointSegmentDistanceSq(balls.PosX[j], balls.PosZ[j], ax, az, a.EndX, a.EndZ) <= reach * reach)
+                return 0;
+        }
+
+        // Other moving balls, whenever they pass
+        for (int q = p + 1; q < numPaths; q++)
+        {
+            const RestPath& b = RestPaths[q];
+            int j = b.Ball;
+            float reach = (balls.Radius[i] + balls.Radius[j]) * margin;
+            if (SegmentDistanceSq(ax, az, a.EndX, a.EndZ,
+                                  balls.PosX[j], balls.PosZ[j], b.EndX, b.EndZ) <= reach * reach)
+                return 0;
+        }
+    }
+
+    for (const RestPath& path : RestPaths)
+    {
+        balls.PosX[path.Ball] = path.EndX;
+        balls.PosZ[path.Ball] = path.EndZ;
+        balls.Stop(path.Ball);
+    }
+    balls.SleepSlowBalls(PhysicsConstants::MIN_VELOCITY);
+
+    LogTime += (double)deltaTime * steps;
+    PairListValid = false;
+#ifndef BILLIARD_NO_PHYSICS_STATS
+    TotalStats.SkippedSteps += steps;
+#endif
+    return steps;
+}
+
+void Physics::ApplyImpulse(BallStore& balls, int ball, const Vec3& direction, float power)
+{
+    if (ball < 0 || ball >= balls.Size() || !balls.IsActive(ball))
         return;
 
     Vec3 impulse = direction.Normalized() * power;
-    ball->Velocity += impulse;
+    Vec3 velocity = balls.GetVelocity(ball) + Vec3(impulse.x, 0.0f, impulse.z);
 
     // Clamp to max velocity
-    float speed = ball->Velocity.Length();
+    float speed = velocity.Length();
     if (speed > PhysicsConstants::MAX_VELOCITY)
     {
-        ball->Velocity = ball->Velocity.Normalized() * PhysicsConstants::MAX_VELOCITY;
+        velocity = velocity.Normalized() * PhysicsConstants::MAX_VELOCITY;
     }
+    balls.SetVelocity(ball, velocity);
 }
 
-bool Physics::AllBallsStopped(const std::vector<Ball*>& balls) const
+bool Physics::AllBallsStopped(const BallStore& balls) const
 {
-    for (const Ball* ball : balls)
+    // Sleeping balls are at rest, so only the awake list needs checking
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+
+    if (Mode == StepMode::Fused)
     {
-        if (ball->IsActive && ball->IsMoving())
+        // The rest test of the last step is still pending: balls below
+        // MIN_VELOCITY will be stopped before they move again
+        const float minSq = PhysicsConstants::MIN_VELOCITY * PhysicsConstants::MIN_VELOCITY;
+        for (int k = 0; k < numAwake; k++)
+        {
+            int i = awake[k];
+            if (balls.IsActive(i) && !(balls.VelX[i] * balls.VelX[i] + balls.VelZ[i] * balls.VelZ[i] < minSq))
+                return false;
+        }
+        return true;
+    }
+
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awake[k];
+        if (balls.IsActive(i) && balls.IsMoving(i))
             return false;
     }
     return true;
 }
 
-void Physics::ApplyFriction(std::vector<Ball*>& balls, float deltaTime)
+void Physics::SetInstructionSet(PhysicsKernels::InstructionSet set)
 {
-    // Exponential friction: ROLLING_FRICTION is fraction retained per second
-    float frictionFactor = powf(PhysicsConstants::ROLLING_FRICTION, deltaTime);
+    Kernels = set;
+}
 
-    for (Ball* ball : balls)
-    {
-        if (!ball->IsActive)
-            continue;
+PhysicsKernels::InstructionSet Physics::GetInstructionSet() const
+{
+    return Kernels;
+}
 
-        // Exponential decay
-        ball->Velocity *= frictionFactor;
+void Physics::SetStepMode(StepMode mode)
+{
+    Mode = mode;
+}
 
-        // Linear deceleration to help balls stop cleanly at low speeds
-        float speed = ball->Velocity.Length();
-        if (speed > 0.0001f)
-        {
-            float reduction = PhysicsConstants::LINEAR_DECELERATION * deltaTime;
-            float newSpeed = speed - reduction;
-            if (newSpeed < 0.0f) newSpeed = 0.0f;
-            ball->Velocity = ball->Velocity * (newSpeed / speed);
-        }
-    }
+StepMode Physics::GetStepMode() const
+{
+    return Mode;
 }
 
-void Physics::IntegratePositions(std::vector<Ball*>& balls, float deltaTime)
+void Physics::SetBroadphase(Broadphase method)
 {
-    for (Ball* ball : balls)
-    {
-        if (!ball->IsActive)
-            continue;
+    Method = method;
+    PairListValid = false;
+}
+
+Broadphase Physics::GetBroadphase() const
+{
+    return Method;
+}
+
+void Physics::SetIterationMode(IterationMode mode)
+{
+    Iterations = mode;
+}
+
+IterationMode Physics::GetIterationMode() const
+{
+    return Iterations;
+}
+
+void Physics::SetMaxIterations(int maxIterations)
+{
+    MaxIterations = maxIterations > 1 ? maxIterations : 1;
+}
+
+int Physics::GetMaxIterations() const
+{
+    return MaxIterations;
+}
 
-        ball->Update(deltaTime);
+int Physics::GetLastIterationCount() const
+{
+    return LastIterations;
+}
+
+float Physics::GetResidualPenetration() const
+{
+    return ResidualPenetration;
+}
+
+void Physics::SetFastForward(bool enabled)
+{
+    FastForward = enabled;
+}
+
+bool Physics::GetFastForward() const
+{
+    return FastForward;
+}
+
+void Physics::SetContinuousCollision(bool enabled)
+{
+    ContinuousCollision = enabled;
+}
+
+bool Physics::GetContinuousCollision() const
+{
+    return ContinuousCollision;
+}
+
+int Physics::GetMissedCollisionCount() const
+{
+    return MissedCollisions;
+}
+
+void Physics::ResetMissedCollisionCount()
+{
+    MissedCollisions = 0;
+}
+
+void Physics::SetEventLog(std::vector<PhysicsEvent>* log)
+{
+    EventLog = log;
+    LogTime = 0.0;
+}
+
+void Physics::LogEvent(PhysicsEventType type, int ball, int other, double time)
+{
+    switch (type)
+    {
+    case PhysicsEventType::BallContact: PHYSICS_STAT(Impulses, 1); break;
+    case PhysicsEventType::CushionHit:  PHYSICS_STAT(CushionHits, 1); break;
+    default:                            PHYSICS_STAT(PocketEvents, 1); break;
     }
+
+    if (EventLog)
+        EventLog->push_back({ type, (float)time, ball, other });
 }
 
-void Physics::ResolveBallCollisions(std::vector<Ball*>& balls)
+void Physics::ApplyFriction(BallStore& balls, float deltaTime)
 {
-    int numBalls = (int)balls.size();
+    // Exponential friction: ROLLING_FRICTION is fraction retained per second
+    float frictionFactor = FrictionFactor(deltaTime);
+
+    // Linear deceleration to help balls stop cleanly at low speeds
+    float reduction = PhysicsConstants::LINEAR_DECELERATION * deltaTime;
 
+    PhysicsKernels::ApplyFriction(Kernels, balls.VelX, balls.VelZ, balls.Awake,
+                                  balls.Size(), frictionFactor, reduction);
+}
+
+void Physics::IntegratePositions(BallStore& balls, float deltaTime)
+{
+    // Simple Euler integration
+    PhysicsKernels::IntegratePositions(Kernels, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ,
+                                       balls.Awake, balls.Size(), deltaTime);
+}
+
+/**
+ * Depth of the overlap of two balls (positive when they overlap)
+ */
+static float OverlapDepth(const BallStore& balls, int a, int b)
+{
+    float dx = balls.PosX[b] - balls.PosX[a];
+    float dz = balls.PosZ[b] - balls.PosZ[a];
+    return balls.Radius[a] + balls.Radius[b] - sqrtf(dx * dx + dz * dz);
+}
+
+float Physics::ResolveBallCollisions(BallStore& balls, const TableGeometry& table)
+{
+    // Only pairs with at least one awake ball can start touching
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    if (numAwake == 0)
+        return 0.0f;
+
+    int numBalls = balls.Size();
+
+    int numActive = 0;
     for (int i = 0; i < numBalls; i++)
     {
-        for (int j = i + 1; j < numBalls; j++)
+        if (balls.IsActive(i))
+            numActive++;
+    }
+
+    // Gather the touching pairs first, then resolve them in index order like the
+    // all-pairs loop (only the few contacts are sorted, not every candidate)
+    Contacts.clear();
+
+    Broadphase method = Method;
+    if (method == Broadphase::Auto)
+    {
+        // Products in 64 bits: awake * active overflows int from about 46,000 balls
+        long long awakeSq = (long long)numAwake * numAwake;
+        long long allPairsTests = (long long)numAwake * numActive;
+        bool useGrid = numActive > PhysicsConstants::GRID_BROADPHASE_THRESHOLD &&
+                       awakeSq > (long long)PhysicsConstants::GRID_AWAKE_FACTOR * numActive;
+        if (useGrid)
+            method = Broadphase::Grid;
+        else if (allPairsTests <= PhysicsConstants::ALL_PAIRS_MAX_TESTS ||
+                 (numBalls <= PhysicsKernels::MAX_OVERLAP_BALLS && Kernels != PhysicsKernels::InstructionSet::Scalar))
+            method = Broadphase::AllPairs;
+        else
+            method = Broadphase::SweepAndPrune;
+    }
+
+    if (method == Broadphase::Grid)
+    {
+        // Broadphase: only balls in neighbouring cells can touch
+        Grid.Build(balls, table);
+        Grid.FindAwakePairs(balls, CandidatePairs);
+
+        for (const BallPair& pair : CandidatePairs)
+        {
+            if (CheckBallCollision(balls, pair.A, pair.B))
+                Contacts.push_back(pair);
+        }
+        PHYSICS_STAT(PairsTested, (long long)CandidatePairs.size());
+    }
+    else if (method == Broadphase::SweepAndPrune)
+    {
+        // The pairs found in the first pass serve the later passes until a
+        // ball has been pushed further than the margin; balls woken since
+        // add their own pairs
+        if (!PairListValid || Sweep.HasMoved(balls))
         {
-            Ball* a = balls[i];
-            Ball* b = balls[j];
+            Sweep.Update(balls);
+            Sweep.FindAwakePairs(balls, CandidatePairs);
+            PairListValid = true;
+        }
+        else
+        {
+            for (int k = PairListAwake; k < numAwake; k++)
+                Sweep.FindBallPairs(awake[k], CandidatePairs);
+        }
+        PairListAwake = numAwake;
 
-            if (!a->IsActive || !b->IsActive)
+        for (const BallPair& pair : CandidatePairs)
+        {
+            if (CheckBallCollision(balls, pair.A, pair.B))
+                Contacts.push_back(pair);
+        }
+        PHYSICS_STAT(PairsTested, (long long)CandidatePairs.size());
+    }
+    else if (numBalls <= PhysicsKernels::MAX_OVERLAP_BALLS && Kernels != PhysicsKernels::InstructionSet::Scalar)
+    {
+        // Each awake ball against all balls in one SIMD sweep
+        uint32_t overlaps[PhysicsKernels::MAX_OVERLAP_BALLS];
+        int tested = PhysicsKernels::FindOverlaps(Kernels, balls.PosX, balls.PosZ, balls.Radius,
+                                                  balls.Active, balls.Awake, numBalls,
+                                                  awake, numAwake, overlaps);
+        for (int k = 0; k < numAwake; k++)
+        {
+            int i = awake[k];
+            uint32_t row = overlaps[k];
+            for (int j = 0; row != 0; j++, row >>= 1)
+            {
+                if (!(row & 1u))
+                    continue;
+                if (j > i)
+                    Contacts.push_back({ i, j });
+                else
+                    Contacts.push_back({ j, i });
+            }
+        }
+        PHYSICS_STAT(PairsTested, tested);
+    }
+    else
+    {
+        // Every awake ball against every other active ball
+        long long tested = 0;
+        for (int k = 0; k < numAwake; k++)
+        {
+            int i = awake[k];
+            if (!balls.IsActive(i))
                 continue;
 
-            if (CheckBallCollision(a, b))
+            for (int j = 0; j < numBalls; j++)
             {
-                ResolveBallCollision(a, b);
+                if (j == i || !balls.IsActive(j))
+                    continue;
+
+                // Awake-awake pairs are found from both sides; keep the one from the lower index
+                if (balls.IsAwake(j) && j < i)
+                    continue;
+
+                tested++;
+                if (CheckBallCollision(balls, i, j))
+                {
+                    if (j > i)
+                        Contacts.push_back({ i, j });
+                    else
+                        Contacts.push_back({ j, i });
+                }
             }
         }
+        PHYSICS_STAT(PairsTested, tested);
+    }
+
+    // Woken balls can add a pair that is already listed
+    SpatialGrid::SortPairs(Contacts);
+    Contacts.erase(std::unique(Contacts.begin(), Contacts.end(), [](const BallPair& a, const BallPair& b)
+    {
+        return a.A == b.A && a.B == b.B;
+    }), Contacts.end());
+    PHYSICS_STAT(Overlaps, (long long)Contacts.size());
+
+    float deepest = 0.0f;
+    for (const BallPair& pair : Contacts)
+    {
+        // Earlier resolutions may have separated this pair
+        if (CheckBallCollision(balls, pair.A, pair.B))
+        {
+            float overlap = OverlapDepth(balls, pair.A, pair.B);
+            if (overlap > deepest)
+                deepest = overlap;
+
+            // A sleeping ball wakes up when it is hit
+            balls.Wake(pair.A);
+            balls.Wake(pair.B);
+            if (ResolveBallCollision(balls, pair.A, pair.B))
+                LogEvent(PhysicsEventType::BallContact, pair.A, pair.B, LogTime);
+        }
     }
+    return deepest;
 }
 
-bool Physics::CheckBallCollision(const Ball* a, const Ball* b) const
+bool Physics::CheckBallCollision(const BallStore& balls, int a, int b) const
 {
-    Vec3 diff = b->Position - a->Position;
-    float distSq = diff.LengthSquared();
-    float minDist = a->Radius + b->Radius;
+    float dx = balls.PosX[b] - balls.PosX[a];
+    float dz = balls.PosZ[b] - balls.PosZ[a];
+    float distSq = dx * dx + dz * dz;
+    float minDist = balls.Radius[a] + balls.Radius[b];
     return distSq < minDist * minDist;
 }
 
-void Physics::ResolveBallCollision(Ball* a, Ball* b)
+bool Physics::ResolveBallCollision(BallStore& balls, int a, int b)
 {
     // Vector from a to b
-    Vec3 delta = b->Position - a->Position;
-    float dist = delta.Length();
+    float dx = balls.PosX[b] - balls.PosX[a];
+    float dz = balls.PosZ[b] - balls.PosZ[a];
+    float dist = sqrtf(dx * dx + dz * dz);
 
     if (dist < 0.0001f)
     {
         // Balls are at same position, push apart
-        delta = Vec3(1.0f, 0.0f, 0.0f);
+        dx = 1.0f;
+        dz = 0.0f;
         dist = 0.0001f;
     }
 
     // Normal from a to b
-    Vec3 normal = delta / dist;
+    float nx = dx / dist;
+    float nz = dz / dist;
 
     // Penetration depth
-    float overlap = (a->Radius + b->Radius) - dist;
+    float overlap = (balls.Radius[a] + balls.Radius[b]) - dist;
 
     // Separate the balls (push each half the overlap distance)
-    Vec3 separation = normal * (overlap / 2.0f);
-    a->Position -= separation;
-    b->Position += separation;
-
-    // Keep balls on the surface
-    a->Position.y = a->Radius;
-    b->Position.y = b->Radius;
+    float push = overlap / 2.0f;
+    balls.PosX[a] -= nx * push;
+    balls.PosZ[a] -= nz * push;
+    balls.PosX[b] += nx * push;
+    balls.PosZ[b] += nz * push;
 
     // Calculate relative velocity
-    Vec3 relVel = a->Velocity - b->Velocity;
+    float relVx = balls.VelX[a] - balls.VelX[b];
+    float relVz = balls.VelZ[a] - balls.VelZ[b];
 
     // Relative velocity along collision normal (normal points from a to b)
     // Positive = approaching, Negative = separating
-    float velAlongNormal = Dot(relVel, normal);
+    float velAlongNormal = relVx * nx + relVz * nz;
 
     // Only resolve if balls are approaching (positive means a moves toward b)
     if (velAlongNormal < 0)
-        return;
+        return false;
 
     // Calculate impulse scalar (assuming equal mass)
     // j = -(1 + e) * velAlongNormal / (1/m1 + 1/m2)
@@ -167,150 +734,677 @@ void Physics::ResolveBallCollision(Ball* a, Ball* b)
     float j = -(1.0f + e) * velAlongNormal / 2.0f;
 
     // Apply impulse
-    Vec3 impulse = normal * j;
-    a->Velocity += impulse;
-    b->Velocity -= impulse;
+    balls.VelX[a] += nx * j;
+    balls.VelZ[a] += nz * j;
+    balls.VelX[b] -= nx * j;
+    balls.VelZ[b] -= nz * j;
+    return true;
 }
 
-void Physics::ResolveCushionCollisions(std::vector<Ball*>& balls, const Table& table)
+float Physics::ResolveCushionCollisions(BallStore& balls, const TableGeometry& table)
 {
+    if (table.GetCushionBackend() == CushionBackend::Segments)
+        return ResolveSegmentCollisions(balls, table);
+    if (table.GetCushionBackend() == CushionBackend::DistanceField)
+        return ResolveFieldCollisions(balls, table);
+
     float minX = table.GetMinX();
     float maxX = table.GetMaxX();
     float minZ = table.GetMinZ();
     float maxZ = table.GetMaxZ();
 
     float e = PhysicsConstants::CUSHION_RESTITUTION;
+    float railBand = table.GetRailBandWidth();
+
+    float* posX = balls.PosX;
+    float* posZ = balls.PosZ;
+    float* velX = balls.VelX;
+    float* velZ = balls.VelZ;
 
-    for (Ball* ball : balls)
+    // Sleeping balls rest inside the cushions
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    float deepest = 0.0f;
+    for (int k = 0; k < numAwake; k++)
     {
-        if (!ball->IsActive)
+        int i = awake[k];
+        if (!balls.IsActive(i))
             continue;
 
-        // Skip cushion collision if ball is in a pocket gap area
-        if (IsInPocketGap(ball->Position, table))
+        float r = balls.Radius[i];
+
+        // Balls in open table cannot reach a rail this step
+        uint8_t zone = table.GetZone(posX[i], posZ[i]);
+        if (!(zone & TableGeometry::ZONE_RAIL) && r < railBand)
             continue;
 
-        float r = ball->Radius;
+        // Skip cushion collision if ball is in a pocket gap area
+        if (table.IsInPocketGap(posX[i], posZ[i], zone))
+            continue;
 
         // Left cushion
-        if (ball->Position.x - r < minX)
+        if (posX[i] - r < minX)
         {
-            ball->Position.x = minX + r;
-            if (ball->Velocity.x < 0)
-                ball->Velocity.x = -ball->Velocity.x * e;
+            deepest = std::max(deepest, minX - (posX[i] - r));
+            posX[i] = minX + r;
+            if (velX[i] < 0)
+            {
+                velX[i] = -velX[i] * e;
+                LogEvent(PhysicsEventType::CushionHit, i, 0, LogTime);
+            }
         }
 
         // Right cushion
-        if (ball->Position.x + r > maxX)
+        if (posX[i] + r > maxX)
         {
-            ball->Position.x = maxX - r;
-            if (ball->Velocity.x > 0)
-                ball->Velocity.x = -ball->Velocity.x * e;
+            deepest = std::max(deepest, posX[i] + r - maxX);
+            posX[i] = maxX - r;
+            if (velX[i] > 0)
+            {
+                velX[i] = -velX[i] * e;
+                LogEvent(PhysicsEventType::CushionHit, i, 1, LogTime);
+            }
         }
 
         // Back cushion (near -Z)
-        if (ball->Position.z - r < minZ)
+        if (posZ[i] - r < minZ)
         {
-            ball->Position.z = minZ + r;
-            if (ball->Velocity.z < 0)
-                ball->Velocity.z = -ball->Velocity.z * e;
+            deepest = std::max(deepest, minZ - (posZ[i] - r));
+            posZ[i] = minZ + r;
+            if (velZ[i] < 0)
+            {
+                velZ[i] = -velZ[i] * e;
+                LogEvent(PhysicsEventType::CushionHit, i, 2, LogTime);
+            }
         }
 
         // Front cushion (near +Z)
-        if (ball->Position.z + r > maxZ)
+        if (posZ[i] + r > maxZ)
         {
-            ball->Position.z = maxZ - r;
-            if (ball->Velocity.z > 0)
-                ball->Velocity.z = -ball->Velocity.z * e;
+            deepest = std::max(deepest, posZ[i] + r - maxZ);
+            posZ[i] = maxZ - r;
+            if (velZ[i] > 0)
+            {
+                velZ[i] = -velZ[i] * e;
+                LogEvent(PhysicsEventType::CushionHit, i, 3, LogTime);
+            }
         }
     }
+    return deepest;
 }
 
-void Physics::ClampVelocities(std::vector<Ball*>& balls)
+/**
+ * Unit normal from the closest point of a cushion segment to a ball center
+ * @return Distance from the segment, or 0 if the center lies on it (normal undefined)
+ */
+static float SegmentNormal(const CushionSegment& s, float x, float z, float& nx, float& nz)
 {
-    for (Ball* ball : balls)
+    float dx = s.BX - s.AX;
+    float dz = s.BZ - s.AZ;
+    float lenSq = dx * dx + dz * dz;
+    float t = lenSq > 0.0f ? ((x - s.AX) * dx + (z - s.AZ) * dz) / lenSq : 0.0f;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+    nx = x - (s.AX + dx * t);
+    nz = z - (s.AZ + dz * t);
+    float dist = sqrtf(nx * nx + nz * nz);
+    if (dist < 1e-6f)
+        return 0.0f;
+
+    nx /= dist;
+    nz /= dist;
+    return dist;
+}
+
+/**
+ * Reflect the normal part of a velocity with cushion restitution, if it points into the cushion
+ * @return true if the ball bounced
+ */
+static bool BounceOff(float nx, float nz, float& vx, float& vz)
+{
+    float vn = vx * nx + vz * nz;
+    if (vn >= 0.0f)
+        return false;
+
+    float j = (1.0f + PhysicsConstants::CUSHION_RESTITUTION) * vn;
+    vx -= j * nx;
+    vz -= j * nz;
+    return true;
+}
+
+float Physics::ResolveSegmentCollisions(BallStore& balls, const TableGeometry& table)
+{
+    const CushionBVH& cushions = table.GetCushions();
+    const CushionSegment* segments = cushions.GetSegments();
+    float railBand = table.GetRailBandWidth();
+
+    float* posX = balls.PosX;
+    float* posZ = balls.PosZ;
+    float* velX = balls.VelX;
+    float* velZ = balls.VelZ;
+
+    // Sleeping balls rest clear of the cushions
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    float deepest = 0.0f;
+    for (int k = 0; k < numAwake; k++)
     {
-        if (!ball->IsActive)
+        int i = awake[k];
+        if (!balls.IsActive(i))
             continue;
 
-        float speed = ball->Velocity.Length();
-        if (speed > PhysicsConstants::MAX_VELOCITY)
+        // Balls in open table cannot reach a cushion this step
+        float r = balls.Radius[i];
+        if (!(table.GetZone(posX[i], posZ[i]) & TableGeometry::ZONE_RAIL) && r < railBand)
+            continue;
+
+        cushions.Query(posX[i] - r, posZ[i] - r, posX[i] + r, posZ[i] + r, CushionCandidates);
+        for (int s : CushionCandidates)
         {
-            ball->Velocity = ball->Velocity.Normalized() * PhysicsConstants::MAX_VELOCITY;
+            float nx, nz;
+            float dist = SegmentNormal(segments[s], posX[i], posZ[i], nx, nz);
+            if (dist <= 0.0f || dist >= r)
+                continue;
+
+            // Push the ball out to touching, then bounce if it was moving in
+            deepest = std::max(deepest, r - dist);
+            posX[i] += nx * (r - dist);
+            posZ[i] += nz * (r - dist);
+            if (BounceOff(nx, nz, velX[i], velZ[i]))
+                LogEvent(PhysicsEventType::CushionHit, i, segments[s].Rail, LogTime);
         }
     }
+    return deepest;
 }
 
-void Physics::StopSlowBalls(std::vector<Ball*>& balls)
+float Physics::ResolveFieldCollisions(BallStore& balls, const TableGeometry& table)
 {
-    for (Ball* ball : balls)
+    const DistanceField& field = table.GetDistanceField();
+    float railBand = table.GetRailBandWidth();
+
+    float* posX = balls.PosX;
+    float* posZ = balls.PosZ;
+    float* velX = balls.VelX;
+    float* velZ = balls.VelZ;
+
+    // Sleeping balls rest clear of the cushions
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    float deepest = 0.0f;
+    for (int k = 0; k < numAwake; k++)
     {
-        if (!ball->IsActive)
+        int i = awake[k];
+        if (!balls.IsActive(i))
+            continue;
+
+        // Balls in open table cannot reach a cushion this step
+        float r = balls.Radius[i];
+        if (!(table.GetZone(posX[i], posZ[i]) & TableGeometry::ZONE_RAIL) && r < railBand)
+            continue;
+
+        float gx, gz;
+        float dist = field.Sample(posX[i], posZ[i], gx, gz);
+        if (dist >= r)
+            continue;
+
+        float len = sqrtf(gx * gx + gz * gz);
+        if (len < 1e-6f)
             continue;
+        float nx = gx / len;
+        float nz = gz / len;
+
+        // Push the ball out to touching, then bounce if it was moving in
+        deepest = std::max(deepest, r - dist);
+        posX[i] += nx * (r - dist);
+        posZ[i] += nz * (r - dist);
+        if (BounceOff(nx, nz, velX[i], velZ[i]))
+            LogEvent(PhysicsEventType::CushionHit, i, -1, LogTime);
+    }
+    return deepest;
+}
+
+/**
+ * Earliest fraction of a step at which two moving circles touch
+ * @param sepX, sepZ   Separation of the centers at the start of the step
+ * @param moveX, moveZ Change of that separation over the step
+ * @param minDist      Sum of the radii
+ * @return Fraction in [0, 1], or -1 if they do not touch while approaching
+ *         (circles that already overlap are left to the overlap tests)
+ */
+static float SweepCircles(float sepX, float sepZ, float moveX, float moveZ, float minDist)
+{
+    float c = sepX * sepX + sepZ * sepZ - minDist * minDist;
+    if (c < 0.0f)
+        return -1.0f;
 
-        if (ball->Velocity.LengthSquared() < PhysicsConstants::MIN_VELOCITY * PhysicsConstants::MIN_VELOCITY)
+    float b = sepX * moveX + sepZ * moveZ;
+    if (b >= 0.0f)
+        return -1.0f;
+
+    float a = moveX * moveX + moveZ * moveZ;
+    float disc = b * b - a * c;
+    if (disc < 0.0f)
+        return -1.0f;
+
+    float t = (-b - sqrtf(disc)) / a;
+    return t <= 1.0f ? t : -1.0f;
+}
+
+/**
+ * Earliest fraction of a step at which a moving ball touches a cushion segment
+ * (the sides of the segment and its two end points)
+ * @return Fraction in [0, 1], or -1 if it does not touch while approaching
+ *         (a ball that already overlaps is left to the overlap tests)
+ */
+static float SweepSegment(const CushionSegment& s, float startX, float startZ, float moveX, float moveZ, float r)
+{
+    float best = SweepCircles(s.AX - startX, s.AZ - startZ, -moveX, -moveZ, r);
+    float t = SweepCircles(s.BX - startX, s.BZ - startZ, -moveX, -moveZ, r);
+    if (t >= 0.0f && (best < 0.0f || t < best))
+        best = t;
+
+    float dx = s.BX - s.AX;
+    float dz = s.BZ - s.AZ;
+    float len = sqrtf(dx * dx + dz * dz);
+    if (len <= 0.0f)
+        return best;
+
+    // Side facing the start of the path
+    float nx = -dz / len;
+    float nz = dx / len;
+    float side = (startX - s.AX) * nx + (startZ - s.AZ) * nz;
+    float approach = moveX * nx + moveZ * nz;
+    if (side < 0.0f)
+    {
+        side = -side;
+        approach = -approach;
+    }
+
+    if (side >= r && approach < 0.0f)
+    {
+        t = (side - r) / -approach;
+        if (t <= 1.0f)
         {
-            ball->Stop();
+            float along = (startX + moveX * t - s.AX) * dx + (startZ + moveZ * t - s.AZ) * dz;
+            if (along >= 0.0f && along <= len * len && (best < 0.0f || t < best))
+                best = t;
         }
     }
+    return best;
 }
 
-void Physics::CheckPockets(std::vector<Ball*>& balls, const Table& table)
+/**
+ * Earliest fraction of a step at which a moving ball touches the boundary of a
+ * distance field, found by stepping along the path by the free distance
+ * (sphere tracing: each step is as long as the field says is clear)
+ * @return Fraction in [0, 1], or -1 if it does not touch
+ *         (a ball that already touches is left to the overlap tests)
+ */
+static float SweepField(const DistanceField& field, float startX, float startZ, float moveX, float moveZ, float r)
 {
+    const int MAX_STEPS = 16;
+    const float CONTACT_TOLERANCE = 1e-4f;
+
+    float length = sqrtf(moveX * moveX + moveZ * moveZ);
+    if (length <= 0.0f)
+        return -1.0f;
+
+    float gx, gz;
+    float t = 0.0f;
+    for (int step = 0; step < MAX_STEPS; step++)
+    {
+        float clear = field.Sample(startX + moveX * t, startZ + moveZ * t, gx, gz) - r;
+        if (clear <= CONTACT_TOLERANCE)
+            return step == 0 ? -1.0f : t;
+
+        t += clear / length;
+        if (t > 1.0f)
+            return -1.0f;
+    }
+    return t;
+}
+
+void Physics::ResolveSweptCollisions(BallStore& balls, const TableGeometry& table, float deltaTime)
+{
+    if (deltaTime <= 0.0f)
+        return;
+
+    enum HitType { HIT_NONE, HIT_BALL, HIT_CUSHION, HIT_POCKET };
+
+    float minX = table.GetMinX();
+    float maxX = table.GetMaxX();
+    float minZ = table.GetMinZ();
+    float maxZ = table.GetMaxZ();
     const Vec3* pockets = table.GetPocketPositions();
     float pr = table.GetPocketRadius();
-    float prSq = pr * pr;
 
-    for (Ball* ball : balls)
+    // Segment cushions (nullptr unless the table uses them) or distance field
+    const CushionSegment* segments = nullptr;
+    if (table.GetCushionBackend() == CushionBackend::Segments)
+        segments = table.GetCushions().GetSegments();
+    const DistanceField* field = nullptr;
+    if (table.GetCushionBackend() == CushionBackend::DistanceField)
+        field = &table.GetDistanceField();
+
+    int numBalls = balls.Size();
+    float* posX = balls.PosX;
+    float* posZ = balls.PosZ;
+    float* velX = balls.VelX;
+    float* velZ = balls.VelZ;
+    const float* startPosX = StepStartX.data();
+    const float* startPosZ = StepStartZ.data();
+
+    // A swept hit changes the velocities of the balls it resolves, so their
+    // paths are no longer straight from the start: they are held where the
+    // hit left them for the rest of the sweep (the collision passes see them next)
+    SweptDone.assign(numBalls, 0);
+
+    // Only awake balls move. Balls woken by a swept hit below are appended to
+    // the list but not swept themselves: their step was already finished
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    for (int k = 0; k < numAwake; k++)
     {
-        if (!ball->IsActive)
+        int i = awake[k];
+        if (!balls.IsActive(i) || SweptDone[i])
             continue;
 
-        for (int i = 0; i < Table::NUM_POCKETS; i++)
+        float r = balls.Radius[i];
+        float startX = startPosX[i];
+        float startZ = startPosZ[i];
+        float endX = posX[i];
+        float endZ = posZ[i];
+        float moveX = endX - startX;
+        float moveZ = endZ - startZ;
+        float sweepDist = PhysicsConstants::SWEEP_THRESHOLD * r;
+        if (moveX * moveX + moveZ * moveZ <= sweepDist * sweepDist)
+            continue;
+
+        HitType hit = HIT_NONE;
+        float hitT = 2.0f;
+        int other = -1;
+
+        // Other balls, each moving along its own path
+        for (int j = 0; j < numBalls; j++)
         {
-            // Distance check on XZ plane only
-            // Ball is potted when its center enters the pocket circle,
-            // which corresponds to ~50% of the ball being over the hole
-            float dx = ball->Position.x - pockets[i].x;
-            float dz = ball->Position.z - pockets[i].z;
-            float distSq = dx * dx + dz * dz;
-
-            if (distSq < prSq)
+            if (j == i || !balls.IsActive(j))
+                continue;
+
+            // Sleeping and finished balls stand still at their current position
+            bool moving = balls.IsAwake(j) && !SweptDone[j];
+            float fromX = moving ? startPosX[j] : posX[j];
+            float fromZ = moving ? startPosZ[j] : posZ[j];
+            float sepX = fromX - startX;
+            float sepZ = fromZ - startZ;
+            float relX = (posX[j] - fromX) - moveX;
+            float relZ = (posZ[j] - fromZ) - moveZ;
+
+            float t = SweepCircles(sepX, sepZ, relX, relZ, r + balls.Radius[j]);
+            if (t >= 0.0f && t < hitT)
+            {
+                hit = HIT_BALL;
+                hitT = t;
+                other = j;
+            }
+        }
+
+        // Cushions the path reaches
+        int rail = -1;
+        int segment = -1;
+        if (field)
+        {
+            float t = SweepField(*field, startX, startZ, moveX, moveZ, r);
+            if (t >= 0.0f && t < hitT)
             {
-                if (ball->Number == 0)
+                hit = HIT_CUSHION;
+                hitT = t;
+            }
+        }
+        else if (segments)
+        {
+            // Segments whose bounds overlap the bounds of the path
+            table.GetCushions().Query(std::min(startX, endX) - r, std::min(startZ, endZ) - r,
+                                      std::max(startX, endX) + r, std::max(startZ, endZ) + r, CushionCandidates);
+            for (int s : CushionCandidates)
+            {
+                float t = SweepSegment(segments[s], startX, startZ, moveX, moveZ, r);
+                if (t >= 0.0f && t < hitT)
                 {
-                    // Cue ball: respawn at original position
-                    ball->Position = Vec3(0.0f, ball->Radius, 2.0f);
-                    ball->Velocity = Vec3(0.0f, 0.0f, 0.0f);
+                    hit = HIT_CUSHION;
+                    hitT = t;
+                    segment = s;
                 }
-                else
+            }
+        }
+        else
+        {
+            // Rails crossed by the path (0 = left, 1 = right, 2 = back, 3 = front)
+            float railT[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+            if (endX - r < minX && startX - r >= minX)
+                railT[0] = (startX - r - minX) / (startX - endX);
+            if (endX + r > maxX && startX + r <= maxX)
+                railT[1] = (maxX - r - startX) / (endX - startX);
+            if (endZ - r < minZ && startZ - r >= minZ)
+                railT[2] = (startZ - r - minZ) / (startZ - endZ);
+            if (endZ + r > maxZ && startZ + r <= maxZ)
+                railT[3] = (maxZ - r - startZ) / (endZ - startZ);
+
+            for (int side = 0; side < 4; side++)
+            {
+                if (railT[side] < 0.0f || railT[side] >= hitT)
+                    continue;
+
+                // The rail is open where the contact point lies in a pocket gap
+                if (table.IsInPocketGap(startX + moveX * railT[side], startZ + moveZ * railT[side]))
+                    continue;
+
+                hit = HIT_CUSHION;
+                hitT = railT[side];
+                rail = side;
+            }
+        }
+
+        // Pockets the path enters
+        for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+        {
+            float t = SweepCircles(pockets[p].x - startX, pockets[p].z - startZ, -moveX, -moveZ, pr);
+            if (t >= 0.0f && t < hitT)
+            {
+                hit = HIT_POCKET;
+                hitT = t;
+                other = p;
+            }
+        }
+
+        if (hit == HIT_NONE)
+            continue;
+
+        // Would the end-of-step tests have caught this contact?
+        bool caught = false;
+        if (hit == HIT_BALL)
+        {
+            caught = CheckBallCollision(balls, i, other);
+        }
+        else if (hit == HIT_CUSHION)
+        {
+            float nx, nz;
+            if (field)
+                caught = field->Sample(endX, endZ, nx, nz) < r;
+            else if (segment >= 0)
+                caught = SegmentNormal(segments[segment], endX, endZ, nx, nz) < r;
+            else
+                caught = !table.IsInPocketGap(endX, endZ);
+        }
+        else
+        {
+            float dx = endX - pockets[other].x;
+            float dz = endZ - pockets[other].z;
+            caught = dx * dx + dz * dz < pr * pr;
+        }
+
+        if (!caught)
+            MissedCollisions++;
+
+        if (!ContinuousCollision)
+            continue;
+
+        float hitTime = hitT * deltaTime;
+        float remaining = deltaTime - hitTime;
+        SweptDone[i] = 1;
+
+        if (hit == HIT_BALL)
+        {
+            // Rewind both balls to the time of impact, collide, then finish the
+            // step (a ball standing still stays where it is)
+            int j = other;
+            bool jMoves = balls.IsAwake(j) && !SweptDone[j];
+            balls.Wake(j);
+            SweptDone[j] = 1;
+            posX[i] = startX + moveX * hitT;
+            posZ[i] = startZ + moveZ * hitT;
+            if (jMoves)
+            {
+                posX[j] = startPosX[j] + (posX[j] - startPosX[j]) * hitT;
+                posZ[j] = startPosZ[j] + (posZ[j] - startPosZ[j]) * hitT;
+            }
+
+            if (ResolveBallCollision(balls, i, j))
+                LogEvent(PhysicsEventType::BallContact, i, j, LogTime - deltaTime + hitTime);
+
+            posX[i] += velX[i] * remaining;
+            posZ[i] += velZ[i] * remaining;
+            if (jMoves)
+            {
+                posX[j] += velX[j] * remaining;
+                posZ[j] += velZ[j] * remaining;
+            }
+        }
+        else if (hit == HIT_CUSHION)
+        {
+            // Bounce at the contact point, then finish the step
+            float e = PhysicsConstants::CUSHION_RESTITUTION;
+            posX[i] = startX + moveX * hitT;
+            posZ[i] = startZ + moveZ * hitT;
+
+            if (field)
+            {
+                float gx, gz;
+                field->Sample(posX[i], posZ[i], gx, gz);
+                float len = sqrtf(gx * gx + gz * gz);
+                if (len > 1e-6f)
+                    BounceOff(gx / len, gz / len, velX[i], velZ[i]);
+            }
+            else if (segment >= 0)
+            {
+                float nx, nz;
+                SegmentNormal(segments[segment], posX[i], posZ[i], nx, nz);
+                BounceOff(nx, nz, velX[i], velZ[i]);
+                rail = segments[segment].Rail;
+            }
+            else
+            {
+                switch (rail)
                 {
-                    // Regular ball: deactivate
-                    ball->IsActive = false;
-                    ball->Velocity = Vec3(0.0f, 0.0f, 0.0f);
+                case 0: posX[i] = minX + r; velX[i] = -velX[i] * e; break;
+                case 1: posX[i] = maxX - r; velX[i] = -velX[i] * e; break;
+                case 2: posZ[i] = minZ + r; velZ[i] = -velZ[i] * e; break;
+                case 3: posZ[i] = maxZ - r; velZ[i] = -velZ[i] * e; break;
                 }
-                break;
             }
+            LogEvent(PhysicsEventType::CushionHit, i, rail, LogTime - deltaTime + hitTime);
+
+            posX[i] += velX[i] * remaining;
+            posZ[i] += velZ[i] * remaining;
+        }
+        else
+        {
+            PotBall(balls, i, other);
         }
     }
 }
 
-bool Physics::IsInPocketGap(const Vec3& pos, const Table& table) const
+void Physics::FusedIntegrate(BallStore& balls, float deltaTime)
 {
-    const Vec3* pockets = table.GetPocketPositions();
-    float pr = table.GetPocketRadius();
-    // Cushion gap matches pocket radius; use 1.5x for margin so balls
-    // can smoothly enter pockets without catching on cushion edges
-    float gapThreshold = pr * 1.5f;
+    float frictionFactor = FrictionFactor(deltaTime);
+    float reduction = PhysicsConstants::LINEAR_DECELERATION * deltaTime;
+
+    PhysicsKernels::FusedStep(Kernels, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ, balls.Awake,
+                              balls.Size(), PhysicsConstants::MAX_VELOCITY, PhysicsConstants::MIN_VELOCITY,
+                              frictionFactor, reduction, deltaTime);
+}
+
+void Physics::ClampVelocities(BallStore& balls)
+{
+    PhysicsKernels::ClampVelocities(Kernels, balls.VelX, balls.VelZ, balls.Awake,
+                                    balls.Size(), PhysicsConstants::MAX_VELOCITY);
+}
 
-    for (int i = 0; i < Table::NUM_POCKETS; i++)
+void Physics::StopSlowBalls(BallStore& balls)
+{
+    PhysicsKernels::StopSlowBalls(Kernels, balls.VelX, balls.VelZ, balls.Awake,
+                                  balls.Size(), PhysicsConstants::MIN_VELOCITY);
+}
+
+void Physics::CheckPockets(BallStore& balls, const TableGeometry& table)
+{
+    // Sleeping balls are not moving, so they cannot have entered a pocket
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    for (int k = 0; k < numAwake; k++)
     {
-        float dx = pos.x - pockets[i].x;
-        float dz = pos.z - pockets[i].z;
-        float distSq = dx * dx + dz * dz;
+        int i = awake[k];
+        if (!balls.IsActive(i))
+            continue;
 
-        if (distSq < gapThreshold * gapThreshold)
-            return true;
+        // Ball is potted when its center enters a pocket circle (one zone lookup per ball)
+        int pocket = table.FindPocket(balls.PosX[i], balls.PosZ[i]);
+        if (pocket >= 0)
+            PotBall(balls, i, pocket);
     }
-    return false;
+}
+
+void Physics::PotBall(BallStore& balls, int ball, int pocket)
+{
+    bool scratch = balls.Number[ball] == 0;
+    LogEvent(scratch ? PhysicsEventType::Scratch : PhysicsEventType::Pot, ball, pocket, LogTime);
+
+    if (scratch)
+    {
+        // Cue ball: respawn at original position
+        balls.PosX[ball] = 0.0f;
+        balls.PosZ[ball] = 2.0f;
+        balls.Stop(ball);
+    }
+    else
+    {
+        // Regular ball: deactivate
+        balls.SetActive(ball, false);
+        balls.Stop(ball);
+    }
+}
+
+const PhysicsStats& Physics::GetStepStats() const
+{
+    return StepStats;
+}
+
+const PhysicsStats& Physics::GetTotalStats() const
+{
+    return TotalStats;
+}
+
+void Physics::ResetStats()
+{
+    StepStats.Reset();
+    TotalStats.Reset();
+}
+
+void Physics::SetPhaseTiming(bool enabled)
+{
+    PhaseTiming = enabled;
+}
+
+bool Physics::GetPhaseTiming() const
+{
+    return PhaseTiming;
 }
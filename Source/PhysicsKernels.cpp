@@ -0,0 +1,735 @@
+#include "../Header/PhysicsKernels.h"
+#include <cmath>
+
+// ============================================================================
+// PLATFORM SUPPORT
+// The SIMD kernels are compiled with per-function target attributes on
+// GCC/Clang, so the rest of the program keeps the default instruction set
+// and only runs them after the CPU check has passed.
+// ============================================================================
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define KERNEL_SSE2
+#define KERNEL_AVX2
+#else
+#include <cpuid.h>
+#define KERNEL_SSE2 __attribute__((target("sse2")))
+#define KERNEL_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define KERNELS_X86 0
+#endif
+
+namespace PhysicsKernels
+{
+
+// ============================================================================
+// CPU DETECTION
+// ============================================================================
+
+InstructionSet DetectInstructionSet()
+{
+#if KERNELS_X86
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx)
+    {
+        // OS must save YMM state (XCR0 bits 1 and 2)
+        unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) == 0x6)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    bool sse2 = __builtin_cpu_supports("sse2");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return InstructionSet::AVX2;
+    if (sse2)
+        return InstructionSet::SSE2;
+#endif
+    return InstructionSet::Scalar;
+}
+
+const char* GetInstructionSetName(InstructionSet set)
+{
+    switch (set)
+    {
+    case InstructionSet::AVX2: return "AVX2";
+    case InstructionSet::SSE2: return "SSE2";
+    default: return "Scalar";
+    }
+}
+
+// ============================================================================
+// SCALAR KERNELS (reference implementation)
+// ============================================================================
+
+static void FrictionScalar(float* velX, float* velZ, const uint32_t* active,
+                           int count, float frictionFactor, float reduction)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!active[i])
+            continue;
+
+        // Exponential decay
+        float vx = velX[i] * frictionFactor;
+        float vz = velZ[i] * frictionFactor;
+
+        // Linear deceleration to help balls stop cleanly at low speeds
+        float speed = sqrtf(vx * vx + vz * vz);
+        if (speed > 0.0001f)
+        {
+            float newSpeed = speed - reduction;
+            if (newSpeed < 0.0f) newSpeed = 0.0f;
+            float scale = newSpeed / speed;
+            vx = vx * scale;
+            vz = vz * scale;
+        }
+
+        velX[i] = vx;
+        velZ[i] = vz;
+    }
+}
+
+static void IntegrateScalar(float* posX, float* posZ, const float* velX, const float* velZ,
+                            const uint32_t* active, int count, float deltaTime)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!active[i])
+            continue;
+
+        posX[i] += velX[i] * deltaTime;
+        posZ[i] += velZ[i] * deltaTime;
+    }
+}
+
+static void ClampScalar(float* velX, float* velZ, const uint32_t* active, int count, float maxVelocity)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!active[i])
+            continue;
+
+        float vx = velX[i];
+        float vz = velZ[i];
+        float speed = sqrtf(vx * vx + vz * vz);
+        if (speed > maxVelocity)
+        {
+            velX[i] = vx / speed * maxVelocity;
+            velZ[i] = vz / speed * maxVelocity;
+        }
+    }
+}
+
+static void StopScalar(float* velX, float* velZ, const uint32_t* active, int count, float minVelocity)
+{
+    float minSq = minVelocity * minVelocity;
+    for (int i = 0; i < count; i++)
+    {
+        if (!active[i])
+            continue;
+
+        if (velX[i] * velX[i] + velZ[i] * velZ[i] < minSq)
+        {
+            velX[i] = 0.0f;
+            velZ[i] = 0.0f;
+        }
+    }
+}
+
+static void FusedScalar(float* posX, float* posZ, float* velX, float* velZ, const uint32_t* active,
+                        int count, float maxVelocity, float minVelocity,
+                        float frictionFactor, float reduction, float deltaTime)
+{
+    float minSq = minVelocity * minVelocity;
+    for (int i = 0; i < count; i++)
+    {
+        if (!active[i])
+            continue;
+
+        float vx = velX[i];
+        float vz = velZ[i];
+
+        // Clamp and rest test (previous step's collision output)
+        float speed = sqrtf(vx * vx + vz * vz);
+        if (speed > maxVelocity)
+        {
+            vx = vx / speed * maxVelocity;
+            vz = vz / speed * maxVelocity;
+        }
+        if (vx * vx + vz * vz < minSq)
+        {
+            vx = 0.0f;
+            vz = 0.0f;
+        }
+
+        // Friction
+        vx = vx * frictionFactor;
+        vz = vz * frictionFactor;
+        speed = sqrtf(vx * vx + vz * vz);
+        if (speed > 0.0001f)
+        {
+            float newSpeed = speed - reduction;
+            if (newSpeed < 0.0f) newSpeed = 0.0f;
+            float scale = newSpeed / speed;
+            vx = vx * scale;
+            vz = vz * scale;
+        }
+
+        // Integrate
+        velX[i] = vx;
+        velZ[i] = vz;
+        posX[i] += vx * deltaTime;
+        posZ[i] += vz * deltaTime;
+    }
+}
+
+/**
+ * Balls whose pair with awake ball i is tested: active, not i, and awake
+ * balls only above i (the lower one reports an awake-awake pair)
+ */
+static inline uint32_t CandidateRow(int i, uint32_t activeBits, uint32_t awakeBits)
+{
+    uint32_t below = (1u << i) - 1u;
+    return activeBits & ~(1u << i) & ~(awakeBits & below);
+}
+
+/**
+ * Bits 0 .. count-1 set
+ */
+static inline uint32_t LowBits(int count)
+{
+    return count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1u;
+}
+
+static int CountBits(uint32_t bits)
+{
+    int n = 0;
+    for (; bits != 0; bits &= bits - 1)
+        n++;
+    return n;
+}
+
+static int OverlapsScalar(const float* posX, const float* posZ, const float* radius,
+                          const uint32_t* active, const uint32_t* awake, int count,
+                          const int* awakeBalls, int numAwake, uint32_t* overlaps)
+{
+    uint32_t activeBits = 0;
+    uint32_t awakeBits = 0;
+    for (int j = 0; j < count; j++)
+    {
+        activeBits |= (active[j] & 1u) << j;
+        awakeBits |= (awake[j] & 1u) << j;
+    }
+
+    int tested = 0;
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awakeBalls[k];
+        uint32_t candidates = (activeBits >> i) & 1u ? CandidateRow(i, activeBits, awakeBits) : 0u;
+        tested += CountBits(candidates);
+
+        uint32_t row = 0;
+        for (int j = 0; j < count; j++)
+        {
+            if (!((candidates >> j) & 1u))
+                continue;
+
+            float dx = posX[j] - posX[i];
+            float dz = posZ[j] - posZ[i];
+            float minDist = radius[i] + radius[j];
+            if (dx * dx + dz * dz < minDist * minDist)
+                row |= 1u << j;
+        }
+        overlaps[k] = row;
+    }
+    return tested;
+}
+
+#if KERNELS_X86
+
+// ============================================================================
+// SSE2 KERNELS (4 balls per instruction)
+// ============================================================================
+
+// mask ? a : b
+KERNEL_SSE2 static inline __m128 Select4(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+KERNEL_SSE2 static inline __m128 LoadMask4(const uint32_t* active)
+{
+    return _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)active));
+}
+
+KERNEL_SSE2 static void FrictionSSE2(float* velX, float* velZ, const uint32_t* active,
+                                     int count, float frictionFactor, float reduction)
+{
+    const __m128 factor = _mm_set1_ps(frictionFactor);
+    const __m128 red = _mm_set1_ps(reduction);
+    const __m128 eps = _mm_set1_ps(0.0001f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 act = LoadMask4(active + i);
+        __m128 vx0 = _mm_loadu_ps(velX + i);
+        __m128 vz0 = _mm_loadu_ps(velZ + i);
+
+        __m128 vx = _mm_mul_ps(vx0, factor);
+        __m128 vz = _mm_mul_ps(vz0, factor);
+
+        __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)));
+        __m128 moving = _mm_cmpgt_ps(speed, eps);
+        __m128 newSpeed = _mm_max_ps(_mm_sub_ps(speed, red), zero);
+        __m128 scale = _mm_div_ps(newSpeed, speed);
+
+        vx = Select4(moving, _mm_mul_ps(vx, scale), vx);
+        vz = Select4(moving, _mm_mul_ps(vz, scale), vz);
+
+        _mm_storeu_ps(velX + i, Select4(act, vx, vx0));
+        _mm_storeu_ps(velZ + i, Select4(act, vz, vz0));
+    }
+}
+
+KERNEL_SSE2 static void IntegrateSSE2(float* posX, float* posZ, const float* velX, const float* velZ,
+                                      const uint32_t* active, int count, float deltaTime)
+{
+    const __m128 dt = _mm_set1_ps(deltaTime);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 act = LoadMask4(active + i);
+        __m128 px = _mm_loadu_ps(posX + i);
+        __m128 pz = _mm_loadu_ps(posZ + i);
+
+        __m128 nx = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(velX + i), dt));
+        __m128 nz = _mm_add_ps(pz, _mm_mul_ps(_mm_loadu_ps(velZ + i), dt));
+
+        _mm_storeu_ps(posX + i, Select4(act, nx, px));
+        _mm_storeu_ps(posZ + i, Select4(act, nz, pz));
+    }
+}
+
+KERNEL_SSE2 static void ClampSSE2(float* velX, float* velZ, const uint32_t* active, int count, float maxVelocity)
+{
+    const __m128 maxV = _mm_set1_ps(maxVelocity);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 act = LoadMask4(active + i);
+        __m128 vx = _mm_loadu_ps(velX + i);
+        __m128 vz = _mm_loadu_ps(velZ + i);
+
+        __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)));
+        __m128 over = _mm_and_ps(act, _mm_cmpgt_ps(speed, maxV));
+
+        _mm_storeu_ps(velX + i, Select4(over, _mm_mul_ps(_mm_div_ps(vx, speed), maxV), vx));
+        _mm_storeu_ps(velZ + i, Select4(over, _mm_mul_ps(_mm_div_ps(vz, speed), maxV), vz));
+    }
+}
+
+KERNEL_SSE2 static void StopSSE2(float* velX, float* velZ, const uint32_t* active, int count, float minVelocity)
+{
+    const __m128 minSq = _mm_set1_ps(minVelocity * minVelocity);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 act = LoadMask4(active + i);
+        __m128 vx = _mm_loadu_ps(velX + i);
+        __m128 vz = _mm_loadu_ps(velZ + i);
+
+        __m128 speedSq = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz));
+        __m128 slow = _mm_and_ps(act, _mm_cmplt_ps(speedSq, minSq));
+
+        _mm_storeu_ps(velX + i, _mm_andnot_ps(slow, vx));
+        _mm_storeu_ps(velZ + i, _mm_andnot_ps(slow, vz));
+    }
+}
+
+KERNEL_SSE2 static void FusedSSE2(float* posX, float* posZ, float* velX, float* velZ, const uint32_t* active,
+                                  int count, float maxVelocity, float minVelocity,
+                                  float frictionFactor, float reduction, float deltaTime)
+{
+    const __m128 maxV = _mm_set1_ps(maxVelocity);
+    const __m128 minSq = _mm_set1_ps(minVelocity * minVelocity);
+    const __m128 factor = _mm_set1_ps(frictionFactor);
+    const __m128 red = _mm_set1_ps(reduction);
+    const __m128 eps = _mm_set1_ps(0.0001f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 dt = _mm_set1_ps(deltaTime);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 act = LoadMask4(active + i);
+        __m128 vx0 = _mm_loadu_ps(velX + i);
+        __m128 vz0 = _mm_loadu_ps(velZ + i);
+        __m128 px = _mm_loadu_ps(posX + i);
+        __m128 pz = _mm_loadu_ps(posZ + i);
+
+        // Clamp and rest test
+        __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx0, vx0), _mm_mul_ps(vz0, vz0)));
+        __m128 over = _mm_cmpgt_ps(speed, maxV);
+        __m128 vx = Select4(over, _mm_mul_ps(_mm_div_ps(vx0, speed), maxV), vx0);
+        __m128 vz = Select4(over, _mm_mul_ps(_mm_div_ps(vz0, speed), maxV), vz0);
+        __m128 slow = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)), minSq);
+        vx = _mm_andnot_ps(slow, vx);
+        vz = _mm_andnot_ps(slow, vz);
+
+        // Friction
+        vx = _mm_mul_ps(vx, factor);
+        vz = _mm_mul_ps(vz, factor);
+        speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)));
+        __m128 moving = _mm_cmpgt_ps(speed, eps);
+        __m128 scale = _mm_div_ps(_mm_max_ps(_mm_sub_ps(speed, red), zero), speed);
+        vx = Select4(moving, _mm_mul_ps(vx, scale), vx);
+        vz = Select4(moving, _mm_mul_ps(vz, scale), vz);
+
+        // Integrate
+        _mm_storeu_ps(velX + i, Select4(act, vx, vx0));
+        _mm_storeu_ps(velZ + i, Select4(act, vz, vz0));
+        _mm_storeu_ps(posX + i, Select4(act, _mm_add_ps(px, _mm_mul_ps(vx, dt)), px));
+        _mm_storeu_ps(posZ + i, Select4(act, _mm_add_ps(pz, _mm_mul_ps(vz, dt)), pz));
+    }
+}
+
+KERNEL_SSE2 static int OverlapsSSE2(const float* posX, const float* posZ, const float* radius,
+                                    const uint32_t* active, const uint32_t* awake, int count,
+                                    const int* awakeBalls, int numAwake, uint32_t* overlaps)
+{
+    // Mask arrays to bit sets, 4 balls per instruction
+    uint32_t activeBits = 0;
+    uint32_t awakeBits = 0;
+    for (int j = 0; j < count; j += 4)
+    {
+        activeBits |= (uint32_t)_mm_movemask_ps(LoadMask4(active + j)) << j;
+        awakeBits |= (uint32_t)_mm_movemask_ps(LoadMask4(awake + j)) << j;
+    }
+    activeBits &= LowBits(count);
+    awakeBits &= LowBits(count);
+
+    int tested = 0;
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awakeBalls[k];
+        overlaps[k] = 0;
+        if (!((activeBits >> i) & 1u))
+            continue;
+        uint32_t candidates = CandidateRow(i, activeBits, awakeBits);
+        tested += CountBits(candidates);
+
+        const __m128 xi = _mm_set1_ps(posX[i]);
+        const __m128 zi = _mm_set1_ps(posZ[i]);
+        const __m128 ri = _mm_set1_ps(radius[i]);
+
+        uint32_t row = 0;
+        for (int j = 0; j < count; j += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(posX + j), xi);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(posZ + j), zi);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+            __m128 minDist = _mm_add_ps(ri, _mm_loadu_ps(radius + j));
+            __m128 hit = _mm_cmplt_ps(distSq, _mm_mul_ps(minDist, minDist));
+            row |= (uint32_t)_mm_movemask_ps(hit) << j;
+        }
+        overlaps[k] = row & candidates;
+    }
+    return tested;
+}
+
+// ============================================================================
+// AVX2 KERNELS (8 balls per instruction)
+// ============================================================================
+
+// mask ? a : b
+KERNEL_AVX2 static inline __m256 Select8(__m256 mask, __m256 a, __m256 b)
+{
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+KERNEL_AVX2 static inline __m256 LoadMask8(const uint32_t* active)
+{
+    return _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)active));
+}
+
+KERNEL_AVX2 static void FrictionAVX2(float* velX, float* velZ, const uint32_t* active,
+                                     int count, float frictionFactor, float reduction)
+{
+    const __m256 factor = _mm256_set1_ps(frictionFactor);
+    const __m256 red = _mm256_set1_ps(reduction);
+    const __m256 eps = _mm256_set1_ps(0.0001f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 act = LoadMask8(active + i);
+        __m256 vx0 = _mm256_loadu_ps(velX + i);
+        __m256 vz0 = _mm256_loadu_ps(velZ + i);
+
+        __m256 vx = _mm256_mul_ps(vx0, factor);
+        __m256 vz = _mm256_mul_ps(vz0, factor);
+
+        __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vz, vz)));
+        __m256 moving = _mm256_cmp_ps(speed, eps, _CMP_GT_OQ);
+        __m256 newSpeed = _mm256_max_ps(_mm256_sub_ps(speed, red), zero);
+        __m256 scale = _mm256_div_ps(newSpeed, speed);
+
+        vx = Select8(moving, _mm256_mul_ps(vx, scale), vx);
+        vz = Select8(moving, _mm256_mul_ps(vz, scale), vz);
+
+        _mm256_storeu_ps(velX + i, Select8(act, vx, vx0));
+        _mm256_storeu_ps(velZ + i, Select8(act, vz, vz0));
+    }
+}
+
+KERNEL_AVX2 static void IntegrateAVX2(float* posX, float* posZ, const float* velX, const float* velZ,
+                                      const uint32_t* active, int count, float deltaTime)
+{
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 act = LoadMask8(active + i);
+        __m256 px = _mm256_loadu_ps(posX + i);
+        __m256 pz = _mm256_loadu_ps(posZ + i);
+
+        __m256 nx = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(velX + i), dt));
+        __m256 nz = _mm256_add_ps(pz, _mm256_mul_ps(_mm256_loadu_ps(velZ + i), dt));
+
+        _mm256_storeu_ps(posX + i, Select8(act, nx, px));
+        _mm256_storeu_ps(posZ + i, Select8(act, nz, pz));
+    }
+}
+
+KERNEL_AVX2 static void ClampAVX2(float* velX, float* velZ, const uint32_t* active, int count, float maxVelocity)
+{
+    const __m256 maxV = _mm256_set1_ps(maxVelocity);
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 act = LoadMask8(active + i);
+        __m256 vx = _mm256_loadu_ps(velX + i);
+        __m256 vz = _mm256_loadu_ps(velZ + i);
+
+        __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vz, vz)));
+        __m256 over = _mm256_and_ps(act, _mm256_cmp_ps(speed, maxV, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(velX + i, Select8(over, _mm256_mul_ps(_mm256_div_ps(vx, speed), maxV), vx));
+        _mm256_storeu_ps(velZ + i, Select8(over, _mm256_mul_ps(_mm256_div_ps(vz, speed), maxV), vz));
+    }
+}
+
+KERNEL_AVX2 static void StopAVX2(float* velX, float* velZ, const uint32_t* active, int count, float minVelocity)
+{
+    const __m256 minSq = _mm256_set1_ps(minVelocity * minVelocity);
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 act = LoadMask8(active + i);
+        __m256 vx = _mm256_loadu_ps(velX + i);
+        __m256 vz = _mm256_loadu_ps(velZ + i);
+
+        __m256 speedSq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vz, vz));
+        __m256 slow = _mm256_and_ps(act, _mm256_cmp_ps(speedSq, minSq, _CMP_LT_OQ));
+
+        _mm256_storeu_ps(velX + i, _mm256_andnot_ps(slow, vx));
+        _mm256_storeu_ps(velZ + i, _mm256_andnot_ps(slow, vz));
+    }
+}
+
+KERNEL_AVX2 static void FusedAVX2(float* posX, float* posZ, float* velX, float* velZ, const uint32_t* active,
+                                  int count, float maxVelocity, float minVelocity,
+                                  float frictionFactor, float reduction, float deltaTime)
+{
+    const __m256 maxV = _mm256_set1_ps(maxVelocity);
+    const __m256 minSq = _mm256_set1_ps(minVelocity * minVelocity);
+    const __m256 factor = _mm256_set1_ps(frictionFactor);
+    const __m256 red = _mm256_set1_ps(reduction);
+    const __m256 eps = _mm256_set1_ps(0.0001f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 act = LoadMask8(active + i);
+        __m256 vx0 = _mm256_loadu_ps(velX + i);
+        __m256 vz0 = _mm256_loadu_ps(velZ + i);
+        __m256 px = _mm256_loadu_ps(posX + i);
+        __m256 pz = _mm256_loadu_ps(posZ + i);
+
+        // Clamp and rest test
+        __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx0, vx0), _mm256_mul_ps(vz0, vz0)));
+        __m256 over = _mm256_cmp_ps(speed, maxV, _CMP_GT_OQ);
+        __m256 vx = Select8(over, _mm256_mul_ps(_mm256_div_ps(vx0, speed), maxV), vx0);
+        __m256 vz = Select8(over, _mm256_mul_ps(_mm256_div_ps(vz0, speed), maxV), vz0);
+        __m256 slow = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vz, vz)), minSq, _CMP_LT_OQ);
+        vx = _mm256_andnot_ps(slow, vx);
+        vz = _mm256_andnot_ps(slow, vz);
+
+        // Friction
+        vx = _mm256_mul_ps(vx, factor);
+        vz = _mm256_mul_ps(vz, factor);
+        speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vz, vz)));
+        __m256 moving = _mm256_cmp_ps(speed, eps, _CMP_GT_OQ);
+        __m256 scale = _mm256_div_ps(_mm256_max_ps(_mm256_sub_ps(speed, red), zero), speed);
+        vx = Select8(moving, _mm256_mul_ps(vx, scale), vx);
+        vz = Select8(moving, _mm256_mul_ps(vz, scale), vz);
+
+        // Integrate
+        _mm256_storeu_ps(velX + i, Select8(act, vx, vx0));
+        _mm256_storeu_ps(velZ + i, Select8(act, vz, vz0));
+        _mm256_storeu_ps(posX + i, Select8(act, _mm256_add_ps(px, _mm256_mul_ps(vx, dt)), px));
+        _mm256_storeu_ps(posZ + i, Select8(act, _mm256_add_ps(pz, _mm256_mul_ps(vz, dt)), pz));
+    }
+}
+
+KERNEL_AVX2 static int OverlapsAVX2(const float* posX, const float* posZ, const float* radius,
+                                    const uint32_t* active, const uint32_t* awake, int count,
+                                    const int* awakeBalls, int numAwake, uint32_t* overlaps)
+{
+    // Mask arrays to bit sets, 8 balls per instruction
+    uint32_t activeBits = 0;
+    uint32_t awakeBits = 0;
+    for (int j = 0; j < count; j += 8)
+    {
+        activeBits |= (uint32_t)_mm256_movemask_ps(LoadMask8(active + j)) << j;
+        awakeBits |= (uint32_t)_mm256_movemask_ps(LoadMask8(awake + j)) << j;
+    }
+    activeBits &= LowBits(count);
+    awakeBits &= LowBits(count);
+
+    int tested = 0;
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awakeBalls[k];
+        overlaps[k] = 0;
+        if (!((activeBits >> i) & 1u))
+            continue;
+        uint32_t candidates = CandidateRow(i, activeBits, awakeBits);
+        tested += CountBits(candidates);
+
+        const __m256 xi = _mm256_set1_ps(posX[i]);
+        const __m256 zi = _mm256_set1_ps(posZ[i]);
+        const __m256 ri = _mm256_set1_ps(radius[i]);
+
+        uint32_t row = 0;
+        for (int j = 0; j < count; j += 8)
+        {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(posX + j), xi);
+            __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(posZ + j), zi);
+            __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz));
+            __m256 minDist = _mm256_add_ps(ri, _mm256_loadu_ps(radius + j));
+            __m256 hit = _mm256_cmp_ps(distSq, _mm256_mul_ps(minDist, minDist), _CMP_LT_OQ);
+            row |= (uint32_t)_mm256_movemask_ps(hit) << j;
+        }
+        overlaps[k] = row & candidates;
+    }
+    return tested;
+}
+
+#endif // KERNELS_X86
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+void ApplyFriction(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                   int count, float frictionFactor, float reduction)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return FrictionAVX2(velX, velZ, active, count, frictionFactor, reduction);
+    if (set == InstructionSet::SSE2)
+        return FrictionSSE2(velX, velZ, active, count, frictionFactor, reduction);
+#endif
+    FrictionScalar(velX, velZ, active, count, frictionFactor, reduction);
+}
+
+void IntegratePositions(InstructionSet set, float* posX, float* posZ,
+                        const float* velX, const float* velZ, const uint32_t* active,
+                        int count, float deltaTime)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return IntegrateAVX2(posX, posZ, velX, velZ, active, count, deltaTime);
+    if (set == InstructionSet::SSE2)
+        return IntegrateSSE2(posX, posZ, velX, velZ, active, count, deltaTime);
+#endif
+    IntegrateScalar(posX, posZ, velX, velZ, active, count, deltaTime);
+}
+
+void ClampVelocities(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                     int count, float maxVelocity)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return ClampAVX2(velX, velZ, active, count, maxVelocity);
+    if (set == InstructionSet::SSE2)
+        return ClampSSE2(velX, velZ, active, count, maxVelocity);
+#endif
+    ClampScalar(velX, velZ, active, count, maxVelocity);
+}
+
+void StopSlowBalls(InstructionSet set, float* velX, float* velZ, const uint32_t* active,
+                   int count, float minVelocity)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return StopAVX2(velX, velZ, active, count, minVelocity);
+    if (set == InstructionSet::SSE2)
+        return StopSSE2(velX, velZ, active, count, minVelocity);
+#endif
+    StopScalar(velX, velZ, active, count, minVelocity);
+}
+
+void FusedStep(InstructionSet set, float* posX, float* posZ, float* velX, float* velZ,
+               const uint32_t* active, int count, float maxVelocity, float minVelocity,
+               float frictionFactor, float reduction, float deltaTime)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return FusedAVX2(posX, posZ, velX, velZ, active, count, maxVelocity, minVelocity,
+                         frictionFactor, reduction, deltaTime);
+    if (set == InstructionSet::SSE2)
+        return FusedSSE2(posX, posZ, velX, velZ, active, count, maxVelocity, minVelocity,
+                         frictionFactor, reduction, deltaTime);
+#endif
+    FusedScalar(posX, posZ, velX, velZ, active, count, maxVelocity, minVelocity,
+                frictionFactor, reduction, deltaTime);
+}
+
+int FindOverlaps(InstructionSet set, const float* posX, const float* posZ, const float* radius,
+                 const uint32_t* active, const uint32_t* awake, int count,
+                 const int* awakeBalls, int numAwake, uint32_t* overlaps)
+{
+#if KERNELS_X86
+    if (set == InstructionSet::AVX2)
+        return OverlapsAVX2(posX, posZ, radius, active, awake, count, awakeBalls, numAwake, overlaps);
+    if (set == InstructionSet::SSE2)
+        return OverlapsSSE2(posX, posZ, radius, active, awake, count, awakeBalls, numAwake, overlaps);
+#endif
+    return OverlapsScalar(posX, posZ, radius, active, awake, count, awakeBalls, numAwake, overlaps);
+}
+
+} // namespace PhysicsKernels
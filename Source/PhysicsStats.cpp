@@ -0,0 +1,54 @@
+#include "../Header/PhysicsStats.h"
+#include <ostream>
+
+static const char* const PHASE_NAMES[PhysicsStats::PHASE_COUNT] = {
+    "integrate", "swept", "ball_collisions", "cushions", "pockets", "finish"
+};
+
+double PhysicsStats::GetPhaseAverage(PhysicsPhase phase) const
+{
+    return TimedSteps > 0 ? PhaseSeconds[(int)phase] / TimedSteps : 0.0;
+}
+
+const char* PhysicsStats::GetPhaseName(PhysicsPhase phase)
+{
+    int p = (int)phase;
+    return p >= 0 && p < PHASE_COUNT ? PHASE_NAMES[p] : "unknown";
+}
+
+void PhysicsStats::WriteCsvHeader(std::ostream& out)
+{
+    out << "steps,pairs_tested,overlaps,impulses,cushion_hits,pocket_events,iterations,capped_steps,max_penetration,skipped_steps,timed_steps";
+    for (int p = 0; p < PHASE_COUNT; p++)
+        out << ',' << PHASE_NAMES[p] << "_seconds";
+    out << '\n';
+}
+
+void PhysicsStats::WriteCsvRow(std::ostream& out) const
+{
+    out << Steps << ',' << PairsTested << ',' << Overlaps << ',' << Impulses << ','
+        << CushionHits << ',' << PocketEvents << ',' << Iterations << ',' << CappedSteps << ','
+        << MaxPenetration << ',' << SkippedSteps << ',' << TimedSteps;
+    for (int p = 0; p < PHASE_COUNT; p++)
+        out << ',' << PhaseSeconds[p];
+    out << '\n';
+}
+
+void PhysicsStats::WriteJson(std::ostream& out) const
+{
+    out << "{\"steps\":" << Steps
+        << ",\"pairs_tested\":" << PairsTested
+        << ",\"overlaps\":" << Overlaps
+        << ",\"impulses\":" << Impulses
+        << ",\"cushion_hits\":" << CushionHits
+        << ",\"pocket_events\":" << PocketEvents
+        << ",\"iterations\":" << Iterations
+        << ",\"capped_steps\":" << CappedSteps
+        << ",\"max_penetration\":" << MaxPenetration
+        << ",\"skipped_steps\":" << SkippedSteps
+        << ",\"timed_steps\":" << TimedSteps
+        << ",\"phase_seconds\":{";
+    for (int p = 0; p < PHASE_COUNT; p++)
+        out << (p > 0 ? "," : "") << '"' << PHASE_NAMES[p] << "\":" << PhaseSeconds[p];
+    out << "}}";
+}
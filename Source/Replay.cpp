@@ -0,0 +1,446 @@
+#include "../Header/Replay.h"
+#include <cmath>
+#include <cstring>
+
+// Sanity limit on the ball count read from a file header
+static const uint32_t MAX_REPLAY_BALLS = 4096;
+
+static const char REPLAY_MAGIC[4] = { 'B', 'R', 'P', 'L' };
+
+// ---------------------------------------------------------------------------
+// Encoding helpers (explicit little-endian so files are portable)
+// ---------------------------------------------------------------------------
+
+static void PutU32(unsigned char* out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutU64(unsigned char* out, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+        out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutF32(unsigned char* out, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutU32(out, bits);
+}
+
+static uint32_t GetU32(const unsigned char* in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= (uint32_t)in[i] << (8 * i);
+    return value;
+}
+
+static uint64_t GetU64(const unsigned char* in)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++)
+        value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+static float GetF32(const unsigned char* in)
+{
+    uint32_t bits = GetU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Map signed values to unsigned so small magnitudes of either sign stay small
+ */
+static uint32_t ZigZag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t UnZigZag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/**
+ * Append a value 7 bits per byte, low bits first, high bit set on all but the last byte
+ */
+static void PutVarint(std::vector<unsigned char>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+/**
+ * Read a varint, advancing pos
+ * @return false if the data ends mid-value or the value is too long
+ */
+static bool GetVarint(const unsigned char* data, uint64_t end, uint64_t& pos, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= end)
+            return false;
+        unsigned char byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static int32_t Quantize(float position)
+{
+    return (int32_t)std::lrintf(position * ReplayFormat::POSITION_SCALE);
+}
+
+// ---------------------------------------------------------------------------
+// ReplayRecorder
+// ---------------------------------------------------------------------------
+
+ReplayRecorder::ReplayRecorder()
+    : BallCount(0)
+    , KeyframeInterval(ReplayFormat::DEFAULT_KEYFRAME_INTERVAL)
+    , StepTime(0.0f)
+    , FrameCount(0)
+    , Offset(0)
+{
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    Close();
+}
+
+bool ReplayRecorder::Open(const char* path, const BallStore& balls, float stepTime, int keyframeInterval)
+{
+    Close();
+
+    File.open(path, std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+        return false;
+
+    BallCount = balls.Size();
+    KeyframeInterval = keyframeInterval > 1 ? keyframeInterval : 1;
+    StepTime = stepTime;
+    FrameCount = 0;
+    KeyframeOffsets.clear();
+
+    LastX.assign(BallCount, 0);
+    LastZ.assign(BallCount, 0);
+    LastActive.assign(BallCount, 0);
+
+    // Placeholder header (counts and index offset are filled in by Close)
+    WriteHeader();
+
+    FrameBytes.assign((size_t)BallCount * ReplayFormat::BALL_ENTRY_BYTES, 0);
+    for (int i = 0; i < BallCount; i++)
+    {
+        unsigned char* entry = &FrameBytes[(size_t)i * ReplayFormat::BALL_ENTRY_BYTES];
+        PutU32(entry, (uint32_t)balls.Number[i]);
+        PutF32(entry + 4, balls.Radius[i]);
+    }
+    File.write((const char*)FrameBytes.data(), (std::streamsize)FrameBytes.size());
+
+    Offset = ReplayFormat::HEADER_BYTES + FrameBytes.size();
+    return File.good();
+}
+
+void ReplayRecorder::WriteHeader()
+{
+    unsigned char header[ReplayFormat::HEADER_BYTES];
+    std::memcpy(header, REPLAY_MAGIC, 4);
+    PutU32(header + 4, ReplayFormat::VERSION);
+    PutU32(header + 8, (uint32_t)BallCount);
+    PutU32(header + 12, (uint32_t)KeyframeInterval);
+    PutF32(header + 16, StepTime);
+    PutF32(header + 20, ReplayFormat::POSITION_SCALE);
+    PutU32(header + 24, (uint32_t)FrameCount);
+    PutU32(header + 28, (uint32_t)KeyframeOffsets.size());
+    PutU64(header + 32, Offset);
+    File.write((const char*)header, sizeof(header));
+}
+
+void ReplayRecorder::RecordFrame(const BallStore& balls)
+{
+    if (!File.is_open())
+        return;
+
+    int count = balls.Size() < BallCount ? balls.Size() : BallCount;
+    size_t maskBytes = ((size_t)BallCount + 7) / 8;
+    FrameBytes.clear();
+
+    if (FrameCount % KeyframeInterval == 0)
+    {
+        KeyframeOffsets.push_back(Offset);
+
+        FrameBytes.resize(maskBytes, 0);
+        for (int i = 0; i < BallCount; i++)
+        {
+            if (i < count)
+            {
+                LastX[i] = Quantize(balls.PosX[i]);
+                LastZ[i] = Quantize(balls.PosZ[i]);
+                LastActive[i] = balls.IsActive(i) ? 1 : 0;
+            }
+
+            if (LastActive[i])
+                FrameBytes[i / 8] |= (unsigned char)(1 << (i % 8));
+            PutVarint(FrameBytes, ZigZag(LastX[i]));
+            PutVarint(FrameBytes, ZigZag(LastZ[i]));
+        }
+    }
+    else
+    {
+        FrameBytes.resize(maskBytes, 0);
+        for (int i = 0; i < count; i++)
+        {
+            int32_t x = Quantize(balls.PosX[i]);
+            int32_t z = Quantize(balls.PosZ[i]);
+            uint8_t active = balls.IsActive(i) ? 1 : 0;
+
+            if (x == LastX[i] && z == LastZ[i] && active == LastActive[i])
+                continue;
+
+            FrameBytes[i / 8] |= (unsigned char)(1 << (i % 8));
+            uint64_t toggled = active != LastActive[i] ? 1 : 0;
+            PutVarint(FrameBytes, ((uint64_t)ZigZag(x - LastX[i]) << 1) | toggled);
+            PutVarint(FrameBytes, ZigZag(z - LastZ[i]));
+
+            LastX[i] = x;
+            LastZ[i] = z;
+            LastActive[i] = active;
+        }
+    }
+
+    File.write((const char*)FrameBytes.data(), (std::streamsize)FrameBytes.size());
+    Offset += FrameBytes.size();
+    FrameCount++;
+}
+
+bool ReplayRecorder::Close()
+{
+    if (!File.is_open())
+        return true;
+
+    uint64_t indexOffset = Offset;
+    FrameBytes.assign(KeyframeOffsets.size() * 8, 0);
+    for (size_t k = 0; k < KeyframeOffsets.size(); k++)
+        PutU64(&FrameBytes[k * 8], KeyframeOffsets[k]);
+    File.write((const char*)FrameBytes.data(), (std::streamsize)FrameBytes.size());
+
+    // Rewrite the header now that the counts and index offset are known
+    Offset = indexOffset;
+    File.seekp(0);
+    WriteHeader();
+    Offset += FrameBytes.size();
+
+    bool ok = File.good();
+    File.close();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// ReplayReader
+// ---------------------------------------------------------------------------
+
+ReplayReader::ReplayReader()
+    : BallCount(0)
+    , KeyframeInterval(1)
+    , StepTime(0.0f)
+    , PositionScale(ReplayFormat::POSITION_SCALE)
+    , FrameCount(0)
+    , KeyframeCount(0)
+    , BallTable(nullptr)
+    , Index(nullptr)
+    , CurrentFrame(-1)
+    , Cursor(0)
+{
+}
+
+bool ReplayReader::Open(const char* path)
+{
+    Close();
+
+    if (!File.Open(path))
+        return false;
+
+    const unsigned char* data = File.GetData();
+    uint64_t size = File.GetSize();
+
+    bool valid = size >= (uint64_t)ReplayFormat::HEADER_BYTES
+              && std::memcmp(data, REPLAY_MAGIC, 4) == 0
+              && GetU32(data + 4) == ReplayFormat::VERSION;
+
+    if (valid)
+    {
+        uint32_t ballCount = GetU32(data + 8);
+        uint32_t interval = GetU32(data + 12);
+        uint32_t frames = GetU32(data + 24);
+        uint32_t keyframes = GetU32(data + 28);
+        uint64_t indexOffset = GetU64(data + 32);
+        uint64_t framesStart = ReplayFormat::HEADER_BYTES + (uint64_t)ballCount * ReplayFormat::BALL_ENTRY_BYTES;
+
+        valid = ballCount <= MAX_REPLAY_BALLS
+             && interval > 0
+             && frames <= 0x7FFFFFFFu
+             && keyframes == (frames + interval - 1) / interval
+             && indexOffset >= framesStart
+             && indexOffset <= size
+             && (size - indexOffset) / 8 >= keyframes;
+
+        if (valid)
+        {
+            BallCount = (int)ballCount;
+            KeyframeInterval = (int)interval;
+            StepTime = GetF32(data + 16);
+            PositionScale = GetF32(data + 20);
+            FrameCount = (int)frames;
+            KeyframeCount = (int)keyframes;
+            BallTable = data + ReplayFormat::HEADER_BYTES;
+            Index = data + indexOffset;
+        }
+    }
+
+    if (!valid)
+    {
+        Close();
+        return false;
+    }
+
+    X.assign(BallCount, 0);
+    Z.assign(BallCount, 0);
+    ActiveFlags.assign(BallCount, 0);
+    CurrentFrame = -1;
+    return true;
+}
+
+void ReplayReader::Close()
+{
+    File.Close();
+    BallCount = 0;
+    FrameCount = 0;
+    KeyframeCount = 0;
+    BallTable = nullptr;
+    Index = nullptr;
+    CurrentFrame = -1;
+    Cursor = 0;
+}
+
+int ReplayReader::FrameAtTime(double time) const
+{
+    if (FrameCount == 0 || StepTime <= 0.0f)
+        return 0;
+
+    double frame = std::floor(time / StepTime);
+    if (frame < 0.0)
+        return 0;
+    if (frame >= FrameCount)
+        return FrameCount - 1;
+    return (int)frame;
+}
+
+bool ReplayReader::DecodeFrame(bool keyframe)
+{
+    const unsigned char* data = File.GetData();
+    uint64_t end = Index - data;
+    uint64_t maskBytes = ((uint64_t)BallCount + 7) / 8;
+
+    if (Cursor + maskBytes > end)
+        return false;
+    const unsigned char* mask = data + Cursor;
+    uint64_t pos = Cursor + maskBytes;
+
+    for (int i = 0; i < BallCount; i++)
+    {
+        bool flagged = (mask[i / 8] >> (i % 8)) & 1;
+        if (!keyframe && !flagged)
+            continue;
+
+        uint64_t xValue, zValue;
+        if (!GetVarint(data, end, pos, xValue) || !GetVarint(data, end, pos, zValue))
+            return false;
+
+        if (keyframe)
+        {
+            X[i] = UnZigZag((uint32_t)xValue);
+            Z[i] = UnZigZag((uint32_t)zValue);
+            ActiveFlags[i] = flagged ? 1 : 0;
+        }
+        else
+        {
+            X[i] += UnZigZag((uint32_t)(xValue >> 1));
+            Z[i] += UnZigZag((uint32_t)zValue);
+            if (xValue & 1)
+                ActiveFlags[i] ^= 1;
+        }
+    }
+
+    Cursor = pos;
+    return true;
+}
+
+bool ReplayReader::ReadFrame(int frame, BallStore& balls)
+{
+    if (!IsOpen() || frame < 0 || frame >= FrameCount)
+        return false;
+
+    // Decode forward from the current frame if it is in the same keyframe span,
+    // otherwise jump to the keyframe through the index
+    int keyframe = frame / KeyframeInterval;
+    if (CurrentFrame < 0 || frame < CurrentFrame || CurrentFrame / KeyframeInterval != keyframe)
+    {
+        Cursor = GetU64(Index + (size_t)keyframe * 8);
+        if (Cursor >= (uint64_t)(Index - File.GetData()) || !DecodeFrame(true))
+        {
+            CurrentFrame = -1;
+            return false;
+        }
+        CurrentFrame = keyframe * KeyframeInterval;
+    }
+
+    while (CurrentFrame < frame)
+    {
+        if (!DecodeFrame(false))
+        {
+            CurrentFrame = -1;
+            return false;
+        }
+        CurrentFrame++;
+    }
+
+    // Refill the store if it does not hold the recorded balls
+    bool matches = balls.Size() == BallCount;
+    for (int i = 0; matches && i < BallCount; i++)
+        matches = balls.Number[i] == (int)GetU32(BallTable + (size_t)i * ReplayFormat::BALL_ENTRY_BYTES);
+
+    if (!matches)
+    {
+        balls.Clear();
+        for (int i = 0; i < BallCount; i++)
+        {
+            const unsigned char* entry = BallTable + (size_t)i * ReplayFormat::BALL_ENTRY_BYTES;
+            balls.Add((int)GetU32(entry), Vec3(0.0f, 0.0f, 0.0f), GetF32(entry + 4));
+        }
+    }
+
+    float invScale = 1.0f / PositionScale;
+    for (int i = 0; i < BallCount; i++)
+    {
+        balls.PosX[i] = X[i] * invScale;
+        balls.PosZ[i] = Z[i] * invScale;
+        balls.SetActive(i, ActiveFlags[i] != 0);
+        balls.Stop(i);
+    }
+    return true;
+}
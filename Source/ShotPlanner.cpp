@@ -0,0 +1,247 @@
+#include "../Header/ShotPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+// Default sampling range: about +/-3 degrees and +/-25% power
+static const float DEFAULT_ANGLE_SPREAD = 0.05f;
+static const float DEFAULT_POWER_SPREAD = 0.25f;
+
+// Safety limit on the steps of a rollout (30 simulated seconds at 240 Hz)
+static const int MAX_ROLLOUT_STEPS = 240 * 30;
+
+// Outcome scoring weights
+static const float SCORE_POT = 1.0f;        // Per object ball potted
+static const float SCORE_SCRATCH = -2.0f;   // Cue ball potted
+static const float SCORE_NO_CONTACT = -1.0f; // Cue ball hit no other ball
+static const float SCORE_LEAVE = 0.5f;      // Cue ball resting next to an object ball
+static const float LEAVE_RANGE = 2.0f;      // Distance at which the leave bonus reaches zero
+
+/**
+ * Best outcome found by one worker
+ */
+struct WorkerBest
+{
+    PlannedShot Shot;
+    int Rollouts;
+    bool Found;
+};
+
+ShotPlanner::ShotPlanner(int threadCount)
+    : Seed(12345u)
+    , AngleSpread(DEFAULT_ANGLE_SPREAD)
+    , PowerSpread(DEFAULT_POWER_SPREAD)
+    , RolloutLimit(0)
+    , TimeStep(1.0f / 240.0f)
+    , ThreadCount(0)
+    , LastRollouts(0)
+    , LastThreadsUsed(0)
+    , LastRolloutsPerSecond(0.0)
+{
+    SetThreadCount(threadCount);
+}
+
+PlannedShot ShotPlanner::Plan(const TableGeometry& table, const BallStore& balls, int cueBall,
+                              const Vec3& direction, float power, float budgetSeconds)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(budgetSeconds));
+
+    int threadCount = ThreadCount;
+    if (RolloutLimit > 0)
+        threadCount = std::min(threadCount, RolloutLimit);
+
+    Vec3 baseDir = Vec3(direction.x, 0.0f, direction.z).Normalized();
+    float baseAngle = atan2f(baseDir.x, baseDir.z);
+
+    std::vector<WorkerBest> best(threadCount);
+
+    auto worker = [&](int index)
+    {
+        // Reproducible per-worker stream: same (seed, index) always samples the same shots
+        std::seed_seq seq = { Seed, (uint32_t)index };
+        std::mt19937 rng(seq);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        BallStore world;
+        Physics physics;
+        std::vector<PhysicsEvent> events;
+
+        // Only the end state is scored, so the slow roll-out tail is skipped
+        physics.SetFastForward(true);
+
+        // With a rollout cap each worker gets a fixed share, so the samples do not depend on timing
+        int quota = 0;
+        if (RolloutLimit > 0)
+            quota = RolloutLimit / threadCount + (index < RolloutLimit % threadCount ? 1 : 0);
+
+        WorkerBest& mine = best[index];
+        mine.Rollouts = 0;
+        mine.Found = false;
+
+        for (;;)
+        {
+            // Always finish at least one rollout, then stop at the budget or the cap
+            if (mine.Rollouts > 0 && Clock::now() >= deadline)
+                break;
+            if (RolloutLimit > 0 && mine.Rollouts >= quota)
+                break;
+
+            float angle = baseAngle;
+            float shotPower = power;
+            if (index != 0 || mine.Rollouts != 0)
+            {
+                angle += unit(rng) * AngleSpread;
+                shotPower *= 1.0f + unit(rng) * PowerSpread;
+            }
+            Vec3 shotDir(sinf(angle), 0.0f, cosf(angle));
+
+            world = balls;
+            events.clear();
+            physics.SetEventLog(&events);
+            physics.ApplyImpulse(world, cueBall, shotDir, shotPower);
+            physics.RunToRest(world, table, TimeStep, MAX_ROLLOUT_STEPS);
+            physics.SetEventLog(nullptr);
+
+            float score = ScoreOutcome(world, events, cueBall);
+            mine.Rollouts++;
+
+            if (!mine.Found || score > mine.Shot.Score)
+            {
+                mine.Found = true;
+                mine.Shot.Direction = shotDir;
+                mine.Shot.Power = shotPower;
+                mine.Shot.Score = score;
+                mine.Shot.Potted = 0;
+                mine.Shot.Scratch = false;
+                for (const PhysicsEvent& e : events)
+                {
+                    if (e.Type == PhysicsEventType::Pot)
+                        mine.Shot.Potted++;
+                    else if (e.Type == PhysicsEventType::Scratch)
+                        mine.Shot.Scratch = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; i++)
+        threads.emplace_back(worker, i);
+    worker(0);
+    for (std::thread& t : threads)
+        t.join();
+
+    // Reduce in worker order so ties resolve the same way every run
+    PlannedShot result = { baseDir, power, 0.0f, 0, false };
+    bool found = false;
+    LastRollouts = 0;
+    for (const WorkerBest& b : best)
+    {
+        LastRollouts += b.Rollouts;
+        if (b.Found && (!found || b.Shot.Score > result.Score))
+        {
+            result = b.Shot;
+            found = true;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    LastThreadsUsed = threadCount;
+    LastRolloutsPerSecond = elapsed.count() > 0.0 ? LastRollouts / elapsed.count() : 0.0;
+    return result;
+}
+
+float ShotPlanner::ScoreOutcome(const BallStore& balls, const std::vector<PhysicsEvent>& events, int cueBall)
+{
+    float score = 0.0f;
+    bool contact = false;
+    bool scratch = false;
+
+    for (const PhysicsEvent& e : events)
+    {
+        if (e.Type == PhysicsEventType::Pot)
+            score += SCORE_POT;
+        else if (e.Type == PhysicsEventType::Scratch && e.Ball == cueBall)
+            scratch = true;
+        else if (e.Type == PhysicsEventType::BallContact && (e.Ball == cueBall || e.Other == cueBall))
+            contact = true;
+    }
+
+    if (scratch)
+        return score + SCORE_SCRATCH;
+    if (!contact)
+        score += SCORE_NO_CONTACT;
+
+    // Leave: reward ending close to the nearest object ball still on the table
+    float nearest = LEAVE_RANGE;
+    for (int i = 0; i < balls.Size(); i++)
+    {
+        if (i == cueBall || !balls.IsActive(i))
+            continue;
+        float dx = balls.PosX[i] - balls.PosX[cueBall];
+        float dz = balls.PosZ[i] - balls.PosZ[cueBall];
+        nearest = std::min(nearest, sqrtf(dx * dx + dz * dz));
+    }
+    score += SCORE_LEAVE * (1.0f - nearest / LEAVE_RANGE);
+
+    return score;
+}
+
+void ShotPlanner::SetSeed(uint32_t seed)
+{
+    Seed = seed;
+}
+
+uint32_t ShotPlanner::GetSeed() const
+{
+    return Seed;
+}
+
+void ShotPlanner::SetSpread(float angle, float power)
+{
+    AngleSpread = angle;
+    PowerSpread = power;
+}
+
+void ShotPlanner::SetRolloutLimit(int rollouts)
+{
+    RolloutLimit = rollouts > 0 ? rollouts : 0;
+}
+
+void ShotPlanner::SetTimeStep(float deltaTime)
+{
+    TimeStep = deltaTime;
+}
+
+void ShotPlanner::SetThreadCount(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    ThreadCount = threadCount > 0 ? threadCount : 1;
+}
+
+int ShotPlanner::GetThreadCount() const
+{
+    return ThreadCount;
+}
+
+int ShotPlanner::GetRolloutCount() const
+{
+    return LastRollouts;
+}
+
+double ShotPlanner::GetRolloutsPerSecond() const
+{
+    return LastRolloutsPerSecond;
+}
+
+double ShotPlanner::GetRolloutsPerSecondPerCore() const
+{
+    return LastThreadsUsed > 0 ? LastRolloutsPerSecond / LastThreadsUsed : 0.0;
+}
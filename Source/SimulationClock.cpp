@@ -0,0 +1,125 @@
+#include "../Header/SimulationClock.h"
+
+// Accepted physics rates in steps per second: at least one step a second,
+// and steps long enough that 1 / rate stays a usable float
+static const float MIN_TICK_RATE = 1.0f;
+static const float MAX_TICK_RATE = 1000000.0f;
+
+/**
+ * Clamp a tick rate into [MIN_TICK_RATE, MAX_TICK_RATE] (NaN becomes the minimum)
+ */
+static float ClampTickRate(float tickRate)
+{
+    if (!(tickRate >= MIN_TICK_RATE))
+        return MIN_TICK_RATE;
+    return tickRate < MAX_TICK_RATE ? tickRate : MAX_TICK_RATE;
+}
+
+/**
+ * At least one step per frame, or the clock would never step
+ */
+static int ClampMaxSteps(int maxSteps)
+{
+    return maxSteps > 1 ? maxSteps : 1;
+}
+
+SimulationClock::SimulationClock(float tickRate, int maxStepsPerFrame)
+    : TickRate(ClampTickRate(tickRate))
+    , StepTime(1.0f / TickRate)
+    , MaxStepsPerFrame(ClampMaxSteps(maxStepsPerFrame))
+    , Accumulator(0.0)
+    , FallingBehind(false)
+    , DroppedTime(0.0)
+    , OverrunFrames(0)
+    , StepCount(0)
+{
+}
+
+void SimulationClock::SetTickRate(float tickRate)
+{
+    TickRate = ClampTickRate(tickRate);
+    StepTime = 1.0f / TickRate;
+    Accumulator = 0.0;
+}
+
+float SimulationClock::GetTickRate() const
+{
+    return TickRate;
+}
+
+float SimulationClock::GetStepTime() const
+{
+    return StepTime;
+}
+
+void SimulationClock::SetMaxStepsPerFrame(int maxSteps)
+{
+    MaxStepsPerFrame = ClampMaxSteps(maxSteps);
+}
+
+int SimulationClock::GetMaxStepsPerFrame() const
+{
+    return MaxStepsPerFrame;
+}
+
+int SimulationClock::Advance(float frameTime)
+{
+    if (frameTime > 0.0f)
+        Accumulator += frameTime;
+
+    // Accumulate in double so the remainder does not drift over long sessions
+    int steps = (int)(Accumulator / StepTime);
+
+    FallingBehind = steps > MaxStepsPerFrame;
+    if (FallingBehind)
+    {
+        // Drop the time we cannot catch up on, keeping the partial step
+        double excess = (steps - MaxStepsPerFrame) * (double)StepTime;
+        Accumulator -= excess;
+        DroppedTime += excess;
+        OverrunFrames++;
+        steps = MaxStepsPerFrame;
+    }
+
+    Accumulator -= steps * (double)StepTime;
+    if (Accumulator < 0.0)
+        Accumulator = 0.0;
+
+    StepCount += steps;
+    return steps;
+}
+
+float SimulationClock::GetInterpolationAlpha() const
+{
+    float alpha = (float)(Accumulator / StepTime);
+    return alpha < 1.0f ? alpha : 0.9999f;
+}
+
+bool SimulationClock::IsFallingBehind() const
+{
+    return FallingBehind;
+}
+
+double SimulationClock::GetDroppedTime() const
+{
+    return DroppedTime;
+}
+
+int SimulationClock::GetOverrunFrameCount() const
+{
+    return OverrunFrames;
+}
+
+long long SimulationClock::GetStepCount() const
+{
+    return StepCount;
+}
+
+void SimulationClock::Reset()
+{
+    Accumulator = 0.0;
+    FallingBehind = false;
+    DroppedTime = 0.0;
+    OverrunFrames = 0;
+    StepCount = 0;
+}
@@ -0,0 +1,141 @@
+#include "../Header/SpatialGrid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid()
+    : OriginX(0.0f)
+    , OriginZ(0.0f)
+    , InvCellSize(1.0f)
+    , Columns(1)
+    , Rows(1)
+{
+}
+
+void SpatialGrid::Build(const BallStore& balls, const TableGeometry& table)
+{
+    int numBalls = balls.Size();
+
+    // Cell size is one diameter of the largest ball
+    float maxRadius = 0.0f;
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (balls.IsActive(i) && balls.Radius[i] > maxRadius)
+            maxRadius = balls.Radius[i];
+    }
+    float cellSize = maxRadius * 2.0f;
+    if (cellSize < 0.001f)
+        cellSize = 0.001f;
+
+    // Cover the play area plus the cushion band, where pocket mouths are
+    float margin = table.CushionWidth + maxRadius;
+    OriginX = table.GetMinX() - margin;
+    OriginZ = table.GetMinZ() - margin;
+    float extentX = (table.GetMaxX() + margin) - OriginX;
+    float extentZ = (table.GetMaxZ() + margin) - OriginZ;
+
+    InvCellSize = 1.0f / cellSize;
+    Columns = (int)(extentX * InvCellSize) + 1;
+    Rows = (int)(extentZ * InvCellSize) + 1;
+
+    int numCells = Columns * Rows;
+    CellStart.assign(numCells + 1, 0);
+    BallCell.resize(numBalls);
+    CellBalls.resize(numBalls);
+
+    // Count balls per cell
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (!balls.IsActive(i))
+        {
+            BallCell[i] = -1;
+            continue;
+        }
+
+        int cell = CellZ(balls.PosZ[i]) * Columns + CellX(balls.PosX[i]);
+        BallCell[i] = cell;
+        CellStart[cell + 1]++;
+    }
+
+    // Prefix sum gives the first slot of every cell
+    for (int c = 0; c < numCells; c++)
+        CellStart[c + 1] += CellStart[c];
+
+    // Scatter ball indices into their cell ranges (keeps ascending index order per cell)
+    CellCursor.assign(CellStart.begin(), CellStart.end() - 1);
+    for (int i = 0; i < numBalls; i++)
+    {
+        int cell = BallCell[i];
+        if (cell < 0)
+            continue;
+        CellBalls[CellCursor[cell]++] = i;
+    }
+}
+
+void SpatialGrid::FindAwakePairs(const BallStore& balls, std::vector<BallPair>& pairs) const
+{
+    pairs.clear();
+
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awake[k];
+        int cell = BallCell[i];
+        if (cell < 0)
+            continue;
+
+        int cx = cell % Columns;
+        int cz = cell / Columns;
+
+        int x0 = cx > 0 ? cx - 1 : 0;
+        int x1 = cx < Columns - 1 ? cx + 1 : Columns - 1;
+        int z0 = cz > 0 ? cz - 1 : 0;
+        int z1 = cz < Rows - 1 ? cz + 1 : Rows - 1;
+
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                int neighbour = z * Columns + x;
+                for (int slot = CellStart[neighbour]; slot < CellStart[neighbour + 1]; slot++)
+                {
+                    int j = CellBalls[slot];
+                    if (j == i)
+                        continue;
+
+                    // Awake-awake pairs are found from both sides; keep the one from the lower index
+                    if (balls.IsAwake(j) && j < i)
+                        continue;
+
+                    if (j > i)
+                        pairs.push_back({ i, j });
+                    else
+                        pairs.push_back({ j, i });
+                }
+            }
+        }
+    }
+}
+
+void SpatialGrid::SortPairs(std::vector<BallPair>& pairs)
+{
+    std::sort(pairs.begin(), pairs.end(), [](const BallPair& a, const BallPair& b)
+    {
+        return a.A != b.A ? a.A < b.A : a.B < b.B;
+    });
+}
+
+int SpatialGrid::CellX(float x) const
+{
+    int c = (int)((x - OriginX) * InvCellSize);
+    if (c < 0) return 0;
+    if (c >= Columns) return Columns - 1;
+    return c;
+}
+
+int SpatialGrid::CellZ(float z) const
+{
+    int c = (int)((z - OriginZ) * InvCellSize);
+    if (c < 0) return 0;
+    if (c >= Rows) return Rows - 1;
+    return c;
+}
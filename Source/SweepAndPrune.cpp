@@ -0,0 +1,194 @@
+#include "../Header/SweepAndPrune.h"
+#include <algorithm>
+#include <cmath>
+
+// Bounds are grown by this fraction of the largest radius, so balls can be
+// pushed apart this far within a step before the pairs have to be found again
+static const float PAIR_MARGIN = 0.25f;
+
+SweepAndPrune::SweepAndPrune()
+    : MaxRadius(0.0f)
+    , Margin(0.0f)
+    , Swaps(0)
+{
+}
+
+void SweepAndPrune::Update(const BallStore& balls)
+{
+    int numBalls = balls.Size();
+    int numEntries = (int)Entries.size();
+
+    // Rebuild when balls were added, potted or put back since the last update
+    int numActive = 0;
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (balls.IsActive(i))
+            numActive++;
+    }
+    if ((int)Slot.size() != numBalls || numActive != numEntries)
+    {
+        Rebuild(balls);
+        return;
+    }
+
+    // Refresh the snapshot in the old order and insertion sort it in the same
+    // sweep: balls moved a fraction of a diameter, so few entries move far
+    MaxRadius = 0.0f;
+    Swaps = 0;
+    for (int s = 0; s < numEntries; s++)
+    {
+        Entry e = Entries[s];
+        int i = e.Ball;
+        if (!balls.IsActive(i))
+        {
+            // Same count, different balls
+            Rebuild(balls);
+            return;
+        }
+
+        e.X = balls.PosX[i];
+        e.Z = balls.PosZ[i];
+        e.Radius = balls.Radius[i];
+        e.MinZ = e.Z - e.Radius;
+        MaxRadius = std::max(MaxRadius, e.Radius);
+
+        int t = s;
+        while (t > 0 && e.MinZ < Entries[t - 1].MinZ)
+        {
+            Entries[t] = Entries[t - 1];
+            Slot[Entries[t].Ball] = t;
+            t--;
+        }
+        Entries[t] = e;
+        Slot[i] = t;
+        Swaps += s - t;
+    }
+    Margin = MaxRadius * PAIR_MARGIN;
+}
+
+void SweepAndPrune::Rebuild(const BallStore& balls)
+{
+    int numBalls = balls.Size();
+    Slot.assign(numBalls, -1);
+    Entries.clear();
+    MaxRadius = 0.0f;
+
+    for (int i = 0; i < numBalls; i++)
+    {
+        if (!balls.IsActive(i))
+            continue;
+
+        Entry e;
+        e.X = balls.PosX[i];
+        e.Z = balls.PosZ[i];
+        e.Radius = balls.Radius[i];
+        e.MinZ = e.Z - e.Radius;
+        e.Ball = i;
+        Entries.push_back(e);
+        MaxRadius = std::max(MaxRadius, e.Radius);
+    }
+    Margin = MaxRadius * PAIR_MARGIN;
+
+    std::sort(Entries.begin(), Entries.end(), [](const Entry& a, const Entry& b)
+    {
+        return a.MinZ < b.MinZ;
+    });
+
+    for (int s = 0; s < (int)Entries.size(); s++)
+        Slot[Entries[s].Ball] = s;
+    Swaps = -1;
+}
+
+bool SweepAndPrune::HasMoved(const BallStore& balls) const
+{
+    float marginSq = Margin * Margin;
+
+    // Sleeping balls do not move
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awake[k];
+        if (i >= (int)Slot.size() || Slot[i] < 0)
+        {
+            if (balls.IsActive(i))
+                return true;
+            continue;
+        }
+
+        const Entry& e = Entries[Slot[i]];
+        float dx = balls.PosX[i] - e.X;
+        float dz = balls.PosZ[i] - e.Z;
+        if (dx * dx + dz * dz > marginSq)
+            return true;
+    }
+    return false;
+}
+
+void SweepAndPrune::FindAwakePairs(const BallStore& balls, std::vector<BallPair>& pairs) const
+{
+    pairs.clear();
+
+    const int* awake = balls.GetAwakeBalls();
+    int numAwake = balls.GetAwakeCount();
+    for (int k = 0; k < numAwake; k++)
+    {
+        int i = awake[k];
+        if (i < (int)Slot.size() && Slot[i] >= 0)
+            ScanFrom(Slot[i], &balls, pairs);
+    }
+}
+
+void SweepAndPrune::FindBallPairs(int ball, std::vector<BallPair>& pairs) const
+{
+    if (ball < (int)Slot.size() && Slot[ball] >= 0)
+        ScanFrom(Slot[ball], nullptr, pairs);
+}
+
+void SweepAndPrune::ScanFrom(int slot, const BallStore* balls, std::vector<BallPair>& pairs) const
+{
+    const Entry& e = Entries[slot];
+    int i = e.Ball;
+    int numEntries = (int)Entries.size();
+
+    // Z range of every ball whose grown bounds can overlap this one's
+    float farZ = e.Z + e.Radius + 2.0f * Margin;
+    float nearZ = e.MinZ - 2.0f * (MaxRadius + Margin);
+
+    // Balls sorted after this one start at or beyond its near edge; balls sorted
+    // before it start earlier and are at most one diameter long
+    for (int dir = 1; dir >= -1; dir -= 2)
+    {
+        for (int s = slot + dir; s >= 0 && s < numEntries; s += dir)
+        {
+            const Entry& o = Entries[s];
+            if (dir > 0 ? o.MinZ > farZ : o.MinZ < nearZ)
+                break;
+
+            int j = o.Ball;
+
+            // Awake-awake pairs are found from both sides; keep the one from the lower index
+            if (balls && balls->IsAwake(j) && j < i)
+                continue;
+
+            float reach = e.Radius + o.Radius + 2.0f * Margin;
+            if (fabsf(o.X - e.X) > reach || fabsf(o.Z - e.Z) > reach)
+                continue;
+
+            if (j > i)
+                pairs.push_back({ i, j });
+            else
+                pairs.push_back({ j, i });
+        }
+    }
+}
+
+float SweepAndPrune::GetMargin() const
+{
+    return Margin;
+}
+
+int SweepAndPrune::GetSwapCount() const
+{
+    return Swaps;
+}
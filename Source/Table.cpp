@@ -1,13 +1,7 @@
 #include "../Header/Table.h"
 
-// Default dimensions based on standard 9-foot pool table (scaled)
 Table::Table()
-    : Width(2.5f)          // ~2.5 units wide (X)
-    , Length(5.0f)         // ~5 units long (Z) - 2:1 ratio
-    , CushionHeight(0.08f) // Height of cushion
-    , CushionWidth(0.15f)  // Thickness of cushion
-    , PocketRadius(0.12f)
-    , SurfaceColor(0.05f, 0.5f, 0.1f)     // Rich green felt
+    : SurfaceColor(0.05f, 0.5f, 0.1f)     // Rich green felt
     , CushionColor(0.04f, 0.42f, 0.08f)   // Green felt on cushions
     , FrameColor(0.35f, 0.2f, 0.08f)      // Warm dark wood frame
     , SurfaceVAO(0), SurfaceVBO(0), SurfaceEBO(0), SurfaceIndexCount(0)
@@ -16,25 +10,10 @@ Table::Table()
     , PocketVAO(0), PocketVBO(0), PocketEBO(0), PocketIndexCount(0)
     , PocketRimVAO(0), PocketRimVBO(0), PocketRimEBO(0), PocketRimIndexCount(0)
 {
-    float hw = Width / 2.0f;
-    float hl = Length / 2.0f;
-    // Pockets shifted slightly into the cushion/frame area for a more embedded look
-    float co = 0.03f; // corner offset (diagonal)
-    float so = 0.04f; // side offset (perpendicular to rail)
-    PocketPositions[0] = Vec3(-hw - co, 0.0f, -hl - co); // back-left corner
-    PocketPositions[1] = Vec3( hw + co, 0.0f, -hl - co); // back-right corner
-    PocketPositions[2] = Vec3(-hw - co, 0.0f,  hl + co); // front-left corner
-    PocketPositions[3] = Vec3( hw + co, 0.0f,  hl + co); // front-right corner
-    PocketPositions[4] = Vec3(-hw - so, 0.0f,  0.0f);    // left side
-    PocketPositions[5] = Vec3( hw + so, 0.0f,  0.0f);    // right side
 }
 
 Table::Table(float width, float length, float cushionHeight, float cushionWidth)
-    : Width(width)
-    , Length(length)
-    , CushionHeight(cushionHeight)
-    , CushionWidth(cushionWidth)
-    , PocketRadius(0.12f)
+    : TableGeometry(width, length, cushionHeight, cushionWidth)
     , SurfaceColor(0.05f, 0.5f, 0.1f)
     , CushionColor(0.04f, 0.42f, 0.08f)
     , FrameColor(0.35f, 0.2f, 0.08f)
@@ -44,16 +23,6 @@ Table::Table(float width, float length, float cushionHeight, float cushionWidth)
     , PocketVAO(0), PocketVBO(0), PocketEBO(0), PocketIndexCount(0)
     , PocketRimVAO(0), PocketRimVBO(0), PocketRimEBO(0), PocketRimIndexCount(0)
 {
-    float hw = Width / 2.0f;
-    float hl = Length / 2.0f;
-    float co = 0.03f;
-    float so = 0.04f;
-    PocketPositions[0] = Vec3(-hw - co, 0.0f, -hl - co);
-    PocketPositions[1] = Vec3( hw + co, 0.0f, -hl - co);
-    PocketPositions[2] = Vec3(-hw - co, 0.0f,  hl + co);
-    PocketPositions[3] = Vec3( hw + co, 0.0f,  hl + co);
-    PocketPositions[4] = Vec3(-hw - so, 0.0f,  0.0f);
-    PocketPositions[5] = Vec3( hw + so, 0.0f,  0.0f);
 }
 
 Table::~Table()
@@ -138,42 +107,6 @@ void Table::Render(Shader& shader, const Mat4& viewProjection)
     glBindVertexArray(0);
 }
 
-Vec3 Table::GetPlayAreaHalfExtents() const
-{
-    // Inner playing area (inside cushions)
-    return Vec3(Width / 2.0f, 0.0f, Length / 2.0f);
-}
-
-float Table::GetMinX() const
-{
-    return -Width / 2.0f;
-}
-
-float Table::GetMaxX() const
-{
-    return Width / 2.0f;
-}
-
-float Table::GetMinZ() const
-{
-    return -Length / 2.0f;
-}
-
-float Table::GetMaxZ() const
-{
-    return Length / 2.0f;
-}
-
-const Vec3* Table::GetPocketPositions() const
-{
-    return PocketPositions;
-}
-
-float Table::GetPocketRadius() const
-{
-    return PocketRadius;
-}
-
 void Table::GenerateSurfaceMesh()
 {
     MeshData mesh;
@@ -0,0 +1,558 @@
+#include "../Header/TableGeometry.h"
+#include "../Header/DeterministicMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Side of a zone grid cell (a power of two, so cell coordinates are exact)
+static const float ZONE_CELL_SIZE = 1.0f / 16.0f;
+
+// Cells are classified as if this much larger on every side, so rounding
+// when mapping a point to a cell can never pick a cell with a wrong flag
+static const double ZONE_CELL_MARGIN = 1e-4;
+
+// Segments approximating the liner around the back of each pocket
+static const int LINER_SEGMENTS = 8;
+
+// Node spacing of the cushion distance field
+static const float DISTANCE_FIELD_CELL_SIZE = 1.0f / 64.0f;
+
+// Default dimensions based on standard 9-foot pool table (scaled)
+TableGeometry::TableGeometry()
+    : Width(2.5f)          // ~2.5 units wide (X)
+    , Length(5.0f)         // ~5 units long (Z) - 2:1 ratio
+    , CushionHeight(0.08f) // Height of cushion
+    , CushionWidth(0.15f)  // Thickness of cushion
+    , PocketRadius(0.12f)
+    , Backend(CushionBackend::Rails)
+{
+    PlacePockets();
+    PlaceCushions();
+    BakeZones();
+}
+
+TableGeometry::TableGeometry(float width, float length, float cushionHeight, float cushionWidth)
+    : Width(width)
+    , Length(length)
+    , CushionHeight(cushionHeight)
+    , CushionWidth(cushionWidth)
+    , PocketRadius(0.12f)
+    , Backend(CushionBackend::Rails)
+{
+    PlacePockets();
+    PlaceCushions();
+    BakeZones();
+}
+
+void TableGeometry::PlacePockets()
+{
+    float hw = Width / 2.0f;
+    float hl = Length / 2.0f;
+    // Pockets shifted slightly into the cushion/frame area for a more embedded look
+    float co = 0.03f; // corner offset (diagonal)
+    float so = 0.04f; // side offset (perpendicular to rail)
+    PocketPositions[0] = Vec3(-hw - co, 0.0f, -hl - co); // back-left corner
+    PocketPositions[1] = Vec3( hw + co, 0.0f, -hl - co); // back-right corner
+    PocketPositions[2] = Vec3(-hw - co, 0.0f,  hl + co); // front-left corner
+    PocketPositions[3] = Vec3( hw + co, 0.0f,  hl + co); // front-right corner
+    PocketPositions[4] = Vec3(-hw - so, 0.0f,  0.0f);    // left side
+    PocketPositions[5] = Vec3( hw + so, 0.0f,  0.0f);    // right side
+}
+
+Vec3 TableGeometry::GetPlayAreaHalfExtents() const
+{
+    // Inner playing area (inside cushions)
+    return Vec3(Width / 2.0f, 0.0f, Length / 2.0f);
+}
+
+float TableGeometry::GetMinX() const
+{
+    return -Width / 2.0f;
+}
+
+float TableGeometry::GetMaxX() const
+{
+    return Width / 2.0f;
+}
+
+float TableGeometry::GetMinZ() const
+{
+    return -Length / 2.0f;
+}
+
+float TableGeometry::GetMaxZ() const
+{
+    return Length / 2.0f;
+}
+
+const Vec3* TableGeometry::GetPocketPositions() const
+{
+    return PocketPositions;
+}
+
+float TableGeometry::GetPocketRadius() const
+{
+    return PocketRadius;
+}
+
+float TableGeometry::GetPocketGapRadius() const
+{
+    // Cushion gap matches pocket radius; use 1.5x for margin so balls
+    // can smoothly enter pockets without catching on cushion edges
+    return PocketRadius * 1.5f;
+}
+
+float TableGeometry::GetRailBandWidth() const
+{
+    // A ball has to fit into a pocket, so no ball is wider than one
+    return PocketRadius;
+}
+
+/**
+ * Classify a cell against a circle
+ * @return 2 if the cell is entirely inside, 1 if the edge crosses it, 0 if it is outside
+ */
+static int ClassifyCell(double x0, double z0, double x1, double z1, double cx, double cz, double radius)
+{
+    double nearX = std::max(x0, std::min(cx, x1)) - cx;
+    double nearZ = std::max(z0, std::min(cz, z1)) - cz;
+    double farX = std::max(cx - x0, x1 - cx);
+    double farZ = std::max(cz - z0, z1 - cz);
+
+    if (farX * farX + farZ * farZ < radius * radius)
+        return 2;
+    if (nearX * nearX + nearZ * nearZ <= radius * radius)
+        return 1;
+    return 0;
+}
+
+/**
+ * Squared distance from a point to a segment
+ */
+static double SegmentDistanceSq(const CushionSegment& s, double x, double z)
+{
+    double dx = s.BX - s.AX;
+    double dz = s.BZ - s.AZ;
+    double lenSq = dx * dx + dz * dz;
+    double t = lenSq > 0.0 ? ((x - s.AX) * dx + (z - s.AZ) * dz) / lenSq : 0.0;
+    t = std::max(0.0, std::min(t, 1.0));
+    double ox = x - (s.AX + dx * t);
+    double oz = z - (s.AZ + dz * t);
+    return ox * ox + oz * oz;
+}
+
+float TableGeometry::GetOuterMargin() const
+{
+    // Cover the play area plus the cushions and every pocket gap
+    float gapRadius = GetPocketGapRadius();
+    return (CushionWidth > gapRadius ? CushionWidth : gapRadius) + gapRadius;
+}
+
+void TableGeometry::BakeZones()
+{
+    float band = GetRailBandWidth();
+    float gapRadius = GetPocketGapRadius();
+
+    float margin = GetOuterMargin();
+    ZoneOriginX = GetMinX() - margin;
+    ZoneOriginZ = GetMinZ() - margin;
+    ZoneInvCellSize = 1.0f / ZONE_CELL_SIZE;
+    ZoneColumns = (int)((GetMaxX() + margin - ZoneOriginX) * ZoneInvCellSize) + 1;
+    ZoneRows = (int)((GetMaxZ() + margin - ZoneOriginZ) * ZoneInvCellSize) + 1;
+
+    Zones.assign((size_t)ZoneColumns * ZoneRows, 0);
+    std::vector<int> nearby;
+
+    for (int row = 0; row < ZoneRows; row++)
+    {
+        for (int col = 0; col < ZoneColumns; col++)
+        {
+            double x0 = ZoneOriginX + col * (double)ZONE_CELL_SIZE - ZONE_CELL_MARGIN;
+            double z0 = ZoneOriginZ + row * (double)ZONE_CELL_SIZE - ZONE_CELL_MARGIN;
+            double x1 = x0 + ZONE_CELL_SIZE + 2.0 * ZONE_CELL_MARGIN;
+            double z1 = z0 + ZONE_CELL_SIZE + 2.0 * ZONE_CELL_MARGIN;
+
+            uint8_t zone = 0;
+            if (Backend == CushionBackend::Rails)
+            {
+                if (x0 < GetMinX() + band || x1 > GetMaxX() - band ||
+                    z0 < GetMinZ() + band || z1 > GetMaxZ() - band)
+                    zone |= ZONE_RAIL;
+            }
+            else
+            {
+                // Any segment within the band of any point of the cell
+                double centerX = (x0 + x1) * 0.5;
+                double centerZ = (z0 + z1) * 0.5;
+                double reach = band + 0.5 * std::sqrt((x1 - x0) * (x1 - x0) + (z1 - z0) * (z1 - z0));
+
+                Cushions.Query((float)(x0 - band), (float)(z0 - band), (float)(x1 + band), (float)(z1 + band), nearby);
+                for (int k : nearby)
+                {
+                    if (SegmentDistanceSq(Cushions.GetSegments()[k], centerX, centerZ) <= reach * reach)
+                    {
+                        zone |= ZONE_RAIL;
+                        break;
+                    }
+                }
+            }
+
+            int pocket = -1;
+            for (int p = 0; p < NUM_POCKETS; p++)
+            {
+                // The gap circle contains the pocket circle, so it decides which pockets reach the cell
+                int gap = ClassifyCell(x0, z0, x1, z1, PocketPositions[p].x, PocketPositions[p].z, gapRadius);
+                if (gap == 0)
+                    continue;
+
+                int hole = ClassifyCell(x0, z0, x1, z1, PocketPositions[p].x, PocketPositions[p].z, PocketRadius);
+                zone |= gap == 2 ? ZONE_GAP : ZONE_GAP_EDGE;
+                if (hole != 0)
+                    zone |= hole == 2 ? ZONE_POCKET : ZONE_POCKET_EDGE;
+
+                pocket = pocket < 0 ? p : ZONE_ANY_POCKET;
+            }
+
+            if (pocket >= 0)
+                zone |= (uint8_t)(pocket << ZONE_POCKET_SHIFT);
+            Zones[(size_t)row * ZoneColumns + col] = zone;
+        }
+    }
+}
+
+bool TableGeometry::IsInPocketGap(float x, float z) const
+{
+    return IsInPocketGap(x, z, GetZone(x, z));
+}
+
+bool TableGeometry::IsInPocketGap(float x, float z, uint8_t zone) const
+{
+    if (zone & ZONE_GAP)
+        return true;
+    if (!(zone & ZONE_GAP_EDGE))
+        return false;
+
+    float gapThreshold = GetPocketGapRadius();
+    int pocket = zone >> ZONE_POCKET_SHIFT;
+    int first = pocket == ZONE_ANY_POCKET ? 0 : pocket;
+    int last = pocket == ZONE_ANY_POCKET ? NUM_POCKETS - 1 : pocket;
+
+    for (int i = first; i <= last; i++)
+    {
+        float dx = x - PocketPositions[i].x;
+        float dz = z - PocketPositions[i].z;
+        float distSq = dx * dx + dz * dz;
+
+        if (distSq < gapThreshold * gapThreshold)
+            return true;
+    }
+    return false;
+}
+
+bool TableGeometry::IsOpenPath(float x0, float z0, float x1, float z1) const
+{
+    float fx0 = (x0 - ZoneOriginX) * ZoneInvCellSize;
+    float fz0 = (z0 - ZoneOriginZ) * ZoneInvCellSize;
+    float fx1 = (x1 - ZoneOriginX) * ZoneInvCellSize;
+    float fz1 = (z1 - ZoneOriginZ) * ZoneInvCellSize;
+
+    // The grid is convex, so both ends inside keep the whole segment inside
+    if (!(fx0 >= 0.0f && fz0 >= 0.0f && fx0 < (float)ZoneColumns && fz0 < (float)ZoneRows) ||
+        !(fx1 >= 0.0f && fz1 >= 0.0f && fx1 < (float)ZoneColumns && fz1 < (float)ZoneRows))
+        return false;
+
+    // Walk the cells the segment crosses, stepping into whichever neighbour
+    // the segment reaches first (one cell per step, ends included)
+    int col = (int)fx0;
+    int row = (int)fz0;
+    int endCol = (int)fx1;
+    int endRow = (int)fz1;
+    int stepCol = endCol > col ? 1 : -1;
+    int stepRow = endRow > row ? 1 : -1;
+
+    double dx = std::fabs((double)fx1 - fx0);
+    double dz = std::fabs((double)fz1 - fz0);
+    double nextX = dx > 0.0 ? (stepCol > 0 ? col + 1 - (double)fx0 : fx0 - (double)col) / dx : 1e30;
+    double nextZ = dz > 0.0 ? (stepRow > 0 ? row + 1 - (double)fz0 : fz0 - (double)row) / dz : 1e30;
+    double deltaX = dx > 0.0 ? 1.0 / dx : 1e30;
+    double deltaZ = dz > 0.0 ? 1.0 / dz : 1e30;
+
+    int remaining = std::abs(endCol - col) + std::abs(endRow - row);
+    for (;;)
+    {
+        if (Zones[(size_t)row * ZoneColumns + col] != 0)
+            return false;
+        if (remaining-- == 0)
+            return true;
+
+        if ((nextX < nextZ && col != endCol) || row == endRow)
+        {
+            col += stepCol;
+            nextX += deltaX;
+        }
+        else
+        {
+            row += stepRow;
+            nextZ += deltaZ;
+        }
+    }
+}
+
+int TableGeometry::FindPocket(float x, float z) const
+{
+    uint8_t zone = GetZone(x, z);
+    if (!(zone & (ZONE_POCKET | ZONE_POCKET_EDGE)))
+        return -1;
+
+    int pocket = zone >> ZONE_POCKET_SHIFT;
+    if ((zone & ZONE_POCKET) && pocket != ZONE_ANY_POCKET)
+        return pocket;
+
+    float prSq = PocketRadius * PocketRadius;
+    int first = pocket == ZONE_ANY_POCKET ? 0 : pocket;
+    int last = pocket == ZONE_ANY_POCKET ? NUM_POCKETS - 1 : pocket;
+
+    for (int p = first; p <= last; p++)
+    {
+        // Ball is potted when its center enters the pocket circle,
+        // which corresponds to ~50% of the ball being over the hole
+        float dx = x - PocketPositions[p].x;
+        float dz = z - PocketPositions[p].z;
+        if (dx * dx + dz * dz < prSq)
+            return p;
+    }
+    return -1;
+}
+
+void TableGeometry::PlaceCushions()
+{
+    // Outline edges run left, front, right, back; report them as rails 0, 3, 1, 2
+    std::vector<Vec3> outline = {
+        Vec3(GetMinX(), 0.0f, GetMinZ()),
+        Vec3(GetMinX(), 0.0f, GetMaxZ()),
+        Vec3(GetMaxX(), 0.0f, GetMaxZ()),
+        Vec3(GetMaxX(), 0.0f, GetMinZ())
+    };
+    const int rails[4] = { 0, 3, 1, 2 };
+    BuildCushions(outline, rails);
+}
+
+/**
+ * Part of an outline edge inside a pocket gap, as edge parameters
+ */
+struct MouthCut
+{
+    float T0;
+    float T1;
+    int Pocket;
+};
+
+/**
+ * Wrap an angle into [0, 2 pi) (the angles here are jaw angle differences, within a turn or two)
+ */
+static float WrapAngle(float angle)
+{
+    const float TWO_PI = 2.0f * PI;
+    while (angle >= TWO_PI)
+        angle -= TWO_PI;
+    while (angle < 0.0f)
+        angle += TWO_PI;
+    return angle;
+}
+
+/**
+ * Trig for the cushion points: the segments (and the distance field baked from them) are
+ * simulation state, so a deterministic build must not take them from the platform libm
+ */
+static float GeometryAtan2(float y, float x)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return (float)DeterministicMath::Atan2(y, x);
+#else
+    return atan2f(y, x);
+#endif
+}
+
+static float GeometryCos(float angle)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return (float)DeterministicMath::Cos(angle);
+#else
+    return cosf(angle);
+#endif
+}
+
+static float GeometrySin(float angle)
+{
+#ifdef BILLIARD_DETERMINISTIC
+    return (float)DeterministicMath::Sin(angle);
+#else
+    return sinf(angle);
+#endif
+}
+
+void TableGeometry::BuildCushions(const std::vector<Vec3>& outline, const int* edgeRails)
+{
+    std::vector<CushionSegment> segments;
+    float gapRadius = GetPocketGapRadius();
+    int numEdges = (int)outline.size();
+
+    // Angles (around the pocket center) at which jaws meet each pocket
+    std::vector<float> jawAngles[NUM_POCKETS];
+
+    // Jaw from a mouth corner straight toward the pocket, ending on the pocket circle
+    auto addJaw = [&](float x, float z, int pocket, int rail)
+    {
+        float dx = x - PocketPositions[pocket].x;
+        float dz = z - PocketPositions[pocket].z;
+        float scale = PocketRadius / sqrtf(dx * dx + dz * dz);
+        float endX = PocketPositions[pocket].x + dx * scale;
+        float endZ = PocketPositions[pocket].z + dz * scale;
+        segments.push_back({ x, z, endX, endZ, rail });
+        jawAngles[pocket].push_back(GeometryAtan2(dz, dx));
+    };
+
+    std::vector<MouthCut> cuts;
+    for (int e = 0; e < numEdges; e++)
+    {
+        const Vec3& a = outline[e];
+        const Vec3& b = outline[(e + 1) % numEdges];
+        int rail = edgeRails ? edgeRails[e] : e;
+
+        float dx = b.x - a.x;
+        float dz = b.z - a.z;
+        float lenSq = dx * dx + dz * dz;
+        if (lenSq <= 0.0f)
+            continue;
+
+        // Where the edge enters and leaves each pocket gap: |a + t d - p|^2 = gap^2
+        cuts.clear();
+        for (int p = 0; p < NUM_POCKETS; p++)
+        {
+            float fx = a.x - PocketPositions[p].x;
+            float fz = a.z - PocketPositions[p].z;
+            float half = fx * dx + fz * dz;
+            float c = fx * fx + fz * fz - gapRadius * gapRadius;
+            float disc = half * half - lenSq * c;
+            if (disc <= 0.0f)
+                continue;
+
+            float root = sqrtf(disc);
+            float t0 = (-half - root) / lenSq;
+            float t1 = (-half + root) / lenSq;
+            if (t1 <= 0.0f || t0 >= 1.0f)
+                continue;
+            cuts.push_back({ t0, t1, p });
+        }
+        std::sort(cuts.begin(), cuts.end(), [](const MouthCut& l, const MouthCut& r) { return l.T0 < r.T0; });
+
+        // Keep the pieces between the mouths; jaws start where a mouth opens inside the edge
+        float t = 0.0f;
+        for (const MouthCut& cut : cuts)
+        {
+            if (cut.T0 > t)
+                segments.push_back({ a.x + dx * t, a.z + dz * t, a.x + dx * cut.T0, a.z + dz * cut.T0, rail });
+            if (cut.T0 > 0.0f)
+                addJaw(a.x + dx * cut.T0, a.z + dz * cut.T0, cut.Pocket, rail);
+            if (cut.T1 < 1.0f)
+                addJaw(a.x + dx * cut.T1, a.z + dz * cut.T1, cut.Pocket, rail);
+            t = std::max(t, cut.T1);
+        }
+        if (t < 1.0f)
+            segments.push_back({ a.x + dx * t, a.z + dz * t, b.x, b.z, rail });
+    }
+
+    // Line the back of every pocket between its two jaws, so no ball can leave the table
+    float centerX = 0.0f;
+    float centerZ = 0.0f;
+    for (const Vec3& point : outline)
+    {
+        centerX += point.x / numEdges;
+        centerZ += point.z / numEdges;
+    }
+
+    for (int p = 0; p < NUM_POCKETS; p++)
+    {
+        if (jawAngles[p].size() != 2)
+            continue;
+
+        const Vec3& pocket = PocketPositions[p];
+        float start = jawAngles[p][0];
+        float span = WrapAngle(jawAngles[p][1] - start);
+
+        // Go the way round that does not face the table
+        float tableAngle = GeometryAtan2(centerZ - pocket.z, centerX - pocket.x);
+        if (WrapAngle(tableAngle - start) < span)
+        {
+            start = jawAngles[p][1];
+            span = 2.0f * PI - span;
+        }
+
+        for (int k = 0; k < LINER_SEGMENTS; k++)
+        {
+            float a0 = start + span * k / LINER_SEGMENTS;
+            float a1 = start + span * (k + 1) / LINER_SEGMENTS;
+            segments.push_back({ pocket.x + PocketRadius * GeometryCos(a0), pocket.z + PocketRadius * GeometrySin(a0),
+                                 pocket.x + PocketRadius * GeometryCos(a1), pocket.z + PocketRadius * GeometrySin(a1), -1 });
+        }
+    }
+
+    Cushions.Build(segments);
+    Field.Clear();
+}
+
+void TableGeometry::SetCushionBackend(CushionBackend backend)
+{
+    Backend = backend;
+    if (Backend == CushionBackend::DistanceField && !Field.IsBaked())
+        BakeDistanceField();
+    BakeZones();
+}
+
+CushionBackend TableGeometry::GetCushionBackend() const
+{
+    return Backend;
+}
+
+void TableGeometry::SetCushionOutline(const std::vector<Vec3>& outline)
+{
+    BuildCushions(outline, nullptr);
+    Backend = CushionBackend::Segments;
+    BakeZones();
+}
+
+void TableGeometry::SetCushionSegments(const std::vector<CushionSegment>& segments)
+{
+    Cushions.Build(segments);
+    Field.Clear();
+    Backend = CushionBackend::Segments;
+    BakeZones();
+}
+
+const CushionBVH& TableGeometry::GetCushions() const
+{
+    return Cushions;
+}
+
+bool TableGeometry::BakeDistanceField(const char* cachePath, int threadCount)
+{
+    float margin = GetOuterMargin();
+    float minX = GetMinX() - margin;
+    float minZ = GetMinZ() - margin;
+    float maxX = GetMaxX() + margin;
+    float maxZ = GetMaxZ() + margin;
+
+    uint64_t key = DistanceField::ComputeKey(Cushions, minX, minZ, maxX, maxZ, DISTANCE_FIELD_CELL_SIZE);
+    if (cachePath && Field.Load(cachePath, key))
+        return true;
+
+    Field.Bake(Cushions, minX, minZ, maxX, maxZ, DISTANCE_FIELD_CELL_SIZE, threadCount);
+    if (cachePath)
+        Field.Save(cachePath, key);
+    return false;
+}
+
+const DistanceField& TableGeometry::GetDistanceField() const
+{
+    return Field;
+}
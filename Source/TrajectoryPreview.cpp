@@ -0,0 +1,254 @@
+#include "../Header/TrajectoryPreview.h"
+#include <cmath>
+
+// Default length of a prediction (long enough for a hard shot to play out)
+static const float DEFAULT_PREVIEW_TIME = 4.0f;
+
+// Record a path point every this many steps (plus the contact, pocket and end points)
+static const int PATH_SAMPLE_STEPS = 4;
+
+/**
+ * Distance along a ray to where it first comes within a radius of a point
+ * @return Distance, or a negative value if it never does
+ */
+static float RayCircleDistance(const Vec3& origin, const Vec3& dir, const Vec3& center, float radius)
+{
+    Vec3 toCenter = center - origin;
+    float along = toCenter.x * dir.x + toCenter.z * dir.z;
+    float perpSq = toCenter.x * toCenter.x + toCenter.z * toCenter.z - along * along;
+    float radiusSq = radius * radius;
+    if (perpSq > radiusSq)
+        return -1.0f;
+    return along - sqrtf(radiusSq - perpSq);
+}
+
+TrajectoryPreview::TrajectoryPreview(const TableGeometry& table, float deltaTime)
+    : Geometry(table)
+    , DeltaTime(deltaTime)
+    , MaxTime(DEFAULT_PREVIEW_TIME)
+    , PendingCueBall(-1)
+    , PendingPower(0.0f)
+    , HasPending(false)
+    , Stopping(false)
+    , LatestRequest(0)
+    , HasResult(false)
+{
+    // Start the worker last, once every member it reads is initialized
+    Worker = std::thread(&TrajectoryPreview::WorkerLoop, this);
+}
+
+TrajectoryPreview::~TrajectoryPreview()
+{
+    {
+        std::lock_guard<std::mutex> lock(RequestMutex);
+        Stopping = true;
+        LatestRequest++;
+    }
+    RequestReady.notify_one();
+    Worker.join();
+}
+
+unsigned int TrajectoryPreview::Request(const BallStore& balls, int cueBall, const Vec3& direction, float power)
+{
+    unsigned int id;
+    {
+        std::lock_guard<std::mutex> lock(RequestMutex);
+        PendingBalls = balls;
+        PendingCueBall = cueBall;
+        PendingDirection = direction;
+        PendingPower = power;
+        HasPending = true;
+
+        // Bumping the id also aborts the prediction in progress
+        id = ++LatestRequest;
+    }
+    RequestReady.notify_one();
+    return id;
+}
+
+void TrajectoryPreview::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(RequestMutex);
+        HasPending = false;
+        LatestRequest++;
+    }
+
+    std::lock_guard<std::mutex> lock(ResultMutex);
+    HasResult = false;
+}
+
+bool TrajectoryPreview::GetLatest(PreviewResult& result) const
+{
+    std::lock_guard<std::mutex> lock(ResultMutex);
+    if (!HasResult)
+        return false;
+    result = Latest;
+    return true;
+}
+
+void TrajectoryPreview::SetMaxTime(float seconds)
+{
+    MaxTime = seconds;
+}
+
+float TrajectoryPreview::GetMaxTime() const
+{
+    return MaxTime;
+}
+
+void TrajectoryPreview::WorkerLoop()
+{
+    BallStore balls;
+    PreviewResult result;
+
+    for (;;)
+    {
+        unsigned int id;
+        int cueBall;
+        Vec3 direction;
+        float power;
+        {
+            std::unique_lock<std::mutex> lock(RequestMutex);
+            RequestReady.wait(lock, [this]() { return HasPending || Stopping; });
+            if (Stopping)
+                return;
+
+            // Take the request; a newer one posted meanwhile replaces it in Pending
+            balls = PendingBalls;
+            cueBall = PendingCueBall;
+            direction = PendingDirection;
+            power = PendingPower;
+            id = LatestRequest;
+            HasPending = false;
+        }
+
+        if (!Predict(id, balls, cueBall, direction, power, result))
+            continue;
+
+        // Publish only if no newer request or Cancel arrived while finishing up
+        std::lock_guard<std::mutex> lock(ResultMutex);
+        if (LatestRequest == id)
+        {
+            std::swap(Latest, result);
+            HasResult = true;
+        }
+    }
+}
+
+void TrajectoryPreview::RecordContact(PreviewResult& result, const BallStore& balls, int cueBall, int objectBall,
+                                      const Vec3& cueStart, const Vec3& cueVelocity)
+{
+    // The object ball was resting where it started the step; find where the
+    // cue ball's path first touches it (the end of the step if rounding misses it)
+    Vec3 objectStart(StepStartX[objectBall], 0.0f, StepStartZ[objectBall]);
+    Vec3 dir = cueVelocity.Normalized();
+    float reach = balls.Radius[cueBall] + balls.Radius[objectBall];
+    float along = RayCircleDistance(cueStart, dir, objectStart, reach);
+    Vec3 contact = along >= 0.0f ? cueStart + dir * along : Vec3(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]);
+
+    // Deflections from the equal-mass impulse Physics applies: the object ball
+    // leaves along the line of centers, the cue ball keeps the tangential part
+    // plus what restitution leaves of the normal part
+    Vec3 normal = (objectStart - contact).Normalized();
+    float approach = Dot(cueVelocity, normal);
+    float transfer = (1.0f + PhysicsConstants::BALL_RESTITUTION) * 0.5f * approach;
+
+    result.HasContact = true;
+    result.ContactBall = objectBall;
+    result.ContactPosition = contact;
+    result.CueDeflection = (cueVelocity - normal * transfer).Normalized();
+    result.ObjectDeflection = normal;
+    result.CuePath.push_back(contact);
+    result.ObjectPath.push_back(objectStart);
+}
+
+bool TrajectoryPreview::Predict(unsigned int id, BallStore& balls, int cueBall, const Vec3& direction,
+                                float power, PreviewResult& result)
+{
+    result.RequestId = id;
+    result.CuePath.clear();
+    result.ObjectPath.clear();
+    result.HasContact = false;
+    result.ContactBall = -1;
+    result.ContactPosition = Vec3();
+    result.CueDeflection = Vec3();
+    result.ObjectDeflection = Vec3();
+
+    if (cueBall < 0 || cueBall >= balls.Size() || !balls.IsActive(cueBall))
+        return true;
+
+    Events.clear();
+    Sim.SetEventLog(&Events);
+    Sim.ApplyImpulse(balls, cueBall, direction, power);
+    result.CuePath.push_back(Vec3(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]));
+
+    const Vec3* pockets = Geometry.GetPocketPositions();
+    int maxSteps = (int)(MaxTime / DeltaTime);
+    int objectBall = -1;
+    bool cueDone = false;     // Cue ball potted (a scratch respawns it elsewhere)
+    bool objectDone = false;  // Object ball potted
+    size_t eventsSeen = 0;
+
+    for (int step = 1; step <= maxSteps && !Sim.AllBallsStopped(balls); step++)
+    {
+        if (LatestRequest != id)
+        {
+            Sim.SetEventLog(nullptr);
+            return false;
+        }
+
+        // Until the first contact only the cue ball moves, so the state before
+        // the step is all that is needed to reconstruct the contact exactly
+        Vec3 cueStart(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]);
+        Vec3 cueVelocity = balls.GetVelocity(cueBall);
+        if (objectBall < 0)
+        {
+            StepStartX.assign(balls.PosX, balls.PosX + balls.Size());
+            StepStartZ.assign(balls.PosZ, balls.PosZ + balls.Size());
+        }
+
+        Sim.Update(balls, Geometry, DeltaTime);
+
+        bool contactThisStep = false;
+        for (; eventsSeen < Events.size(); eventsSeen++)
+        {
+            const PhysicsEvent& e = Events[eventsSeen];
+            if (e.Type == PhysicsEventType::BallContact && objectBall < 0 && !cueDone &&
+                (e.Ball == cueBall || e.Other == cueBall))
+            {
+                objectBall = e.Ball == cueBall ? e.Other : e.Ball;
+                contactThisStep = true;
+                RecordContact(result, balls, cueBall, objectBall, cueStart, cueVelocity);
+            }
+            else if (e.Type == PhysicsEventType::Scratch && e.Ball == cueBall && !cueDone)
+            {
+                // End the path at the pocket rather than at the respawn point
+                cueDone = true;
+                result.CuePath.push_back(Vec3(pockets[e.Other].x, 0.0f, pockets[e.Other].z));
+            }
+            else if (e.Type == PhysicsEventType::Pot && e.Ball == objectBall && !objectDone)
+            {
+                objectDone = true;
+                result.ObjectPath.push_back(Vec3(pockets[e.Other].x, 0.0f, pockets[e.Other].z));
+            }
+        }
+
+        if (step % PATH_SAMPLE_STEPS == 0 && !contactThisStep)
+        {
+            if (!cueDone)
+                result.CuePath.push_back(Vec3(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]));
+            if (objectBall >= 0 && !objectDone)
+                result.ObjectPath.push_back(Vec3(balls.PosX[objectBall], 0.0f, balls.PosZ[objectBall]));
+        }
+    }
+
+    // End points where the balls came to rest (or the time ran out)
+    if (!cueDone)
+        result.CuePath.push_back(Vec3(balls.PosX[cueBall], 0.0f, balls.PosZ[cueBall]));
+    if (objectBall >= 0 && !objectDone)
+        result.ObjectPath.push_back(Vec3(balls.PosX[objectBall], 0.0f, balls.PosZ[objectBall]));
+
+    Sim.SetEventLog(nullptr);
+    return true;
+}
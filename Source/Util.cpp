@@ -11,204 +11,6 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "../Header/stb_image.h"
 
-// ============================================================================
-// MAT4 IMPLEMENTATION
-// ============================================================================
-
-Mat4 Mat4::operator*(const Mat4& other) const
-{
-    Mat4 result;
-    // Clear result to zero
-    for (int i = 0; i < 16; i++) result.m[i] = 0.0f;
-
-    // Matrix multiplication (column-major)
-    for (int col = 0; col < 4; col++)
-    {
-        for (int row = 0; row < 4; row++)
-        {
-            for (int k = 0; k < 4; k++)
-            {
-                result.m[col * 4 + row] += m[k * 4 + row] * other.m[col * 4 + k];
-            }
-        }
-    }
-    return result;
-}
-
-Mat4 Mat4::Identity()
-{
-    return Mat4(); // Default constructor creates identity
-}
-
-Mat4 Mat4::Translate(float x, float y, float z)
-{
-    Mat4 result;
-    result.m[12] = x;
-    result.m[13] = y;
-    result.m[14] = z;
-    return result;
-}
-
-Mat4 Mat4::Translate(const Vec3& v)
-{
-    return Translate(v.x, v.y, v.z);
-}
-
-Mat4 Mat4::Scale(float x, float y, float z)
-{
-    Mat4 result;
-    result.m[0] = x;
-    result.m[5] = y;
-    result.m[10] = z;
-    return result;
-}
-
-Mat4 Mat4::Scale(float s)
-{
-    return Scale(s, s, s);
-}
-
-Mat4 Mat4::RotateX(float radians)
-{
-    Mat4 result;
-    float c = cosf(radians);
-    float s = sinf(radians);
-    result.m[5] = c;
-    result.m[6] = s;
-    result.m[9] = -s;
-    result.m[10] = c;
-    return result;
-}
-
-Mat4 Mat4::RotateY(float radians)
-{
-    Mat4 result;
-    float c = cosf(radians);
-    float s = sinf(radians);
-    result.m[0] = c;
-    result.m[2] = -s;
-    result.m[8] = s;
-    result.m[10] = c;
-    return result;
-}
-
-Mat4 Mat4::RotateZ(float radians)
-{
-    Mat4 result;
-    float c = cosf(radians);
-    float s = sinf(radians);
-    result.m[0] = c;
-    result.m[1] = s;
-    result.m[4] = -s;
-    result.m[5] = c;
-    return result;
-}
-
-Mat4 Mat4::Perspective(float fovY, float aspect, float nearPlane, float farPlane)
-{
-    Mat4 result;
-    // Clear to zero
-    for (int i = 0; i < 16; i++) result.m[i] = 0.0f;
-
-    float tanHalfFov = tanf(fovY / 2.0f);
-
-    result.m[0] = 1.0f / (aspect * tanHalfFov);
-    result.m[5] = 1.0f / tanHalfFov;
-    result.m[10] = -(farPlane + nearPlane) / (farPlane - nearPlane);
-    result.m[11] = -1.0f;
-    result.m[14] = -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane);
-    result.m[15] = 0.0f;
-
-    return result;
-}
-
-Mat4 Mat4::Ortho(float left, float right, float bottom, float top, float nearPlane, float farPlane)
-{
-    Mat4 result;
-    for (int i = 0; i < 16; i++) result.m[i] = 0.0f;
-
-    result.m[0]  =  2.0f / (right - left);
-    result.m[5]  =  2.0f / (top - bottom);
-    result.m[10] = -2.0f / (farPlane - nearPlane);
-    result.m[12] = -(right + left) / (right - left);
-    result.m[13] = -(top + bottom) / (top - bottom);
-    result.m[14] = -(farPlane + nearPlane) / (farPlane - nearPlane);
-    result.m[15] =  1.0f;
-
-    return result;
-}
-
-Mat4 Mat4::LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
-{
-    Vec3 f = (target - eye).Normalized();  // Forward
-    Vec3 r = Cross(f, up).Normalized();     // Right
-    Vec3 u = Cross(r, f);                   // Up (recalculated)
-
-    Mat4 result;
-
-    // Rotation part
-    result.m[0] = r.x;
-    result.m[1] = u.x;
-    result.m[2] = -f.x;
-    result.m[3] = 0.0f;
-
-    result.m[4] = r.y;
-    result.m[5] = u.y;
-    result.m[6] = -f.y;
-    result.m[7] = 0.0f;
-
-    result.m[8] = r.z;
-    result.m[9] = u.z;
-    result.m[10] = -f.z;
-    result.m[11] = 0.0f;
-
-    // Translation part
-    result.m[12] = -Dot(r, eye);
-    result.m[13] = -Dot(u, eye);
-    result.m[14] = Dot(f, eye);
-    result.m[15] = 1.0f;
-
-    return result;
-}
-
-Mat4 Mat4::Inverse() const
-{
-    float inv[16], det;
-
-    inv[0] = m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
-    inv[4] = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
-    inv[8] = m[4]*m[9]*m[15] - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
-    inv[12] = -m[4]*m[9]*m[14] + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
-
-    inv[1] = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
-    inv[5] = m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
-    inv[9] = -m[0]*m[9]*m[15] + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
-    inv[13] = m[0]*m[9]*m[14] - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
-
-    inv[2] = m[1]*m[6]*m[15] - m[1]*m[7]*m[14] - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7] - m[13]*m[3]*m[6];
-    inv[6] = -m[0]*m[6]*m[15] + m[0]*m[7]*m[14] + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7] + m[12]*m[3]*m[6];
-    inv[10] = m[0]*m[5]*m[15] - m[0]*m[7]*m[13] - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7] - m[12]*m[3]*m[5];
-    inv[14] = -m[0]*m[5]*m[14] + m[0]*m[6]*m[13] + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6] + m[12]*m[2]*m[5];
-
-    inv[3] = -m[1]*m[6]*m[11] + m[1]*m[7]*m[10] + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7] + m[9]*m[3]*m[6];
-    inv[7] = m[0]*m[6]*m[11] - m[0]*m[7]*m[10] - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7] - m[8]*m[3]*m[6];
-    inv[11] = -m[0]*m[5]*m[11] + m[0]*m[7]*m[9] + m[4]*m[1]*m[11] - m[4]*m[3]*m[9] - m[8]*m[1]*m[7] + m[8]*m[3]*m[5];
-    inv[15] = m[0]*m[5]*m[10] - m[0]*m[6]*m[9] - m[4]*m[1]*m[10] + m[4]*m[2]*m[9] + m[8]*m[1]*m[6] - m[8]*m[2]*m[5];
-
-    det = m[0]*inv[0] + m[1]*inv[4] + m[2]*inv[8] + m[3]*inv[12];
-
-    if (fabsf(det) < 0.00001f)
-        return Mat4::Identity();
-
-    det = 1.0f / det;
-
-    Mat4 result;
-    for (int i = 0; i < 16; i++)
-        result.m[i] = inv[i] * det;
-
-    return result;
-}
-
 // ============================================================================
 // MESH GENERATION
 // ============================================================================
@@ -0,0 +1,76 @@
+#include "../Header/WorldSnapshot.h"
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<WorldSnapshot>::value,
+              "WorldSnapshot must stay plain data so it can be copied with memcpy");
+
+// Byte offset of field f in a block of the given capacity
+static size_t FieldOffset(int field, int capacity)
+{
+    return (size_t)field * capacity * 4;
+}
+
+bool WorldSnapshot::Save(const BallStore& balls)
+{
+    if (balls.Count > MAX_BALLS)
+        return false;
+
+    Count = balls.Count;
+    AwakeCount = balls.AwakeCount;
+    if (Count == 0)
+        return true;
+
+    // PosX is the first field, so it marks the start of the store's aligned block
+    const unsigned char* source = (const unsigned char*)balls.PosX;
+    if (balls.Capacity == MAX_BALLS)
+    {
+        std::memcpy(Block, source, BLOCK_BYTES);
+        return true;
+    }
+
+    for (int f = 0; f < BallStore::NUM_FIELDS; f++)
+    {
+        std::memcpy(Block + FieldOffset(f, MAX_BALLS), source + FieldOffset(f, balls.Capacity),
+                    (size_t)balls.Count * 4);
+    }
+    return true;
+}
+
+bool WorldSnapshot::Save(const BallStore& balls, const SimulationClock& clock)
+{
+    Clock = clock;
+    return Save(balls);
+}
+
+void WorldSnapshot::Restore(BallStore& balls) const
+{
+    if (balls.Capacity < MAX_BALLS)
+    {
+        balls.Count = 0;
+        balls.AwakeCount = 0;
+        balls.Reserve(MAX_BALLS);
+    }
+
+    balls.Count = Count;
+    balls.AwakeCount = AwakeCount;
+
+    unsigned char* target = (unsigned char*)balls.PosX;
+    if (balls.Capacity == MAX_BALLS)
+    {
+        std::memcpy(target, Block, BLOCK_BYTES);
+        return;
+    }
+
+    for (int f = 0; f < BallStore::NUM_FIELDS; f++)
+    {
+        std::memcpy(target + FieldOffset(f, balls.Capacity), Block + FieldOffset(f, MAX_BALLS),
+                    (size_t)Count * 4);
+    }
+}
+
+void WorldSnapshot::Restore(BallStore& balls, SimulationClock& clock) const
+{
+    Restore(balls);
+    clock = Clock;
+}
@@ -0,0 +1,133 @@
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+/**
+ * All Pairs Test
+ * --------------
+ * Steps the same shots with Broadphase::AllPairs under the scalar kernels
+ * (every pair through CheckBallCollision) and under each SIMD set the CPU
+ * supports (PhysicsKernels::FindOverlaps on tables of up to
+ * MAX_OVERLAP_BALLS balls), and checks the state hash after every step.
+ * Random tables run from a single ball to past MAX_OVERLAP_BALLS, with
+ * some balls potted, so partial blocks, inactive lanes and the fallback
+ * to the scalar loop are all covered.
+ */
+
+static const int SHOTS = 60;
+static const int RANDOM_STORES = 40;
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int MAX_STEPS = 100000;
+
+static int Failures = 0;
+
+static void Break(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float t = (float)shot / (SHOTS - 1);
+    float angle = -0.3f + 0.6f * t;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 4.0f + 6.0f * t);
+}
+
+/**
+ * Balls close enough to collide often, some potted, 1 to 40 of them
+ */
+static void Scatter(BallStore& balls, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(-0.6f, 0.6f);
+    std::uniform_real_distribution<float> z(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> v(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    int count = 1 + (int)((seed - 1) % 40);
+    for (int i = 0; i < count; i++)
+    {
+        int k = balls.Add(i, Vec3(x(rng), 0.057f, z(rng)), 0.057f);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+        if (unit(rng) < 0.1f)
+            balls.SetActive(k, false);
+    }
+}
+
+/**
+ * Step the scalar and SIMD all-pairs paths side by side until both report rest
+ * @return false (after reporting) on the first difference
+ */
+static bool CompareSteps(const char* name, PhysicsKernels::InstructionSet set, BallStore& scalarBalls)
+{
+    TableGeometry table;
+    BallStore simdBalls = scalarBalls;
+    Physics scalar;
+    Physics simd;
+    scalar.SetBroadphase(Broadphase::AllPairs);
+    simd.SetBroadphase(Broadphase::AllPairs);
+    scalar.SetInstructionSet(PhysicsKernels::InstructionSet::Scalar);
+    simd.SetInstructionSet(set);
+
+    for (int step = 0; step < MAX_STEPS; step++)
+    {
+        scalar.Update(scalarBalls, table, STEP_TIME);
+        simd.Update(simdBalls, table, STEP_TIME);
+        if (scalarBalls.ComputeHash() != simdBalls.ComputeHash())
+        {
+            printf("FAIL %s %s: state differs after step %d\n", PhysicsKernels::GetInstructionSetName(set), name,
+                   step);
+            return false;
+        }
+        if (scalar.AllBallsStopped(scalarBalls) && simd.AllBallsStopped(simdBalls))
+            return true;
+    }
+    printf("FAIL %s %s: no rest after %d steps\n", PhysicsKernels::GetInstructionSetName(set), name, MAX_STEPS);
+    return false;
+}
+
+static void CheckSet(PhysicsKernels::InstructionSet set)
+{
+    char name[32];
+    int failed = 0;
+
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        snprintf(name, sizeof(name), "break %d", shot);
+        BallStore balls;
+        Break(balls, shot);
+        failed += !CompareSteps(name, set, balls);
+    }
+
+    for (int seed = 1; seed <= RANDOM_STORES; seed++)
+    {
+        snprintf(name, sizeof(name), "random store %d", seed);
+        BallStore balls;
+        Scatter(balls, (unsigned)seed);
+        failed += !CompareSteps(name, set, balls);
+    }
+
+    printf("%s: %d breaks and %d random stores, %d failures\n", PhysicsKernels::GetInstructionSetName(set), SHOTS,
+           RANDOM_STORES, failed);
+    Failures += failed;
+}
+
+int main()
+{
+    using PhysicsKernels::InstructionSet;
+
+    // Every SIMD set up to the widest the CPU supports
+    InstructionSet widest = PhysicsKernels::DetectInstructionSet();
+    const InstructionSet sets[] = { InstructionSet::SSE2, InstructionSet::AVX2 };
+    int tested = 0;
+    for (InstructionSet set : sets)
+    {
+        if ((int)set > (int)widest)
+            continue;
+        CheckSet(set);
+        tested++;
+    }
+    if (tested == 0)
+        printf("no SIMD kernels on this CPU; nothing to compare\n");
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
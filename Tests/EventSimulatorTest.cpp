@@ -0,0 +1,196 @@
+#include "EventSimulator.h"
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+
+/**
+ * Event Simulator Test
+ * --------------------
+ * Runs rack breaks and cut shots to rest with EventSimulator::RunToRest
+ * and with Physics, and checks the event-driven run ends at rest (by both
+ * AllBallsStopped), within a bounded number of events, having potted the
+ * same balls as stepping. Cut shots stop short of grazing angles (where
+ * the step size alone decides whether two balls touch), and are placed
+ * so the object ball heads for a pocket, so most of them pot.
+ */
+
+static const int BREAKS = 200;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+static const float BALL_RADIUS = 0.057f;
+
+// Clusters of touching balls cost a break up to a few thousand events;
+// on average it takes far fewer events than Physics takes steps
+static const int MAX_BREAK_EVENTS = 5000;
+
+// Cut shots: up to CUT_STEPS * CUT_ANGLE radians (about 40 degrees) either side
+static const int CUT_STEPS = 4;
+static const float CUT_ANGLE = 0.17f;
+static const float CUT_SPEED = 3.0f;
+
+// A cue ball and one object ball settle in a handful of events
+static const int MAX_CUT_EVENTS = 50;
+
+static int Failures = 0;
+
+/**
+ * Run a store to rest both ways and compare
+ * @return Events the simulator processed, or -1 after reporting a failure
+ */
+static int Compare(const char* name, const BallStore& start, int maxEvents, int& steps, int& pots)
+{
+    TableGeometry table;
+    BallStore stepped = start;
+    BallStore events = start;
+
+    Physics physics;
+    steps = physics.RunToRest(stepped, table, STEP_TIME, MAX_STEPS);
+
+    EventSimulator simulator;
+    simulator.Reset(events, table);
+    int count = simulator.RunToRest(events);
+
+    pots = 0;
+    bool samePots = true;
+    for (int i = 0; i < stepped.Size(); i++)
+    {
+        pots += !stepped.IsActive(i);
+        if (stepped.IsActive(i) != events.IsActive(i))
+            samePots = false;
+    }
+
+    if (!simulator.AllBallsStopped(events) || !physics.AllBallsStopped(events))
+    {
+        printf("FAIL %s: not at rest after %d events\n", name, count);
+        return -1;
+    }
+    if (count > maxEvents || count != simulator.GetEventCount())
+    {
+        printf("FAIL %s: %d events (limit %d, counted %d)\n", name, count, maxEvents, simulator.GetEventCount());
+        return -1;
+    }
+    if (!samePots)
+    {
+        printf("FAIL %s: potted set differs from Physics\n", name);
+        return -1;
+    }
+    return count;
+}
+
+static void CheckBreaks()
+{
+    char name[32];
+    int failed = 0;
+    long long totalEvents = 0;
+    long long totalSteps = 0;
+    int worst = 0;
+    for (int shot = 0; shot < BREAKS; shot++)
+    {
+        snprintf(name, sizeof(name), "break %d", shot);
+        float t = (float)shot / (BREAKS - 1);
+        float angle = -0.05f + 0.1f * t;
+
+        BallStore balls;
+        AddStandardRack(balls, BALL_RADIUS);
+        Physics impulse;
+        impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 6.0f + 4.0f * t);
+
+        int steps, pots;
+        int events = Compare(name, balls, MAX_BREAK_EVENTS, steps, pots);
+        if (events < 0)
+        {
+            failed++;
+            continue;
+        }
+        totalEvents += events;
+        totalSteps += steps;
+        if (events > worst)
+            worst = events;
+    }
+
+    if (totalEvents * 2 > totalSteps)
+    {
+        printf("FAIL breaks: %lld events against %lld steps\n", totalEvents, totalSteps);
+        failed++;
+    }
+
+    printf("%d breaks: %.1f events (worst %d) against %.1f steps on average, %d failures\n", BREAKS,
+           (double)totalEvents / BREAKS, worst, (double)totalSteps / BREAKS, failed);
+    Failures += failed;
+}
+
+static void CheckCuts()
+{
+    TableGeometry table;
+    const Vec3* pockets = table.GetPocketPositions();
+    Vec3 half = table.GetPlayAreaHalfExtents();
+    float margin = 2.0f * BALL_RADIUS;
+
+    char name[64];
+    int failed = 0;
+    int shots = 0;
+    int potted = 0;
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        // Approach the pocket from the table centre, and from either side of that line
+        float toCentre = sqrtf(pockets[p].x * pockets[p].x + pockets[p].z * pockets[p].z);
+        for (int approach = -1; approach <= 1; approach++)
+        {
+            float turn = 0.35f * approach;
+            float dirX = (-pockets[p].x * cosf(turn) + pockets[p].z * sinf(turn)) / toCentre;
+            float dirZ = (-pockets[p].x * sinf(turn) - pockets[p].z * cosf(turn)) / toCentre;
+            for (int distance = 0; distance < 2; distance++)
+            {
+                // Object ball on the line to the pocket, cue ball behind where it must strike
+                float objectX = pockets[p].x + dirX * (0.4f + 0.3f * distance);
+                float objectZ = pockets[p].z + dirZ * (0.4f + 0.3f * distance);
+                float ghostX = objectX + dirX * 2.0f * BALL_RADIUS;
+                float ghostZ = objectZ + dirZ * 2.0f * BALL_RADIUS;
+                for (int cut = -CUT_STEPS; cut <= CUT_STEPS; cut++)
+                {
+                    float angle = CUT_ANGLE * cut;
+                    float aimX = dirX * cosf(angle) - dirZ * sinf(angle);
+                    float aimZ = dirX * sinf(angle) + dirZ * cosf(angle);
+                    float cueX = ghostX + aimX * 0.5f;
+                    float cueZ = ghostZ + aimZ * 0.5f;
+                    if (fabsf(objectX) > half.x - margin || fabsf(objectZ) > half.z - margin ||
+                        fabsf(cueX) > half.x - margin || fabsf(cueZ) > half.z - margin)
+                        continue;
+
+                    snprintf(name, sizeof(name), "cut pocket %d approach %d distance %d cut %d", p, approach,
+                             distance, cut);
+                    BallStore balls;
+                    balls.Add(0, Vec3(cueX, BALL_RADIUS, cueZ), BALL_RADIUS);
+                    balls.Add(5, Vec3(objectX, BALL_RADIUS, objectZ), BALL_RADIUS);
+                    Physics impulse;
+                    impulse.ApplyImpulse(balls, 0, Vec3(-aimX, 0.0f, -aimZ), CUT_SPEED);
+
+                    int steps, pots;
+                    if (Compare(name, balls, MAX_CUT_EVENTS, steps, pots) < 0)
+                        failed++;
+                    shots++;
+                    potted += pots;
+                }
+            }
+        }
+    }
+
+    // The shots are aimed at pockets: most must pot, or the comparison means little
+    if (potted * 2 < shots)
+    {
+        printf("FAIL cuts: only %d of %d potted\n", potted, shots);
+        failed++;
+    }
+
+    printf("%d cut shots, %d potted, %d failures\n", shots, potted, failed);
+    Failures += failed;
+}
+
+int main()
+{
+    CheckBreaks();
+    CheckCuts();
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
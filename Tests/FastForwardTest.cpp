@@ -0,0 +1,114 @@
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+
+/**
+ * Fast Forward Test
+ * -----------------
+ * Runs the same break shots to rest with and without
+ * Physics::SetFastForward, on the rails and segment cushion backends, and
+ * checks the step counts and potted balls are identical and every ball
+ * comes to rest within END_TOLERANCE of where stepping leaves it. Also
+ * checks the fast-forward actually fires on most breaks, so the
+ * comparison covers RollingMotion::SteppedDistance and not just stepping.
+ */
+
+static const int SHOTS = 200;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+// Largest allowed end-position difference (stepping sums friction in float,
+// the fast-forward in closed form): well under a millimetre
+static const double END_TOLERANCE = 1e-4;
+
+static int Failures = 0;
+
+static void Break(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float angle = -0.6f + 0.006f * shot;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 2.0f + 0.03f * shot);
+}
+
+/**
+ * Step until a fast-forward succeeds or the balls stop
+ * @return true if a fast-forward skipped steps
+ */
+static bool FastForwards(const TableGeometry& table, int shot)
+{
+    BallStore balls;
+    Break(balls, shot);
+    Physics physics;
+    for (int step = 0; step < MAX_STEPS && !physics.AllBallsStopped(balls); step++)
+    {
+        if (physics.FastForwardToRest(balls, table, STEP_TIME, MAX_STEPS - step) > 0)
+            return physics.AllBallsStopped(balls);
+        physics.Update(balls, table, STEP_TIME);
+    }
+    return false;
+}
+
+static void CheckTable(const char* name, const TableGeometry& table)
+{
+    int failed = 0;
+    int fastForwarded = 0;
+    double worst = 0.0;
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        BallStore stepped;
+        Break(stepped, shot);
+        BallStore skipped = stepped;
+
+        Physics stepping;
+        Physics fastForward;
+        fastForward.SetFastForward(true);
+        int steps = stepping.RunToRest(stepped, table, STEP_TIME, MAX_STEPS);
+        int fastSteps = fastForward.RunToRest(skipped, table, STEP_TIME, MAX_STEPS);
+
+        bool samePots = true;
+        double distance = 0.0;
+        for (int i = 0; i < stepped.Size(); i++)
+        {
+            if (stepped.IsActive(i) != skipped.IsActive(i))
+                samePots = false;
+            else if (stepped.IsActive(i))
+                distance = std::fmax(distance, std::hypot((double)stepped.PosX[i] - skipped.PosX[i],
+                                                          (double)stepped.PosZ[i] - skipped.PosZ[i]));
+        }
+        worst = std::fmax(worst, distance);
+
+        if (steps != fastSteps || !samePots || distance > END_TOLERANCE || !fastForward.AllBallsStopped(skipped))
+        {
+            printf("FAIL %s shot %d: %d steps (stepping %d), %s potted set, end positions %.3g m apart\n", name, shot,
+                   fastSteps, steps, samePots ? "same" : "different", distance);
+            failed++;
+        }
+
+        fastForwarded += FastForwards(table, shot);
+    }
+
+    // Breaks that end with balls still in contact never fast-forward; most do
+    if (fastForwarded < SHOTS / 2)
+    {
+        printf("FAIL %s: only %d of %d breaks fast-forwarded\n", name, fastForwarded, SHOTS);
+        failed++;
+    }
+
+    printf("%-8s %d breaks, %d fast-forwarded, largest end difference %.3g m, %d failures\n", name, SHOTS,
+           fastForwarded, worst, failed);
+    Failures += failed;
+}
+
+int main()
+{
+    TableGeometry rails;
+    CheckTable("rails", rails);
+
+    TableGeometry segments;
+    segments.SetCushionBackend(CushionBackend::Segments);
+    CheckTable("segments", segments);
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "FixedPhysics.h"
+#include <cmath>
+#include <cstdio>
+
+/**
+ * Fixed Physics Test
+ * ------------------
+ * Runs break shots to rest with FixedPhysics (PoolRules, FloatPrecision)
+ * and with the dynamic Physics it specialises (continuous collision off,
+ * Rails cushions), and checks every final state hash and step count are
+ * identical. Covers the 16-ball rack and a 22-ball table, and checks a
+ * store of the wrong size is reported and left unchanged.
+ */
+
+static const int SHOTS = 60;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+
+static int Failures = 0;
+
+/**
+ * Break number `shot` of a fan from -0.6 to 0.6 rad at 2 to 8 m/s, with
+ * resting balls spread across the open table beyond the first 16
+ */
+static void Break(BallStore& balls, int numBalls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    for (int k = 16; k < numBalls; k++)
+        balls.Add(k, Vec3(-0.4f + 0.16f * (k - 16), 0.0f, 0.6f + 0.05f * (k % 2)), 0.057f);
+
+    float t = (float)shot / (SHOTS - 1);
+    float angle = -0.6f + 1.2f * t;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 2.0f + 6.0f * t);
+}
+
+template <int N>
+static void CheckBreaks()
+{
+    TableGeometry table;
+    int different = 0;
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        BallStore dynamicBalls;
+        Break(dynamicBalls, N, shot);
+        BallStore fixedBalls = dynamicBalls;
+
+        Physics dynamic;
+        dynamic.SetContinuousCollision(false);
+        int dynamicSteps = dynamic.RunToRest(dynamicBalls, table, STEP_TIME, MAX_STEPS);
+
+        FixedPhysics<N, PoolRules, FloatPrecision> fixed;
+        int fixedSteps = fixed.RunToRest(fixedBalls, table, STEP_TIME, MAX_STEPS);
+
+        if (dynamicSteps != fixedSteps || dynamicBalls.ComputeHash() != fixedBalls.ComputeHash())
+        {
+            printf("FAIL %d balls, shot %d: %d steps (hash %016llx) against Physics %d steps (hash %016llx)\n", N, shot,
+                   fixedSteps, (unsigned long long)fixedBalls.ComputeHash(), dynamicSteps,
+                   (unsigned long long)dynamicBalls.ComputeHash());
+            different++;
+        }
+    }
+    printf("%d balls: %d of %d breaks identical to Physics\n", N, SHOTS - different, SHOTS);
+    Failures += different;
+}
+
+static void CheckWrongSize()
+{
+    TableGeometry table;
+    BallStore balls;
+    Break(balls, 22, 0);
+    uint64_t before = balls.ComputeHash();
+
+    FixedPhysics<16> physics;
+    bool stepped = physics.Update(balls, table, STEP_TIME);
+    int steps = physics.RunToRest(balls, table, STEP_TIME, MAX_STEPS);
+    if (stepped || steps != -1 || balls.ComputeHash() != before)
+    {
+        printf("FAIL FixedPhysics<16> on a 22-ball store: Update %s, RunToRest %d, store %s\n",
+               stepped ? "true" : "false", steps, balls.ComputeHash() == before ? "unchanged" : "changed");
+        Failures++;
+    }
+}
+
+int main()
+{
+    CheckBreaks<16>();
+    CheckBreaks<22>();
+    CheckWrongSize();
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+/**
+ * Iteration Mode Test
+ * -------------------
+ * Steps the same shots with IterationMode::Fixed and IterationMode::Adaptive
+ * at the default cap, and checks the state hash, iteration bookkeeping and
+ * residual penetration after every step: a pass that finds no overlap
+ * changes nothing, so the two must agree exactly. Then runs the breaks to
+ * rest with a raised cap, and checks every step either converged or used
+ * the whole cap, the deepest residual overlap is no deeper than Fixed
+ * leaves, and quiet steps run a single pass.
+ */
+
+static const int SHOTS = 60;
+static const int RANDOM_STORES = 20;
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int MAX_STEPS = 100000;
+static const int RAISED_CAP = 32;
+
+// Most steps of a break have nothing to resolve
+static const double MAX_MEAN_ITERATIONS = 1.25;
+
+static int Failures = 0;
+
+static void Break(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float t = (float)shot / (SHOTS - 1);
+    float angle = -0.3f + 0.6f * t;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 4.0f + 6.0f * t);
+}
+
+/**
+ * Balls packed closely enough that the first steps are full of contacts
+ */
+static void Scatter(BallStore& balls, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(-0.4f, 0.4f);
+    std::uniform_real_distribution<float> z(-0.8f, 0.8f);
+    std::uniform_real_distribution<float> v(-4.0f, 4.0f);
+
+    int count = 8 + (int)(seed * 13 % 100);
+    for (int i = 0; i < count; i++)
+    {
+        int k = balls.Add(i, Vec3(x(rng), 0.057f, z(rng)), 0.057f);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+    }
+}
+
+/**
+ * Step Fixed and Adaptive side by side until both report rest
+ * @return false (after reporting) on the first difference
+ */
+static bool CompareSteps(const char* name, BallStore& fixedBalls)
+{
+    TableGeometry table;
+    BallStore adaptiveBalls = fixedBalls;
+    Physics fixed;
+    Physics adaptive;
+    fixed.SetIterationMode(IterationMode::Fixed);
+    adaptive.SetIterationMode(IterationMode::Adaptive);
+
+    for (int step = 0; step < MAX_STEPS; step++)
+    {
+        fixed.Update(fixedBalls, table, STEP_TIME);
+        adaptive.Update(adaptiveBalls, table, STEP_TIME);
+        if (fixedBalls.ComputeHash() != adaptiveBalls.ComputeHash())
+        {
+            printf("FAIL %s: state differs after step %d\n", name, step);
+            return false;
+        }
+
+        int iterations = adaptive.GetLastIterationCount();
+        if (fixed.GetLastIterationCount() != PhysicsConstants::COLLISION_ITERATIONS || iterations < 1 ||
+            iterations > PhysicsConstants::COLLISION_ITERATIONS ||
+            fixed.GetResidualPenetration() != adaptive.GetResidualPenetration())
+        {
+            printf("FAIL %s: step %d ran %d passes (Fixed %d), residual %g (Fixed %g)\n", name, step, iterations,
+                   fixed.GetLastIterationCount(), adaptive.GetResidualPenetration(), fixed.GetResidualPenetration());
+            return false;
+        }
+
+        if (fixed.AllBallsStopped(fixedBalls) && adaptive.AllBallsStopped(adaptiveBalls))
+            return true;
+    }
+    printf("FAIL %s: no rest after %d steps\n", name, MAX_STEPS);
+    return false;
+}
+
+/**
+ * Run a break to rest with a raised cap
+ * @return false (after reporting) if a step stopped early with overlap left
+ */
+static bool RunRaisedCap(const char* name, BallStore& balls, float& deepest, long long& steps, long long& passes)
+{
+    TableGeometry table;
+    Physics physics;
+    physics.SetMaxIterations(RAISED_CAP);
+    for (int step = 0; step < MAX_STEPS && !physics.AllBallsStopped(balls); step++)
+    {
+        physics.Update(balls, table, STEP_TIME);
+        int iterations = physics.GetLastIterationCount();
+        float residual = physics.GetResidualPenetration();
+        if (iterations < 1 || iterations > RAISED_CAP || (iterations < RAISED_CAP && residual != 0.0f))
+        {
+            printf("FAIL %s: step %d ran %d passes (cap %d) and left %g\n", name, step, iterations, RAISED_CAP,
+                   residual);
+            return false;
+        }
+        deepest = std::fmax(deepest, residual);
+        steps++;
+        passes += iterations;
+    }
+    return true;
+}
+
+int main()
+{
+    char name[32];
+    float fixedDeepest = 0.0f;
+    float raisedDeepest = 0.0f;
+    long long steps = 0;
+    long long passes = 0;
+
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        snprintf(name, sizeof(name), "break %d", shot);
+        BallStore balls;
+        Break(balls, shot);
+        Failures += !CompareSteps(name, balls);
+
+        // Fixed's deepest leftover overlap, against the raised cap's
+        BallStore fixedBalls;
+        Break(fixedBalls, shot);
+        TableGeometry table;
+        Physics fixed;
+        fixed.SetIterationMode(IterationMode::Fixed);
+        for (int step = 0; step < MAX_STEPS && !fixed.AllBallsStopped(fixedBalls); step++)
+        {
+            fixed.Update(fixedBalls, table, STEP_TIME);
+            fixedDeepest = std::fmax(fixedDeepest, fixed.GetResidualPenetration());
+        }
+
+        BallStore raisedBalls;
+        Break(raisedBalls, shot);
+        Failures += !RunRaisedCap(name, raisedBalls, raisedDeepest, steps, passes);
+    }
+
+    for (int seed = 1; seed <= RANDOM_STORES; seed++)
+    {
+        snprintf(name, sizeof(name), "random store %d", seed);
+        BallStore balls;
+        Scatter(balls, (unsigned)seed);
+        Failures += !CompareSteps(name, balls);
+    }
+
+    double meanPasses = (double)passes / steps;
+    if (raisedDeepest > fixedDeepest || meanPasses > MAX_MEAN_ITERATIONS)
+    {
+        printf("FAIL cap %d: deepest residual %g (Fixed %g), %.3f passes per step (limit %.2f)\n", RAISED_CAP,
+               raisedDeepest, fixedDeepest, meanPasses, MAX_MEAN_ITERATIONS);
+        Failures++;
+    }
+
+    printf("%d breaks and %d random stores; cap %d: %.3f passes per step, deepest residual %g (Fixed %g)\n", SHOTS,
+           RANDOM_STORES, RAISED_CAP, meanPasses, raisedDeepest, fixedDeepest);
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
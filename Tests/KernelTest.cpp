@@ -0,0 +1,200 @@
+#include "BallStore.h"
+#include "PhysicsKernels.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+/**
+ * Kernel Test
+ * -----------
+ * Runs every PhysicsKernels pass with each instruction set the CPU
+ * supports on the same randomized stores, and checks the SSE2 and AVX2
+ * results are bit-identical to Scalar.
+ *
+ * The stores cover ball counts that are not a multiple of 4 or 8, potted
+ * balls with leftover velocities, and stale padding lanes (the store is
+ * cleared and refilled with fewer balls, so lanes past the count still
+ * hold active balls).
+ */
+
+using namespace PhysicsKernels;
+
+static const int BALL_COUNTS[] = { 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 22, 31, 32, 33, 100, 257 };
+static const int SEEDS = 8;
+
+static const float DELTA_TIME = 1.0f / 240.0f;
+static const float MAX_VELOCITY = 10.0f;
+static const float MIN_VELOCITY = 0.01f;
+static const float REDUCTION = 0.5f * DELTA_TIME;
+
+static int Failures = 0;
+
+static void Fail(const char* kernel, InstructionSet set, int count, unsigned seed, const char* detail)
+{
+    printf("FAIL %s %s: %d balls, seed %u: %s\n", kernel, GetInstructionSetName(set), count, seed, detail);
+    Failures++;
+}
+
+/**
+ * Fill a store with `count` random balls over stale lanes, some potted,
+ * some asleep, with speeds from resting to past MAX_VELOCITY
+ * (built in place for every run: copying a store drops its stale lanes)
+ */
+static void MakeStore(BallStore& balls, int count, unsigned seed)
+{
+    std::mt19937 rng(seed * 7919u + (unsigned)count);
+    std::uniform_real_distribution<float> x(-0.6f, 0.6f);
+    std::uniform_real_distribution<float> z(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> v(-14.0f, 14.0f);
+
+    // Fill past the count, then clear: the block keeps the old balls as stale
+    // lanes, placed among the new balls so a kernel reading them finds overlaps
+    int stale = ((count + 7) & ~7) + 8;
+    for (int i = 0; i < stale; i++)
+    {
+        int k = balls.Add(i, Vec3(x(rng) * 0.3f, 0.057f, z(rng) * 0.3f), 0.057f);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+    }
+    balls.Clear();
+
+    for (int i = 0; i < count; i++)
+    {
+        // Tight spacing so the overlap test finds pairs
+        int k = balls.Add(i, Vec3(x(rng) * 0.3f, 0.057f, z(rng) * 0.3f), 0.04f + 0.03f * unit(rng));
+
+        float scale = unit(rng);
+        if (scale < 0.15f)
+            scale = 0.0005f;          // Below MIN_VELOCITY
+        else if (scale < 0.25f)
+            scale = 0.0f;             // Resting
+        balls.SetVelocity(k, Vec3(v(rng) * scale, 0.0f, v(rng) * scale));
+
+        if (unit(rng) < 0.2f)
+            balls.Sleep(k);
+        if (unit(rng) < 0.15f)
+        {
+            // Potted with leftover velocity: must be left untouched
+            balls.SetActive(k, false);
+            balls.VelX[k] = v(rng);
+            balls.VelZ[k] = v(rng);
+        }
+    }
+}
+
+static bool SameBits(const float* a, const float* b, int count)
+{
+    return std::memcmp(a, b, (size_t)count * sizeof(float)) == 0;
+}
+
+/**
+ * Compare the per-ball arrays a kernel may write
+ */
+static void CheckStore(const char* kernel, InstructionSet set, int count, unsigned seed,
+                       const BallStore& result, const BallStore& expected)
+{
+    if (!SameBits(result.PosX, expected.PosX, count) || !SameBits(result.PosZ, expected.PosZ, count))
+        Fail(kernel, set, count, seed, "positions differ from Scalar");
+    if (!SameBits(result.VelX, expected.VelX, count) || !SameBits(result.VelZ, expected.VelZ, count))
+        Fail(kernel, set, count, seed, "velocities differ from Scalar");
+}
+
+/**
+ * Run one per-ball pass on a freshly built store
+ */
+static void RunPass(BallStore& balls, int pass, InstructionSet set, int count, unsigned seed)
+{
+    MakeStore(balls, count, seed);
+    float frictionFactor = powf(0.2f, DELTA_TIME);
+
+    switch (pass)
+    {
+    case 0:
+        ApplyFriction(set, balls.VelX, balls.VelZ, balls.Active, count, frictionFactor, REDUCTION);
+        break;
+    case 1:
+        IntegratePositions(set, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ, balls.Active, count, DELTA_TIME);
+        break;
+    case 2:
+        ClampVelocities(set, balls.VelX, balls.VelZ, balls.Active, count, MAX_VELOCITY);
+        break;
+    case 3:
+        StopSlowBalls(set, balls.VelX, balls.VelZ, balls.Active, count, MIN_VELOCITY);
+        break;
+    default:
+        FusedStep(set, balls.PosX, balls.PosZ, balls.VelX, balls.VelZ, balls.Active, count,
+                  MAX_VELOCITY, MIN_VELOCITY, frictionFactor, REDUCTION, DELTA_TIME);
+        break;
+    }
+}
+
+static const char* PASS_NAMES[] = { "ApplyFriction", "IntegratePositions", "ClampVelocities", "StopSlowBalls", "FusedStep" };
+
+int main()
+{
+    InstructionSet widest = DetectInstructionSet();
+    printf("CPU supports up to %s\n", GetInstructionSetName(widest));
+
+    const InstructionSet simdSets[] = { InstructionSet::SSE2, InstructionSet::AVX2 };
+    int checked = 0;
+
+    for (InstructionSet set : simdSets)
+    {
+        if ((int)set > (int)widest)
+        {
+            printf("SKIP %s: not supported on this CPU\n", GetInstructionSetName(set));
+            continue;
+        }
+
+        for (int count : BALL_COUNTS)
+        {
+            for (unsigned seed = 1; seed <= (unsigned)SEEDS; seed++)
+            {
+                for (int pass = 0; pass < 5; pass++)
+                {
+                    BallStore expected;
+                    BallStore result;
+                    RunPass(expected, pass, InstructionSet::Scalar, count, seed);
+                    RunPass(result, pass, set, count, seed);
+                    CheckStore(PASS_NAMES[pass], set, count, seed, result, expected);
+                    checked++;
+                }
+
+                if (count > MAX_OVERLAP_BALLS)
+                    continue;
+
+                // Every ball awake, then the store's own awake list
+                for (int list = 0; list < 2; list++)
+                {
+                    BallStore balls;
+                    MakeStore(balls, count, seed);
+                    int allBalls[MAX_OVERLAP_BALLS];
+                    for (int i = 0; i < count; i++)
+                    {
+                        if (list == 0)
+                            balls.Wake(i);
+                        allBalls[i] = i;
+                    }
+                    const int* awakeBalls = list == 0 ? allBalls : balls.GetAwakeBalls();
+                    int numAwake = list == 0 ? count : balls.GetAwakeCount();
+
+                    uint32_t expected[MAX_OVERLAP_BALLS] = {};
+                    uint32_t result[MAX_OVERLAP_BALLS] = {};
+                    int expectedTests = FindOverlaps(InstructionSet::Scalar, balls.PosX, balls.PosZ, balls.Radius,
+                                                     balls.Active, balls.Awake, count, awakeBalls, numAwake, expected);
+                    int resultTests = FindOverlaps(set, balls.PosX, balls.PosZ, balls.Radius,
+                                                   balls.Active, balls.Awake, count, awakeBalls, numAwake, result);
+                    if (resultTests != expectedTests)
+                        Fail("FindOverlaps", set, count, seed, "pair test count differs from Scalar");
+                    if (std::memcmp(result, expected, (size_t)numAwake * sizeof(uint32_t)) != 0)
+                        Fail("FindOverlaps", set, count, seed, "overlap rows differ from Scalar");
+                    checked++;
+                }
+            }
+        }
+    }
+
+    printf("%d kernel comparisons, %d failures\n", checked, Failures);
+    return Failures == 0 ? 0 : 1;
+}
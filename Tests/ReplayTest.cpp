@@ -0,0 +1,283 @@
+#include "Physics.h"
+#include "Replay.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/**
+ * Replay Test
+ * -----------
+ * Records break shots (each with a loose ball rolled into a side pocket)
+ * with ReplayRecorder and plays them back with ReplayReader, in order and
+ * in random order, checking every frame holds the quantized positions and
+ * active flags of the live step it recorded.
+ * Keyframe intervals of 1, 7 and the default cover keyframes, delta frames
+ * (including pots, which toggle the active flag through the low bit of the
+ * X delta) and seeking back through the index. Also checks a rack stays
+ * under MAX_FILE_BYTES, and that truncated files and index entries
+ * pointing outside the frames are rejected.
+ */
+
+static const int SHOTS = 20;
+static const float STEP_TIME = 1.0f / 240.0f;
+static const int MAX_STEPS = 100000;
+static const int RANDOM_READS = 2000;
+static const int INTERVALS[] = { ReplayFormat::DEFAULT_KEYFRAME_INTERVAL, 7, 1 };
+
+// A rack recorded at the default interval: a few tens of KB
+static const long long MAX_FILE_BYTES = 64 * 1024;
+
+static const char* REPLAY_PATH = "ReplayTest.brpl";
+static const char* DAMAGED_PATH = "ReplayTestDamaged.brpl";
+
+static int Failures = 0;
+
+/**
+ * Quantized state of one recorded step
+ */
+struct Frame
+{
+    std::vector<int32_t> X;
+    std::vector<int32_t> Z;
+    std::vector<uint8_t> Active;
+};
+
+static int32_t Quantize(float position)
+{
+    return (int32_t)std::lrintf(position * ReplayFormat::POSITION_SCALE);
+}
+
+/**
+ * A break, plus a loose ball rolled into a side pocket (breaks rarely pot)
+ */
+static void Break(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float side = shot % 2 == 0 ? -1.0f : 1.0f;
+    int loose = balls.Add(16, Vec3(0.8f * side, 0.057f, 0.3f + 0.02f * shot), 0.057f);
+
+    TableGeometry table;
+    const Vec3& pocket = table.GetPocketPositions()[side < 0.0f ? 4 : 5];
+    float angle = -0.6f + 0.06f * shot;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 4.0f + 0.2f * shot);
+    impulse.ApplyImpulse(balls, loose, Vec3(pocket.x - balls.PosX[loose], 0.0f, pocket.z - balls.PosZ[loose]), 3.0f);
+}
+
+/**
+ * Record a break run to rest, keeping the quantized state of every frame
+ * @return Bytes in the closed file (0 if recording failed)
+ */
+static long long Record(int shot, int interval, BallStore& balls, std::vector<Frame>& frames)
+{
+    Break(balls, shot);
+    ReplayRecorder recorder;
+    if (!recorder.Open(REPLAY_PATH, balls, STEP_TIME, interval))
+        return 0;
+
+    TableGeometry table;
+    Physics physics;
+    frames.clear();
+    for (int step = 0; step < MAX_STEPS; step++)
+    {
+        Frame frame;
+        for (int i = 0; i < balls.Size(); i++)
+        {
+            frame.X.push_back(Quantize(balls.PosX[i]));
+            frame.Z.push_back(Quantize(balls.PosZ[i]));
+            frame.Active.push_back(balls.IsActive(i) ? 1 : 0);
+        }
+        frames.push_back(frame);
+        recorder.RecordFrame(balls);
+
+        if (physics.AllBallsStopped(balls))
+            break;
+        physics.Update(balls, table, STEP_TIME);
+    }
+
+    if (recorder.GetFrameCount() != (int)frames.size() || !recorder.Close())
+        return 0;
+    return (long long)recorder.GetBytesWritten();
+}
+
+/**
+ * Read one frame and compare it with the recorded state
+ */
+static bool CheckFrame(ReplayReader& reader, int frame, const BallStore& live, const Frame& expected, BallStore& read)
+{
+    if (!reader.ReadFrame(frame, read) || read.Size() != live.Size())
+        return false;
+
+    for (int i = 0; i < read.Size(); i++)
+    {
+        if (read.Number[i] != live.Number[i] || read.Radius[i] != live.Radius[i] ||
+            Quantize(read.PosX[i]) != expected.X[i] || Quantize(read.PosZ[i]) != expected.Z[i] ||
+            read.IsActive(i) != (expected.Active[i] != 0))
+            return false;
+    }
+    return true;
+}
+
+static std::vector<char> ReadBytes(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteBytes(const char* path, const std::vector<char>& bytes, size_t count)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), (std::streamsize)count);
+}
+
+/**
+ * Truncated copies must fail to open, and an index entry pointing outside
+ * the frames must fail to read without breaking the other keyframes
+ */
+static int CheckDamaged(const char* name, const std::vector<char>& bytes, int keyframeInterval, int frameCount)
+{
+    int failed = 0;
+
+    size_t cuts[] = { 0, (size_t)ReplayFormat::HEADER_BYTES - 1, (size_t)ReplayFormat::HEADER_BYTES,
+                      bytes.size() / 2, bytes.size() - 8, bytes.size() - 1 };
+    for (size_t cut : cuts)
+    {
+        WriteBytes(DAMAGED_PATH, bytes, cut);
+        ReplayReader reader;
+        if (reader.Open(DAMAGED_PATH))
+        {
+            printf("FAIL %s: file cut to %zu of %zu bytes opened\n", name, cut, bytes.size());
+            failed++;
+        }
+    }
+
+    if (frameCount <= keyframeInterval)
+        return failed;
+
+    // Point keyframe 1 at the index itself (the end of the frame data), then
+    // at an offset that wraps when the keyframe mask is added to it
+    uint64_t indexOffset = 0;
+    for (int i = 0; i < 8; i++)
+        indexOffset |= (uint64_t)(unsigned char)bytes[32 + i] << (8 * i);
+    uint64_t badOffsets[] = { indexOffset, ~(uint64_t)0 };
+    for (uint64_t bad : badOffsets)
+    {
+        std::vector<char> damaged = bytes;
+        for (int i = 0; i < 8; i++)
+            damaged[(size_t)indexOffset + 8 + i] = (char)(bad >> (8 * i));
+        WriteBytes(DAMAGED_PATH, damaged, damaged.size());
+
+        ReplayReader reader;
+        BallStore read;
+        if (!reader.Open(DAMAGED_PATH) || reader.ReadFrame(keyframeInterval, read) || !reader.ReadFrame(0, read) ||
+            (keyframeInterval > 1 && reader.ReadFrame(keyframeInterval + 1, read)))
+        {
+            printf("FAIL %s: index entry %llx for keyframe 1 not rejected\n", name, (unsigned long long)bad);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+static void CheckShot(int shot, int interval, int& deltaPots, long long& largestDefault)
+{
+    char name[48];
+    snprintf(name, sizeof(name), "shot %d interval %d", shot, interval);
+
+    BallStore live;
+    std::vector<Frame> frames;
+    long long bytes = Record(shot, interval, live, frames);
+    if (bytes == 0)
+    {
+        printf("FAIL %s: recording failed\n", name);
+        Failures++;
+        return;
+    }
+
+    // Pots between keyframes go through the toggle bit
+    for (size_t f = 1; f < frames.size(); f++)
+        if (f % interval != 0 && frames[f].Active != frames[f - 1].Active)
+            deltaPots++;
+
+    std::vector<char> file = ReadBytes(REPLAY_PATH);
+    if ((long long)file.size() != bytes)
+    {
+        printf("FAIL %s: %zu bytes on disk, recorder wrote %lld\n", name, file.size(), bytes);
+        Failures++;
+    }
+    if (interval == ReplayFormat::DEFAULT_KEYFRAME_INTERVAL && bytes > largestDefault)
+        largestDefault = bytes;
+
+    ReplayReader reader;
+    if (!reader.Open(REPLAY_PATH) || reader.GetFrameCount() != (int)frames.size() ||
+        reader.GetBallCount() != live.Size() || reader.GetStepTime() != STEP_TIME)
+    {
+        printf("FAIL %s: header does not match the recording\n", name);
+        Failures++;
+        return;
+    }
+
+    BallStore read;
+    int frameCount = (int)frames.size();
+    for (int f = 0; f < frameCount; f++)
+    {
+        if (!CheckFrame(reader, f, live, frames[f], read))
+        {
+            printf("FAIL %s: frame %d read in order differs\n", name, f);
+            Failures++;
+            return;
+        }
+    }
+
+    std::mt19937 rng((unsigned)(shot * 31 + interval));
+    std::uniform_int_distribution<int> pick(0, frameCount - 1);
+    for (int r = 0; r < RANDOM_READS; r++)
+    {
+        int f = pick(rng);
+        if (!CheckFrame(reader, f, live, frames[f], read))
+        {
+            printf("FAIL %s: frame %d differs on random read %d\n", name, f, r);
+            Failures++;
+            return;
+        }
+    }
+
+    if (reader.ReadFrame(-1, read) || reader.ReadFrame(frameCount, read))
+    {
+        printf("FAIL %s: out of range frame read\n", name);
+        Failures++;
+    }
+    reader.Close();
+
+    Failures += CheckDamaged(name, file, interval, frameCount);
+}
+
+int main()
+{
+    int deltaPots = 0;
+    long long largestDefault = 0;
+    for (int shot = 0; shot < SHOTS; shot++)
+        for (int interval : INTERVALS)
+            CheckShot(shot, interval, deltaPots, largestDefault);
+
+    if (deltaPots == 0)
+    {
+        printf("FAIL no pot fell between keyframes; the toggle bit went untested\n");
+        Failures++;
+    }
+    if (largestDefault > MAX_FILE_BYTES)
+    {
+        printf("FAIL largest rack %lld bytes (limit %lld)\n", largestDefault, MAX_FILE_BYTES);
+        Failures++;
+    }
+
+    std::remove(REPLAY_PATH);
+    std::remove(DAMAGED_PATH);
+
+    printf("%d breaks, %d pots between keyframes, largest rack %lld bytes, %d failures\n", SHOTS, deltaPots,
+           largestDefault, Failures);
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+#include "Physics.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+/**
+ * Step Mode Test
+ * --------------
+ * Runs the same shots with StepMode::MultiPass and StepMode::Fused, with
+ * the scalar kernels and with the widest set the CPU supports, and checks
+ * positions are bit-identical after every step, the same step reports
+ * rest, and break shots run to rest end in the same state after the same
+ * number of steps.
+ */
+
+static const int SHOTS = 60;
+static const int RANDOM_STORES = 40;
+static const float STEP_TIME = 1.0f / 120.0f;
+static const int MAX_STEPS = 100000;
+
+static int Failures = 0;
+
+static void Break(BallStore& balls, int shot)
+{
+    AddStandardRack(balls, 0.057f);
+    float t = (float)shot / (SHOTS - 1);
+    float angle = -0.6f + 1.2f * t;
+    Physics impulse;
+    impulse.ApplyImpulse(balls, 0, Vec3(sinf(angle), 0.0f, -cosf(angle)), 2.0f + 6.0f * t);
+}
+
+/**
+ * Loose balls of random velocity, some potted, not a multiple of the vector width
+ */
+static void Scatter(BallStore& balls, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> z(-2.4f, 2.4f);
+    std::uniform_real_distribution<float> v(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    int count = 1 + (int)(seed * 7 % 200);
+    for (int i = 0; i < count; i++)
+    {
+        int k = balls.Add(i, Vec3(x(rng), 0.057f, z(rng)), 0.057f);
+        balls.SetVelocity(k, Vec3(v(rng), 0.0f, v(rng)));
+        if (unit(rng) < 0.1f)
+            balls.SetActive(k, false);
+    }
+}
+
+/**
+ * Step both modes side by side until both report rest
+ * @return false (after reporting) on the first difference
+ */
+static bool CompareSteps(const char* name, PhysicsKernels::InstructionSet set, BallStore& multiBalls)
+{
+    TableGeometry table;
+    BallStore fusedBalls = multiBalls;
+    Physics multi;
+    Physics fused;
+    multi.SetInstructionSet(set);
+    fused.SetInstructionSet(set);
+    fused.SetStepMode(StepMode::Fused);
+
+    size_t bytes = (size_t)multiBalls.Size() * sizeof(float);
+    for (int step = 0; step < MAX_STEPS; step++)
+    {
+        multi.Update(multiBalls, table, STEP_TIME);
+        fused.Update(fusedBalls, table, STEP_TIME);
+        if (std::memcmp(multiBalls.PosX, fusedBalls.PosX, bytes) != 0 ||
+            std::memcmp(multiBalls.PosZ, fusedBalls.PosZ, bytes) != 0)
+        {
+            printf("FAIL %s %s: positions differ after step %d\n", PhysicsKernels::GetInstructionSetName(set), name, step);
+            return false;
+        }
+
+        bool multiRest = multi.AllBallsStopped(multiBalls);
+        bool fusedRest = fused.AllBallsStopped(fusedBalls);
+        if (multiRest != fusedRest)
+        {
+            printf("FAIL %s %s: step %d is rest for %s only\n", PhysicsKernels::GetInstructionSetName(set), name, step,
+                   multiRest ? "MultiPass" : "Fused");
+            return false;
+        }
+        if (multiRest)
+            return true;
+    }
+    printf("FAIL %s %s: no rest after %d steps\n", PhysicsKernels::GetInstructionSetName(set), name, MAX_STEPS);
+    return false;
+}
+
+static void CheckSet(PhysicsKernels::InstructionSet set)
+{
+    TableGeometry table;
+    char name[32];
+    int failed = 0;
+
+    for (int shot = 0; shot < SHOTS; shot++)
+    {
+        snprintf(name, sizeof(name), "break %d", shot);
+        BallStore balls;
+        Break(balls, shot);
+        failed += !CompareSteps(name, set, balls);
+
+        // RunToRest counts the same steps and ends in the same state
+        BallStore multiBalls;
+        Break(multiBalls, shot);
+        BallStore fusedBalls = multiBalls;
+        Physics multi;
+        Physics fused;
+        multi.SetInstructionSet(set);
+        fused.SetInstructionSet(set);
+        fused.SetStepMode(StepMode::Fused);
+        int multiSteps = multi.RunToRest(multiBalls, table, STEP_TIME, MAX_STEPS);
+        int fusedSteps = fused.RunToRest(fusedBalls, table, STEP_TIME, MAX_STEPS);
+        if (multiSteps != fusedSteps || multiBalls.ComputeHash() != fusedBalls.ComputeHash())
+        {
+            printf("FAIL %s %s: RunToRest %d steps (hash %016llx) against MultiPass %d (hash %016llx)\n",
+                   PhysicsKernels::GetInstructionSetName(set), name, fusedSteps,
+                   (unsigned long long)fusedBalls.ComputeHash(), multiSteps,
+                   (unsigned long long)multiBalls.ComputeHash());
+            failed++;
+        }
+    }
+
+    for (int seed = 1; seed <= RANDOM_STORES; seed++)
+    {
+        snprintf(name, sizeof(name), "random store %d", seed);
+        BallStore balls;
+        Scatter(balls, (unsigned)seed);
+        failed += !CompareSteps(name, set, balls);
+    }
+
+    printf("%s: %d breaks and %d random stores, %d failures\n", PhysicsKernels::GetInstructionSetName(set), SHOTS,
+           RANDOM_STORES, failed);
+    Failures += failed;
+}
+
+int main()
+{
+    PhysicsKernels::InstructionSet widest = PhysicsKernels::DetectInstructionSet();
+    CheckSet(PhysicsKernels::InstructionSet::Scalar);
+    if (widest != PhysicsKernels::InstructionSet::Scalar)
+        CheckSet(widest);
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}
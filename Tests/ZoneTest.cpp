@@ -0,0 +1,141 @@
+#include "TableGeometry.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+/**
+ * Zone Test
+ * ---------
+ * Checks the zone grid answers IsInPocketGap and FindPocket exactly like
+ * the six-pocket loops Physics used before it (and still relies on): on
+ * random points over and around several tables, and on points a few ulps
+ * either side of every pocket and gap circle.
+ */
+
+static const int RANDOM_POINTS = 2000000;
+static const int EDGE_ANGLES = 4096;
+static const int EDGE_ULPS = 3;
+
+static int Failures = 0;
+static int Reported = 0;
+
+/**
+ * Reference: the gap test against every pocket
+ */
+static bool LoopInPocketGap(const TableGeometry& table, float x, float z)
+{
+    float gapThreshold = table.GetPocketGapRadius();
+    for (int i = 0; i < TableGeometry::NUM_POCKETS; i++)
+    {
+        float dx = x - table.PocketPositions[i].x;
+        float dz = z - table.PocketPositions[i].z;
+        if (dx * dx + dz * dz < gapThreshold * gapThreshold)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Reference: the first pocket whose circle contains the point
+ */
+static int LoopFindPocket(const TableGeometry& table, float x, float z)
+{
+    float prSq = table.PocketRadius * table.PocketRadius;
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        float dx = x - table.PocketPositions[p].x;
+        float dz = z - table.PocketPositions[p].z;
+        if (dx * dx + dz * dz < prSq)
+            return p;
+    }
+    return -1;
+}
+
+/**
+ * @return 1 if the grid and the loops disagree on a point
+ */
+static int CheckPoint(const TableGeometry& table, float x, float z)
+{
+    bool gap = LoopInPocketGap(table, x, z);
+    int pocket = LoopFindPocket(table, x, z);
+    if (table.IsInPocketGap(x, z) == gap && table.IsInPocketGap(x, z, table.GetZone(x, z)) == gap &&
+        table.FindPocket(x, z) == pocket)
+        return 0;
+
+    // Report the first few only
+    if (Reported++ < 10)
+    {
+        printf("FAIL (%.9g, %.9g): gap %d (loop %d), pocket %d (loop %d)\n", x, z, (int)table.IsInPocketGap(x, z),
+               (int)gap, table.FindPocket(x, z), pocket);
+    }
+    return 1;
+}
+
+static void CheckTable(const char* name, const TableGeometry& table, unsigned seed)
+{
+    // Random points over the grid and well beyond it
+    const float margin = 1.0f;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(table.GetMinX() - margin, table.GetMaxX() + margin);
+    std::uniform_real_distribution<float> z(table.GetMinZ() - margin, table.GetMaxZ() + margin);
+
+    int randomFailures = 0;
+    for (int n = 0; n < RANDOM_POINTS; n++)
+        randomFailures += CheckPoint(table, x(rng), z(rng));
+
+    // Points on, and a few ulps inside and outside, every pocket and gap circle
+    int edgeFailures = 0;
+    int edgePoints = 0;
+    const float radii[] = { table.PocketRadius, table.GetPocketGapRadius() };
+    for (int p = 0; p < TableGeometry::NUM_POCKETS; p++)
+    {
+        const Vec3& center = table.PocketPositions[p];
+        for (float radius : radii)
+        {
+            for (int a = 0; a < EDGE_ANGLES; a++)
+            {
+                double angle = 2.0 * 3.14159265358979323846 * a / EDGE_ANGLES;
+                float ex = center.x + (float)(radius * cos(angle));
+                float ez = center.z + (float)(radius * sin(angle));
+                for (int ux = -EDGE_ULPS; ux <= EDGE_ULPS; ux++)
+                {
+                    for (int uz = -EDGE_ULPS; uz <= EDGE_ULPS; uz++)
+                    {
+                        float px = ex;
+                        float pz = ez;
+                        for (int u = 0; u < std::abs(ux); u++)
+                            px = nextafterf(px, ux < 0 ? -1e9f : 1e9f);
+                        for (int u = 0; u < std::abs(uz); u++)
+                            pz = nextafterf(pz, uz < 0 ? -1e9f : 1e9f);
+                        edgeFailures += CheckPoint(table, px, pz);
+                        edgePoints++;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%-20s %d random points, %d mismatches; %d edge points, %d mismatches\n", name, RANDOM_POINTS,
+           randomFailures, edgePoints, edgeFailures);
+    Failures += randomFailures + edgeFailures;
+}
+
+int main()
+{
+    TableGeometry standard;
+    CheckTable("standard", standard, 1);
+
+    TableGeometry small(1.2f, 2.4f, 0.08f, 0.1f);
+    CheckTable("small", small, 2);
+
+    TableGeometry large(7.3f, 14.6f, 0.08f, 0.15f);
+    CheckTable("large", large, 3);
+
+    // The segment backend rebakes the grid (the rail band follows the segments)
+    TableGeometry segments;
+    segments.SetCushionBackend(CushionBackend::Segments);
+    CheckTable("segments", segments, 4);
+
+    printf("%d failures\n", Failures);
+    return Failures == 0 ? 0 : 1;
+}